@@ -0,0 +1,320 @@
+#include "Asynchroniczne.hpp"
+#include "Gemm.hpp"
+#include "Rownolegle.hpp"
+#include <algorithm> // dla funkcji copy_n i min()
+using namespace std;
+
+/**
+ * @brief Tworzy zakończone zadanie z gotowej macierzy.
+ *
+ * @param m Macierz wynikowa (współdzielona, bez kopiowania elementów).
+ */
+Zadanie::Zadanie(const Matrix& m) : wezel(make_shared<Wezel>()) {
+    wezel->wynik = wezel->obietnica.get_future().share();
+    wezel->obietnica.set_value(m);
+    wezel->zakonczony = true;
+}
+
+/**
+ * @brief Sprawdza, czy wynik zadania jest dostępny.
+ *
+ * @return true, jeśli zadanie się zakończyło.
+ */
+bool Zadanie::gotowe(void) const {
+    return wezel->wynik.wait_for(chrono::seconds(0)) == future_status::ready;
+}
+
+/**
+ * @brief Czeka na wynik zadania.
+ *
+ * @return Referencja do macierzy wynikowej.
+ */
+const Matrix& Zadanie::wynik(void) const {
+    return wezel->wynik.get();
+}
+
+/**
+ * @brief Zwraca przyszłość powiązaną z wynikiem zadania.
+ *
+ * @return Współdzielona przyszłość.
+ */
+shared_future<Matrix> Zadanie::przyszlosc(void) const {
+    return wezel->wynik;
+}
+
+/**
+ * @brief Uruchamia wątki robocze.
+ *
+ * @param n Liczba wątków, 0 oznacza liczba_watkow().
+ */
+Harmonogram::Harmonogram(int n) {
+    if (n <= 0) {
+        n = liczba_watkow();
+    }
+    for (int i = 0; i < n; ++i) {
+        watki.emplace_back([this] { petla(); });
+    }
+}
+
+/**
+ * @brief Czeka na wykonanie zadań z kolejki i zatrzymuje wątki robocze.
+ */
+Harmonogram::~Harmonogram(void) {
+    {
+        lock_guard<mutex> l(blokada);
+        koniec = true;
+    }
+    sygnal.notify_all();
+    for (thread& w : watki) {
+        w.join();
+    }
+}
+
+/**
+ * @brief Zwraca harmonogram współdzielony przez funkcje async_*.
+ *
+ * @return Referencja do harmonogramu tworzonego przy pierwszym użyciu.
+ */
+Harmonogram& Harmonogram::domyslny(void) {
+    static Harmonogram h;
+    return h;
+}
+
+/**
+ * @brief Dodaje węzeł grafu, który zostanie wykonany po zakończeniu zależności.
+ *
+ * Licznik oczekujących poprzedników jest na czas rejestracji zwiększony o jeden,
+ * aby węzeł nie trafił do kolejki, zanim zostanie dopisany do wszystkich poprzedników.
+ *
+ * @param zaleznosci Poprzednicy w grafie.
+ * @param praca Obliczenie wykonywane po zakończeniu poprzedników.
+ * @return Uchwyt do wyniku.
+ */
+Zadanie Harmonogram::zaplanuj(const vector<Zadanie>& zaleznosci, function<Matrix(void)> praca) {
+    auto w = make_shared<Zadanie::Wezel>();
+    w->praca = move(praca);
+    w->wynik = w->obietnica.get_future().share();
+    w->oczekujace.store(static_cast<int>(zaleznosci.size()) + 1, memory_order_relaxed);
+
+    for (const Zadanie& z : zaleznosci) {
+        lock_guard<mutex> l(z.wezel->blokada);
+        if (z.wezel->zakonczony) {
+            w->oczekujace.fetch_sub(1, memory_order_acq_rel);
+        } else {
+            z.wezel->nastepniki.push_back(w);
+        }
+    }
+
+    if (w->oczekujace.fetch_sub(1, memory_order_acq_rel) == 1) {
+        wstaw_do_kolejki(w);
+    }
+    return Zadanie(w);
+}
+
+/**
+ * @brief Umieszcza gotowy węzeł w kolejce i budzi jeden wątek.
+ *
+ * @param w Węzeł, którego poprzednicy się zakończyli.
+ */
+void Harmonogram::wstaw_do_kolejki(shared_ptr<Zadanie::Wezel> w) {
+    {
+        lock_guard<mutex> l(blokada);
+        kolejka.push_back(move(w));
+    }
+    sygnal.notify_one();
+}
+
+/**
+ * @brief Wykonuje węzeł, ustawia jego wynik i zwalnia następników.
+ *
+ * @param w Wykonywany węzeł.
+ */
+void Harmonogram::wykonaj(shared_ptr<Zadanie::Wezel> w) {
+    try {
+        w->obietnica.set_value(w->praca());
+    } catch (...) {
+        w->obietnica.set_exception(current_exception());
+    }
+    w->praca = nullptr;
+
+    vector<shared_ptr<Zadanie::Wezel>> gotowi;
+    {
+        lock_guard<mutex> l(w->blokada);
+        w->zakonczony = true;
+        gotowi.swap(w->nastepniki);
+    }
+    for (shared_ptr<Zadanie::Wezel>& n : gotowi) {
+        if (n->oczekujace.fetch_sub(1, memory_order_acq_rel) == 1) {
+            wstaw_do_kolejki(move(n));
+        }
+    }
+}
+
+/**
+ * @brief Pętla wątku roboczego: pobiera i wykonuje zadania aż do zamknięcia puli.
+ */
+void Harmonogram::petla(void) {
+    for (;;) {
+        shared_ptr<Zadanie::Wezel> w;
+        {
+            unique_lock<mutex> l(blokada);
+            sygnal.wait(l, [this] { return koniec || !kolejka.empty(); });
+            if (kolejka.empty()) {
+                return;
+            }
+            w = move(kolejka.front());
+            kolejka.pop_front();
+        }
+        wykonaj(move(w));
+    }
+}
+
+/**
+ * @brief Planuje mnożenie a * b.
+ *
+ * @param a Lewy czynnik.
+ * @param b Prawy czynnik.
+ * @return Zadanie z iloczynem.
+ */
+Zadanie async_mul(const Zadanie& a, const Zadanie& b) {
+    return Harmonogram::domyslny().zaplanuj({a, b}, [a, b] {
+        Matrix w(a.wynik());
+        Matrix m(b.wynik());
+        w * m;
+        return w;
+    });
+}
+
+/**
+ * @brief Planuje dodawanie a + b.
+ *
+ * @param a Pierwszy składnik.
+ * @param b Drugi składnik.
+ * @return Zadanie z sumą.
+ */
+Zadanie async_add(const Zadanie& a, const Zadanie& b) {
+    return Harmonogram::domyslny().zaplanuj({a, b}, [a, b] {
+        Matrix w(a.wynik());
+        Matrix m(b.wynik());
+        w + m;
+        return w;
+    });
+}
+
+/**
+ * @brief Planuje odejmowanie a - b.
+ *
+ * @param a Odjemna.
+ * @param b Odjemnik.
+ * @return Zadanie z różnicą.
+ */
+Zadanie async_sub(const Zadanie& a, const Zadanie& b) {
+    return Harmonogram::domyslny().zaplanuj({a, b}, [a, b] {
+        Matrix w(a.wynik());
+        Matrix m(b.wynik());
+        w - m;
+        return w;
+    });
+}
+
+/**
+ * @brief Planuje transpozycję macierzy.
+ *
+ * @param a Macierz transponowana.
+ * @return Zadanie z transpozycją.
+ */
+Zadanie async_transpose(const Zadanie& a) {
+    return Harmonogram::domyslny().zaplanuj({a}, [a] {
+        Matrix w(a.wynik());
+        w.dowroc();
+        return w;
+    });
+}
+
+/**
+ * @brief Planuje mnożenie macierzy przez skalar.
+ *
+ * @param a Macierz.
+ * @param s Skalar.
+ * @return Zadanie z wynikiem.
+ */
+Zadanie async_scale(const Zadanie& a, int s) {
+    return Harmonogram::domyslny().zaplanuj({a}, [a, s] {
+        Matrix w(a.wynik());
+        w * s;
+        return w;
+    });
+}
+
+/**
+ * @brief Planuje potokowe mnożenie łańcucha macierzy.
+ *
+ * Zadanie planujące czeka na wszystkie czynniki, a następnie planuje po jednym zadaniu
+ * na blok wierszy. Blok przechodzi przez kolejne mnożenia w buforach o rozmiarze
+ * wiersze_w_bloku x n i trafia do wspólnego bufora wyniku.
+ *
+ * Zadanie końcowe trafia do kolejki po zadaniu planującym, a więc za wszystkimi
+ * blokami. Gdy je pobiera, bloki są już w trakcie wykonania, więc oczekiwanie
+ * na nie nie może zablokować puli.
+ *
+ * @param czynniki Kolejne czynniki iloczynu.
+ * @param wiersze_w_bloku Liczba wierszy w jednym zadaniu.
+ * @return Zadanie z iloczynem łańcucha.
+ */
+Zadanie async_chain_mul(const vector<Zadanie>& czynniki, int wiersze_w_bloku) {
+    Harmonogram& h = Harmonogram::domyslny();
+    if (czynniki.empty()) {
+        cerr << "Łańcuch mnożeń nie zawiera żadnej macierzy." << endl;
+        return Zadanie(Matrix());
+    }
+    if (wiersze_w_bloku <= 0) {
+        wiersze_w_bloku = 64;
+    }
+
+    auto bufor = make_shared<vector<int>>();
+    auto bloki = make_shared<vector<Zadanie>>();
+
+    // Liczba bloków zależy od rozmiaru czynników, więc planuje je osobne zadanie
+    Zadanie planowanie = h.zaplanuj(czynniki, [&h, czynniki, wiersze_w_bloku, bufor, bloki] {
+        int n = czynniki[0].wynik().rozmiar();
+        for (const Zadanie& z : czynniki) {
+            if (z.wynik().rozmiar() != n) {
+                cerr << "Macierze mają różne rozmiary, nie można ich pomnożyć." << endl;
+                return Matrix();
+            }
+        }
+
+        bufor->assign(static_cast<long>(n) * n, 0);
+        for (int y0 = 0; y0 < n; y0 += wiersze_w_bloku) {
+            int y1 = min(y0 + wiersze_w_bloku, n);
+            bloki->push_back(h.zaplanuj({}, [czynniki, bufor, n, y0, y1] {
+                long b = y1 - y0;
+                const int* a0 = czynniki[0].wynik().dane();
+                vector<int> biezacy(a0 + y0 * static_cast<long>(n), a0 + y1 * static_cast<long>(n));
+                vector<int> nastepny(b * n);
+
+                for (size_t c = 1; c < czynniki.size(); ++c) {
+                    fill(nastepny.begin(), nastepny.end(), 0);
+                    gemm(static_cast<int>(b), n, n, 1, biezacy.data(), n, czynniki[c].wynik().dane(), n,
+                         nastepny.data(), n);
+                    biezacy.swap(nastepny);
+                }
+
+                // Bloki zapisują rozłączne wiersze wspólnego bufora
+                copy(biezacy.begin(), biezacy.end(), bufor->begin() + y0 * static_cast<long>(n));
+                return Matrix();
+            }));
+        }
+        return Matrix();
+    });
+
+    return h.zaplanuj({planowanie}, [czynniki, bufor, bloki] {
+        for (const Zadanie& b : *bloki) {
+            b.wynik();
+        }
+        if (bufor->empty()) {
+            return Matrix();
+        }
+        return Matrix(czynniki[0].wynik().rozmiar(), bufor->data());
+    });
+}
@@ -0,0 +1,176 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Matrix.hpp"
+
+/**
+ * @file Asynchroniczne.hpp
+ * @brief Asynchroniczne operacje na macierzach wykonywane według grafu zależności.
+ *
+ * Każda operacja async_* natychmiast zwraca uchwyt Zadanie. Operacja trafia do kolejki
+ * puli wątków dopiero wtedy, gdy zakończą się wszystkie zadania, od których zależy,
+ * więc niezależne gałęzie grafu wykonują się równolegle, a wątek wywołujący nie jest
+ * blokowany, dopóki sam nie poprosi o wynik.
+ */
+
+class Harmonogram;
+
+/**
+ * @class Zadanie
+ * @brief Uchwyt do wyniku asynchronicznej operacji na macierzach.
+ *
+ * Zwykłą macierz można przekazać wszędzie tam, gdzie oczekiwane jest Zadanie:
+ * zostanie ona potraktowana jak zadanie już zakończone (bez kopiowania danych).
+ */
+class Zadanie {
+public:
+  /**
+   * @brief Tworzy zakończone zadanie, którego wynikiem jest podana macierz.
+   * @param m Macierz wynikowa.
+   */
+  Zadanie(const Matrix& m);
+
+  /**
+   * @brief Sprawdza, czy wynik jest już dostępny.
+   * @return true, jeśli zadanie się zakończyło.
+   */
+  bool gotowe(void) const;
+
+  /**
+   * @brief Czeka na zakończenie zadania i zwraca wynik.
+   * @return Referencja do macierzy wynikowej.
+   */
+  const Matrix& wynik(void) const;
+
+  /**
+   * @brief Zwraca przyszłość standardowej biblioteki powiązaną z wynikiem.
+   * @return Współdzielona przyszłość macierzy wynikowej.
+   */
+  std::shared_future<Matrix> przyszlosc(void) const;
+
+private:
+  friend class Harmonogram;
+
+  /**
+   * @brief Węzeł grafu zależności.
+   */
+  struct Wezel {
+    std::mutex blokada;                               /**< Chroni listę następników i flagę zakończenia. */
+    std::vector<std::shared_ptr<Wezel>> nastepniki;   /**< Zadania czekające na ten węzeł. */
+    std::atomic<int> oczekujace{0};                   /**< Liczba niezakończonych poprzedników. */
+    bool zakonczony = false;                          /**< Czy wynik został już ustawiony. */
+    std::function<Matrix(void)> praca;                /**< Obliczenie wykonywane przez pulę. */
+    std::promise<Matrix> obietnica;                   /**< Miejsce na wynik. */
+    std::shared_future<Matrix> wynik;                 /**< Wynik udostępniany odbiorcom. */
+  };
+
+  explicit Zadanie(std::shared_ptr<Wezel> w) : wezel(std::move(w)) {}
+
+  std::shared_ptr<Wezel> wezel; /**< Węzeł reprezentowany przez uchwyt. */
+};
+
+/**
+ * @class Harmonogram
+ * @brief Pula wątków wykonująca zadania w kolejności wynikającej z grafu zależności.
+ */
+class Harmonogram {
+public:
+  /**
+   * @brief Tworzy pulę wątków.
+   * @param watki Liczba wątków roboczych (0 oznacza liczba_watkow()).
+   */
+  explicit Harmonogram(int watki = 0);
+
+  /**
+   * @brief Kończy pracę puli po wykonaniu wszystkich zaplanowanych zadań.
+   */
+  ~Harmonogram(void);
+
+  Harmonogram(const Harmonogram&) = delete;
+  Harmonogram& operator=(const Harmonogram&) = delete;
+
+  /**
+   * @brief Zwraca wspólny harmonogram używany przez funkcje async_*.
+   * @return Referencja do harmonogramu.
+   */
+  static Harmonogram& domyslny(void);
+
+  /**
+   * @brief Planuje obliczenie, które zostanie uruchomione po zakończeniu wszystkich zależności.
+   * @param zaleznosci Zadania, na których wyniki czeka obliczenie.
+   * @param praca Funkcja zwracająca wynik (może odczytywać wyniki zależności).
+   * @return Uchwyt do wyniku obliczenia.
+   */
+  Zadanie zaplanuj(const std::vector<Zadanie>& zaleznosci, std::function<Matrix(void)> praca);
+
+private:
+  void wstaw_do_kolejki(std::shared_ptr<Zadanie::Wezel> w);
+  void wykonaj(std::shared_ptr<Zadanie::Wezel> w);
+  void petla(void);
+
+  std::vector<std::thread> watki;                        /**< Wątki robocze. */
+  std::deque<std::shared_ptr<Zadanie::Wezel>> kolejka;   /**< Zadania gotowe do wykonania. */
+  std::mutex blokada;                                    /**< Chroni kolejkę. */
+  std::condition_variable sygnal;                        /**< Budzi wątki przy nowym zadaniu. */
+  bool koniec = false;                                   /**< Czy pula jest zamykana. */
+};
+
+/**
+ * @brief Asynchronicznie mnoży dwie macierze.
+ * @param a Lewy czynnik.
+ * @param b Prawy czynnik.
+ * @return Zadanie, którego wynikiem jest a * b.
+ */
+Zadanie async_mul(const Zadanie& a, const Zadanie& b);
+
+/**
+ * @brief Asynchronicznie dodaje dwie macierze.
+ * @param a Pierwszy składnik.
+ * @param b Drugi składnik.
+ * @return Zadanie, którego wynikiem jest a + b.
+ */
+Zadanie async_add(const Zadanie& a, const Zadanie& b);
+
+/**
+ * @brief Asynchronicznie odejmuje dwie macierze.
+ * @param a Odjemna.
+ * @param b Odjemnik.
+ * @return Zadanie, którego wynikiem jest a - b.
+ */
+Zadanie async_sub(const Zadanie& a, const Zadanie& b);
+
+/**
+ * @brief Asynchronicznie transponuje macierz.
+ * @param a Macierz transponowana.
+ * @return Zadanie, którego wynikiem jest transpozycja a.
+ */
+Zadanie async_transpose(const Zadanie& a);
+
+/**
+ * @brief Asynchronicznie mnoży macierz przez skalar.
+ * @param a Macierz.
+ * @param s Skalar.
+ * @return Zadanie, którego wynikiem jest a * s.
+ */
+Zadanie async_scale(const Zadanie& a, int s);
+
+/**
+ * @brief Asynchronicznie oblicza iloczyn łańcucha macierzy A0 * A1 * ... * Ak.
+ *
+ * Wynik liczony jest niezależnymi zadaniami dla bloków wierszy: blok wierszy A0
+ * przechodzi przez cały łańcuch mnożeń, zanim zostanie zapisany w wyniku. Pełne
+ * iloczyny pośrednie nigdy nie powstają, a bloki wykonują się potokowo i równolegle.
+ *
+ * @param czynniki Kolejne czynniki iloczynu (ten sam rozmiar).
+ * @param wiersze_w_bloku Liczba wierszy w jednym zadaniu.
+ * @return Zadanie, którego wynikiem jest iloczyn łańcucha.
+ */
+Zadanie async_chain_mul(const std::vector<Zadanie>& czynniki, int wiersze_w_bloku = 64);
@@ -0,0 +1,340 @@
+#include "BitMatrix.hpp"
+#include "Rownolegle.hpp"
+#include <algorithm> // dla funkcji fill() i min()
+#include <bit>       // dla funkcji popcount() i countr_zero()
+using namespace std;
+
+namespace {
+
+/**
+ * @brief Liczba wierszy B łączonych w jedną tablicę metody czterech Rosjan.
+ *
+ * Osiem wierszy odpowiada jednemu bajtowi wiersza A, a tablica ma 256 pozycji.
+ */
+constexpr int GRUPA = 8;
+
+} // namespace
+
+/**
+ * @brief Tworzy macierz n x n wypełnioną zerami.
+ *
+ * @param n Rozmiar macierzy.
+ */
+BitMatrix::BitMatrix(int n) : size(n > 0 ? n : 0), slowa((size + 63) / 64), bity(static_cast<long>(size) * slowa, 0) {}
+
+/**
+ * @brief Tworzy macierz logiczną z niezerowych elementów macierzy.
+ *
+ * @param m Macierz źródłowa.
+ */
+BitMatrix::BitMatrix(const Matrix& m) : BitMatrix(m.rozmiar()) {
+    rownolegle_wiersze(size, size, [&](int y0, int y1) {
+        for (int x = y0; x < y1; ++x) {
+            span<const int> w = m.widok_wiersza(x);
+            uint64_t* b = slowa_wiersza(x);
+            for (int y = 0; y < size; ++y) {
+                b[y >> 6] |= static_cast<uint64_t>(w[y] != 0) << (y & 63);
+            }
+        }
+    });
+}
+
+/**
+ * @brief Tworzy macierz logiczną o wzorze macierzy wzorcowej.
+ *
+ * Wiersze wypełniane są całymi słowami zamiast pojedynczych bitów.
+ *
+ * @param w Macierz wzorcowa.
+ */
+BitMatrix::BitMatrix(const PatternMatrix& w) : BitMatrix(w.rozmiar()) {
+    for (int x = 0; x < size; ++x) {
+        switch (w.rodzaj()) {
+        case PatternMatrix::Jednostkowa:
+            ustaw_zakres(x, x, x + 1);
+            break;
+        case PatternMatrix::PodPrzekatna:
+            ustaw_zakres(x, 0, x);
+            break;
+        case PatternMatrix::NadPrzekatna:
+            ustaw_zakres(x, x + 1, size);
+            break;
+        case PatternMatrix::Szachownica: {
+            // Jedynki tam, gdzie x + y jest nieparzyste
+            uint64_t wzor = x % 2 == 0 ? 0xAAAAAAAAAAAAAAAAULL : 0x5555555555555555ULL;
+            uint64_t* b = slowa_wiersza(x);
+            fill(b, b + slowa, wzor);
+            if (size % 64 != 0) {
+                b[slowa - 1] &= (1ULL << (size % 64)) - 1;
+            }
+            break;
+        }
+        }
+    }
+}
+
+/**
+ * @brief Ustawia jedynki w kolumnach [od, dod) wiersza x.
+ *
+ * @param x Numer wiersza.
+ * @param od Pierwsza kolumna.
+ * @param dod Kolumna za ostatnią.
+ */
+void BitMatrix::ustaw_zakres(int x, int od, int dod) {
+    uint64_t* b = slowa_wiersza(x);
+    while (od < dod) {
+        int koniec = min(dod, (od & ~63) + 64);
+        int dlugosc = koniec - od;
+        uint64_t maska = dlugosc == 64 ? ~0ULL : ((1ULL << dlugosc) - 1) << (od & 63);
+        b[od >> 6] |= maska;
+        od = koniec;
+    }
+}
+
+/**
+ * @brief Ustawia element (x, y).
+ *
+ * @param x Wiersz.
+ * @param y Kolumna.
+ * @param wartosc Nowa wartość.
+ */
+void BitMatrix::wstaw(int x, int y, bool wartosc) {
+    if (x < 0 || x >= size || y < 0 || y >= size) {
+        cerr << "Indeksy poza zakresem. Indeksy muszą być w zakresie od 0 do " << size - 1 << "." << endl;
+        return;
+    }
+    uint64_t maska = 1ULL << (y & 63);
+    if (wartosc) {
+        slowa_wiersza(x)[y >> 6] |= maska;
+    } else {
+        slowa_wiersza(x)[y >> 6] &= ~maska;
+    }
+}
+
+/**
+ * @brief Tworzy macierz o elementach 0 i 1.
+ *
+ * @return Macierz całkowitoliczbowa.
+ */
+Matrix BitMatrix::materializuj(void) const {
+    if (size == 0) {
+        return Matrix();
+    }
+    vector<int> t(static_cast<long>(size) * size);
+    rownolegle_wiersze(size, size, [&](int y0, int y1) {
+        for (int x = y0; x < y1; ++x) {
+            for (int y = 0; y < size; ++y) {
+                t[static_cast<long>(x) * size + y] = (*this)(x, y);
+            }
+        }
+    });
+    return Matrix(size, t.data());
+}
+
+/**
+ * @brief Zwraca liczbę jedynek w macierzy.
+ *
+ * @return Liczba elementów równych 1.
+ */
+long BitMatrix::liczba_jedynek(void) const {
+    long suma = 0;
+    for (uint64_t s : bity) {
+        suma += popcount(s);
+    }
+    return suma;
+}
+
+/**
+ * @brief Iloczyn logiczny element po elemencie.
+ *
+ * @param m Druga macierz.
+ * @return Referencja do bieżącej macierzy.
+ */
+BitMatrix& BitMatrix::operator&=(const BitMatrix& m) {
+    if (size != m.size) {
+        cerr << "Macierze mają różne rozmiary, nie można wykonać operacji." << endl;
+        return *this;
+    }
+    for (size_t i = 0; i < bity.size(); ++i) {
+        bity[i] &= m.bity[i];
+    }
+    return *this;
+}
+
+/**
+ * @brief Suma logiczna element po elemencie.
+ *
+ * @param m Druga macierz.
+ * @return Referencja do bieżącej macierzy.
+ */
+BitMatrix& BitMatrix::operator|=(const BitMatrix& m) {
+    if (size != m.size) {
+        cerr << "Macierze mają różne rozmiary, nie można wykonać operacji." << endl;
+        return *this;
+    }
+    for (size_t i = 0; i < bity.size(); ++i) {
+        bity[i] |= m.bity[i];
+    }
+    return *this;
+}
+
+/**
+ * @brief Różnica symetryczna element po elemencie.
+ *
+ * @param m Druga macierz.
+ * @return Referencja do bieżącej macierzy.
+ */
+BitMatrix& BitMatrix::operator^=(const BitMatrix& m) {
+    if (size != m.size) {
+        cerr << "Macierze mają różne rozmiary, nie można wykonać operacji." << endl;
+        return *this;
+    }
+    for (size_t i = 0; i < bity.size(); ++i) {
+        bity[i] ^= m.bity[i];
+    }
+    return *this;
+}
+
+/**
+ * @brief Zwraca macierz transponowaną.
+ *
+ * Każdy wątek wypełnia swój blok wierszy wyniku, więc zapisy się nie nakładają.
+ *
+ * @return Nowa macierz.
+ */
+BitMatrix BitMatrix::transponuj(void) const {
+    BitMatrix t(size);
+    rownolegle_wiersze(size, size, [&](int y0, int y1) {
+        for (int y = y0; y < y1; ++y) {
+            uint64_t* w = t.slowa_wiersza(y);
+            for (int x = 0; x < size; ++x) {
+                w[x >> 6] |= static_cast<uint64_t>((*this)(x, y)) << (x & 63);
+            }
+        }
+    });
+    return t;
+}
+
+/**
+ * @brief Oblicza iloczyn logiczny metodą czterech Rosjan.
+ *
+ * Dla każdej grupy ośmiu wierszy B budowana jest tablica 256 ich sum logicznych
+ * (każda z jednego wcześniejszego wpisu i jednego wiersza). Bajt wiersza A wybiera
+ * wtedy gotową sumę, więc osiem kroków OR zastępuje jeden. Każdy wątek buduje
+ * własne tablice dla swojego bloku wierszy.
+ *
+ * @param b Prawy czynnik.
+ * @return Iloczyn logiczny.
+ */
+BitMatrix BitMatrix::iloczyn_logiczny(const BitMatrix& b) const {
+    if (size != b.size) {
+        cerr << "Macierze mają różne rozmiary, nie można ich pomnożyć." << endl;
+        return BitMatrix(size);
+    }
+
+    BitMatrix c(size);
+    const int w = slowa;
+    rownolegle_wiersze(size, static_cast<long>(size) * w, [&](int y0, int y1) {
+        vector<uint64_t> tablica(static_cast<long>(1 << GRUPA) * w);
+        for (int g = 0; g < size; g += GRUPA) {
+            int t = min(GRUPA, size - g);
+            fill(tablica.begin(), tablica.begin() + w, 0);
+            for (int m = 1; m < (1 << t); ++m) {
+                const uint64_t* poprzedni = &tablica[static_cast<long>(m & (m - 1)) * w];
+                const uint64_t* r = b.wiersz(g + countr_zero(static_cast<unsigned>(m)));
+                uint64_t* d = &tablica[static_cast<long>(m) * w];
+                for (int s = 0; s < w; ++s) {
+                    d[s] = poprzedni[s] | r[s];
+                }
+            }
+
+            for (int x = y0; x < y1; ++x) {
+                // Grupa zaczyna się na wielokrotności 8, więc mieści się w jednym słowie
+                unsigned m = (wiersz(x)[g >> 6] >> (g & 63)) & ((1u << t) - 1);
+                if (m == 0) {
+                    continue;
+                }
+                const uint64_t* z = &tablica[static_cast<long>(m) * w];
+                uint64_t* cx = c.slowa_wiersza(x);
+                for (int s = 0; s < w; ++s) {
+                    cx[s] |= z[s];
+                }
+            }
+        }
+    });
+    return c;
+}
+
+/**
+ * @brief Oblicza iloczyn zliczający.
+ *
+ * C(i, j) to liczba jedynek w iloczynie logicznym wiersza i macierzy A
+ * i wiersza j macierzy B^T, liczona po 64 elementy instrukcją popcount.
+ *
+ * @param b Prawy czynnik.
+ * @return Macierz liczb ścieżek długości 2.
+ */
+Matrix BitMatrix::iloczyn_zliczajacy(const BitMatrix& b) const {
+    if (size != b.size) {
+        cerr << "Macierze mają różne rozmiary, nie można ich pomnożyć." << endl;
+        return Matrix();
+    }
+    if (size == 0) {
+        return Matrix();
+    }
+
+    BitMatrix bt = b.transponuj();
+    vector<int> t(static_cast<long>(size) * size);
+    rownolegle_wiersze(size, static_cast<long>(size) * slowa, [&](int y0, int y1) {
+        for (int x = y0; x < y1; ++x) {
+            const uint64_t* a = wiersz(x);
+            for (int y = 0; y < size; ++y) {
+                const uint64_t* r = bt.wiersz(y);
+                int suma = 0;
+                for (int s = 0; s < slowa; ++s) {
+                    suma += popcount(a[s] & r[s]);
+                }
+                t[static_cast<long>(x) * size + y] = suma;
+            }
+        }
+    });
+    return Matrix(size, t.data());
+}
+
+/**
+ * @brief Oblicza relację osiągalności przez kolejne podnoszenie do kwadratu.
+ *
+ * Po k krokach macierz opisuje ścieżki długości do 2^k, więc wystarcza
+ * około log2(n) iloczynów logicznych.
+ *
+ * @return Zwrotne i przechodnie domknięcie.
+ */
+BitMatrix BitMatrix::osiagalnosc(void) const {
+    BitMatrix r(*this);
+    for (int i = 0; i < size; ++i) {
+        r.wstaw(i, i, true);
+    }
+    for (;;) {
+        BitMatrix kwadrat = r.iloczyn_logiczny(r);
+        if (kwadrat == r) {
+            return r;
+        }
+        r = move(kwadrat);
+    }
+}
+
+/**
+ * @brief Wyświetla macierz na strumieniu wyjściowym.
+ *
+ * @param os Strumień wyjściowy.
+ * @param m Macierz do wyświetlenia.
+ * @return Strumień wyjściowy.
+ */
+ostream& operator<<(ostream& os, const BitMatrix& m) {
+    for (int x = 0; x < m.size; ++x) {
+        for (int y = 0; y < m.size; ++y) {
+            os << m(x, y) << " ";
+        }
+        os << endl;
+    }
+    return os;
+}
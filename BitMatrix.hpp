@@ -0,0 +1,165 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "Matrix.hpp"
+#include "PatternMatrix.hpp"
+
+/**
+ * @class BitMatrix
+ * @brief Macierz logiczna n x n przechowująca jeden bit na element.
+ *
+ * Wiersze zapisane są w słowach 64-bitowych (nieużywane bity ostatniego słowa są zerami),
+ * więc macierz zajmuje 32 razy mniej pamięci niż Matrix, a operacje AND/OR/XOR i zliczanie
+ * jedynek przetwarzają 64 elementy jedną instrukcją. Iloczyn logiczny liczony jest metodą
+ * czterech Rosjan, a iloczyn zliczający (liczba ścieżek długości 2) przez popcount.
+ */
+class BitMatrix {
+public:
+  /**
+   * @brief Tworzy macierz n x n wypełnioną zerami.
+   * @param n Rozmiar macierzy.
+   */
+  explicit BitMatrix(int n);
+
+  /**
+   * @brief Tworzy macierz logiczną z niezerowych elementów macierzy.
+   * @param m Macierz źródłowa.
+   */
+  explicit BitMatrix(const Matrix& m);
+
+  /**
+   * @brief Tworzy macierz logiczną o wzorze macierzy wzorcowej.
+   * @param w Macierz wzorcowa (przekątna, pod/nad przekątną lub szachownica).
+   */
+  explicit BitMatrix(const PatternMatrix& w);
+
+  /**
+   * @brief Zwraca rozmiar macierzy.
+   * @return Liczba wierszy (i kolumn) macierzy.
+   */
+  int rozmiar(void) const { return size; }
+
+  /**
+   * @brief Zwraca liczbę słów 64-bitowych w wierszu.
+   * @return Liczba słów.
+   */
+  int slowa_w_wierszu(void) const { return slowa; }
+
+  /**
+   * @brief Zwraca wskaźnik na słowa wiersza x.
+   * @param x Numer wiersza.
+   * @return Wskaźnik tylko do odczytu.
+   */
+  const uint64_t* wiersz(int x) const { return bity.data() + static_cast<long>(x) * slowa; }
+
+  /**
+   * @brief Zwraca element (x, y).
+   * @param x Wiersz.
+   * @param y Kolumna.
+   * @return Wartość elementu.
+   */
+  bool operator()(int x, int y) const { return (wiersz(x)[y >> 6] >> (y & 63)) & 1; }
+
+  /**
+   * @brief Ustawia element (x, y).
+   * @param x Wiersz.
+   * @param y Kolumna.
+   * @param wartosc Nowa wartość.
+   */
+  void wstaw(int x, int y, bool wartosc);
+
+  /**
+   * @brief Tworzy macierz o elementach 0 i 1.
+   * @return Macierz całkowitoliczbowa.
+   */
+  Matrix materializuj(void) const;
+
+  /**
+   * @brief Zwraca liczbę jedynek w macierzy.
+   * @return Liczba elementów równych 1.
+   */
+  long liczba_jedynek(void) const;
+
+  /**
+   * @brief Iloczyn logiczny element po elemencie.
+   * @param m Druga macierz.
+   * @return Referencja do bieżącej macierzy.
+   */
+  BitMatrix& operator&=(const BitMatrix& m);
+
+  /**
+   * @brief Suma logiczna element po elemencie.
+   * @param m Druga macierz.
+   * @return Referencja do bieżącej macierzy.
+   */
+  BitMatrix& operator|=(const BitMatrix& m);
+
+  /**
+   * @brief Różnica symetryczna element po elemencie.
+   * @param m Druga macierz.
+   * @return Referencja do bieżącej macierzy.
+   */
+  BitMatrix& operator^=(const BitMatrix& m);
+
+  /**
+   * @brief Sprawdza, czy dwie macierze są równe.
+   * @param m Macierz do porównania.
+   * @return true, jeśli macierze są równe.
+   */
+  bool operator==(const BitMatrix& m) const { return size == m.size && bity == m.bity; }
+
+  /**
+   * @brief Zwraca macierz transponowaną.
+   * @return Nowa macierz.
+   */
+  BitMatrix transponuj(void) const;
+
+  /**
+   * @brief Oblicza iloczyn logiczny (OR z AND) metodą czterech Rosjan.
+   * @param b Prawy czynnik.
+   * @return Macierz C, w której C(i, j) = 1, gdy A(i, k) i B(k, j) dla pewnego k.
+   */
+  BitMatrix iloczyn_logiczny(const BitMatrix& b) const;
+
+  /**
+   * @brief Oblicza iloczyn zliczający.
+   * @param b Prawy czynnik.
+   * @return Macierz C, w której C(i, j) to liczba k takich, że A(i, k) i B(k, j).
+   */
+  Matrix iloczyn_zliczajacy(const BitMatrix& b) const;
+
+  /**
+   * @brief Oblicza relację osiągalności (zwrotne i przechodnie domknięcie grafu).
+   * @return Macierz R, w której R(i, j) = 1, gdy z i można dojść do j.
+   */
+  BitMatrix osiagalnosc(void) const;
+
+  /**
+   * @brief Wyświetla macierz na strumieniu wyjściowym.
+   * @param os Strumień wyjściowy.
+   * @param m Macierz do wyświetlenia.
+   * @return Strumień wyjściowy.
+   */
+  friend ostream& operator<<(ostream& os, const BitMatrix& m);
+
+private:
+  /**
+   * @brief Zwraca wskaźnik na słowa wiersza x do zapisu.
+   * @param x Numer wiersza.
+   * @return Wskaźnik na słowa.
+   */
+  uint64_t* slowa_wiersza(int x) { return bity.data() + static_cast<long>(x) * slowa; }
+
+  /**
+   * @brief Ustawia jedynki w kolumnach [od, do) wiersza x.
+   * @param x Numer wiersza.
+   * @param od Pierwsza kolumna.
+   * @param dod Kolumna za ostatnią.
+   */
+  void ustaw_zakres(int x, int od, int dod);
+
+  int size;                    /**< Rozmiar macierzy. */
+  int slowa;                   /**< Liczba słów 64-bitowych w wierszu. */
+  std::vector<uint64_t> bity;  /**< Wiersze macierzy po slowa słów. */
+};
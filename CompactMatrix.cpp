@@ -0,0 +1,560 @@
+#include "CompactMatrix.hpp"
+#include "Gemm.hpp"
+#include "Rownolegle.hpp"
+#include <algorithm> // dla funkcji copy_n(), fill_n(), min() i max()
+#include <atomic>
+#include <climits>
+#include <mutex>
+using namespace std;
+
+namespace {
+
+/**
+ * @brief Liczba wierszy rozpakowywanych naraz przy mnożeniu (blok dla gemm).
+ */
+constexpr int WIERSZE_BLOKU = 64;
+
+/**
+ * @brief Zwraca liczbę bajtów wiersza o n elementach.
+ *
+ * @param n Liczba elementów.
+ * @param s Szerokość elementu.
+ * @return Liczba bajtów (wiersze 4-bitowe zaokrąglane są w górę do pełnego bajtu).
+ */
+long bajty_wiersza(int n, SzerokoscElementu s) {
+    return s == SzerokoscElementu::Bity4 ? (n + 1L) / 2 : static_cast<long>(n) * static_cast<int>(s) / 8;
+}
+
+/**
+ * @brief Przycina ograniczenie do zakresu int.
+ *
+ * @param v Ograniczenie.
+ * @return Wartość z przedziału [INT_MIN, INT_MAX].
+ */
+long long do_int(long long v) {
+    return min<long long>(max<long long>(v, INT_MIN), INT_MAX);
+}
+
+} // namespace
+
+/**
+ * @brief Tworzy macierz n x n wypełnioną zerami.
+ *
+ * @param n Rozmiar macierzy.
+ */
+CompactMatrix::CompactMatrix(int n) : CompactMatrix(n, SzerokoscElementu::Bity4, 0, 0) {}
+
+/**
+ * @brief Tworzy macierz o podanej szerokości wypełnioną zerami.
+ *
+ * @param n Rozmiar macierzy.
+ * @param s Szerokość elementu.
+ * @param najmniejszy Dolne ograniczenie wartości.
+ * @param najwiekszy Górne ograniczenie wartości.
+ */
+CompactMatrix::CompactMatrix(int n, SzerokoscElementu s, long long najmniejszy, long long najwiekszy)
+    : size(n > 0 ? n : 0), szer(s), krok(bajty_wiersza(size, s)), najmniejszy(najmniejszy), najwiekszy(najwiekszy),
+      dane(static_cast<long>(size) * krok, 0) {}
+
+/**
+ * @brief Tworzy spakowaną kopię macierzy.
+ *
+ * Zakres wartości wyznaczany jest równoległymi redukcjami Matrix::minimum() i Matrix::maksimum().
+ *
+ * @param m Macierz źródłowa.
+ */
+CompactMatrix::CompactMatrix(const Matrix& m) : CompactMatrix(0) {
+    if (m.dane() == nullptr) {
+        return;
+    }
+
+    long long od = m.minimum().wartosc;
+    long long dod = m.maksimum().wartosc;
+    *this = CompactMatrix(m.rozmiar(), dobierz(od, dod), od, dod);
+    rownolegle_wiersze(size, size, [&](int y0, int y1) {
+        for (int x = y0; x < y1; ++x) {
+            spakuj_wiersz(x, m.widok_wiersza(x).data());
+        }
+    });
+}
+
+/**
+ * @brief Tworzy spakowaną macierz o wzorze macierzy wzorcowej.
+ *
+ * @param w Macierz wzorcowa.
+ */
+CompactMatrix::CompactMatrix(const PatternMatrix& w) : CompactMatrix(w.rozmiar(), SzerokoscElementu::Bity4, 0, 1) {
+    rownolegle_wiersze(size, size, [&](int y0, int y1) {
+        vector<int> t(size);
+        for (int x = y0; x < y1; ++x) {
+            for (int y = 0; y < size; ++y) {
+                t[y] = w(x, y);
+            }
+            spakuj_wiersz(x, t.data());
+        }
+    });
+}
+
+/**
+ * @brief Wybiera najwęższą szerokość dla przedziału wartości.
+ *
+ * @param od Najmniejsza wartość.
+ * @param dod Największa wartość.
+ * @return Szerokość elementu.
+ */
+SzerokoscElementu CompactMatrix::dobierz(long long od, long long dod) {
+    if (od >= 0 && dod <= 15) {
+        return SzerokoscElementu::Bity4;
+    }
+    if (od >= INT8_MIN && dod <= INT8_MAX) {
+        return SzerokoscElementu::Bity8;
+    }
+    if (od >= INT16_MIN && dod <= INT16_MAX) {
+        return SzerokoscElementu::Bity16;
+    }
+    return SzerokoscElementu::Bity32;
+}
+
+/**
+ * @brief Rozpakowuje wiersz x.
+ *
+ * Każda szerokość ma własną pętlę bez rozgałęzień, którą kompilator wektoryzuje
+ * (rozszerzanie bajtów i połówek słów do int, rozdzielanie półbajtów maskami).
+ *
+ * @param x Numer wiersza.
+ * @param t Tablica na size liczb.
+ */
+void CompactMatrix::rozpakuj_wiersz(int x, int* t) const {
+    const uint8_t* w = dane.data() + static_cast<long>(x) * krok;
+    switch (szer) {
+    case SzerokoscElementu::Bity4:
+        for (int b = 0; b < size / 2; ++b) {
+            t[2 * b] = w[b] & 15;
+            t[2 * b + 1] = w[b] >> 4;
+        }
+        if (size % 2 != 0) {
+            t[size - 1] = w[size / 2] & 15;
+        }
+        break;
+    case SzerokoscElementu::Bity8: {
+        const int8_t* p = reinterpret_cast<const int8_t*>(w);
+        for (int j = 0; j < size; ++j) {
+            t[j] = p[j];
+        }
+        break;
+    }
+    case SzerokoscElementu::Bity16: {
+        const int16_t* p = reinterpret_cast<const int16_t*>(w);
+        for (int j = 0; j < size; ++j) {
+            t[j] = p[j];
+        }
+        break;
+    }
+    case SzerokoscElementu::Bity32:
+        copy_n(reinterpret_cast<const int32_t*>(w), size, t);
+        break;
+    }
+}
+
+/**
+ * @brief Pakuje wiersz x.
+ *
+ * Wolny półbajt na końcu nieparzystego wiersza 4-bitowego pozostaje zerem,
+ * więc równe macierze tej samej szerokości mają identyczne bajty.
+ *
+ * @param x Numer wiersza.
+ * @param t Tablica size liczb mieszczących się w bieżącej szerokości.
+ */
+void CompactMatrix::spakuj_wiersz(int x, const int* t) {
+    uint8_t* w = dane.data() + static_cast<long>(x) * krok;
+    switch (szer) {
+    case SzerokoscElementu::Bity4:
+        for (int b = 0; b < size / 2; ++b) {
+            w[b] = static_cast<uint8_t>((t[2 * b] & 15) | (t[2 * b + 1] << 4));
+        }
+        if (size % 2 != 0) {
+            w[size / 2] = static_cast<uint8_t>(t[size - 1] & 15);
+        }
+        break;
+    case SzerokoscElementu::Bity8: {
+        int8_t* p = reinterpret_cast<int8_t*>(w);
+        for (int j = 0; j < size; ++j) {
+            p[j] = static_cast<int8_t>(t[j]);
+        }
+        break;
+    }
+    case SzerokoscElementu::Bity16: {
+        int16_t* p = reinterpret_cast<int16_t*>(w);
+        for (int j = 0; j < size; ++j) {
+            p[j] = static_cast<int16_t>(t[j]);
+        }
+        break;
+    }
+    case SzerokoscElementu::Bity32:
+        copy_n(t, size, reinterpret_cast<int32_t*>(w));
+        break;
+    }
+}
+
+/**
+ * @brief Zwraca element (x, y).
+ *
+ * @param x Wiersz.
+ * @param y Kolumna.
+ * @return Wartość elementu.
+ */
+int CompactMatrix::operator()(int x, int y) const {
+    const uint8_t* w = dane.data() + static_cast<long>(x) * krok;
+    switch (szer) {
+    case SzerokoscElementu::Bity4:
+        return (w[y / 2] >> (4 * (y % 2))) & 15;
+    case SzerokoscElementu::Bity8:
+        return reinterpret_cast<const int8_t*>(w)[y];
+    case SzerokoscElementu::Bity16:
+        return reinterpret_cast<const int16_t*>(w)[y];
+    case SzerokoscElementu::Bity32:
+        break;
+    }
+    return reinterpret_cast<const int32_t*>(w)[y];
+}
+
+/**
+ * @brief Ustawia element (x, y).
+ *
+ * @param x Wiersz.
+ * @param y Kolumna.
+ * @param wartosc Nowa wartość.
+ */
+void CompactMatrix::wstaw(int x, int y, int wartosc) {
+    if (x < 0 || x >= size || y < 0 || y >= size) {
+        cerr << "Indeks poza zakresem macierzy." << endl;
+        return;
+    }
+
+    long long od = min<long long>(najmniejszy, wartosc);
+    long long dod = max<long long>(najwiekszy, wartosc);
+    SzerokoscElementu s = dobierz(od, dod);
+    if (static_cast<int>(s) > static_cast<int>(szer)) {
+        przepakuj(s, od, dod);
+    }
+    najmniejszy = od;
+    najwiekszy = dod;
+
+    uint8_t* w = dane.data() + static_cast<long>(x) * krok;
+    switch (szer) {
+    case SzerokoscElementu::Bity4: {
+        int przesuniecie = 4 * (y % 2);
+        w[y / 2] = static_cast<uint8_t>((w[y / 2] & ~(15 << przesuniecie)) | (wartosc << przesuniecie));
+        break;
+    }
+    case SzerokoscElementu::Bity8:
+        reinterpret_cast<int8_t*>(w)[y] = static_cast<int8_t>(wartosc);
+        break;
+    case SzerokoscElementu::Bity16:
+        reinterpret_cast<int16_t*>(w)[y] = static_cast<int16_t>(wartosc);
+        break;
+    case SzerokoscElementu::Bity32:
+        reinterpret_cast<int32_t*>(w)[y] = wartosc;
+        break;
+    }
+}
+
+/**
+ * @brief Zapisuje elementy w innej szerokości.
+ *
+ * @param s Nowa szerokość.
+ * @param od Nowe dolne ograniczenie.
+ * @param dod Nowe górne ograniczenie.
+ */
+void CompactMatrix::przepakuj(SzerokoscElementu s, long long od, long long dod) {
+    if (s != szer) {
+        CompactMatrix t(size, s, od, dod);
+        rownolegle_wiersze(size, size, [&](int y0, int y1) {
+            vector<int> w(size);
+            for (int x = y0; x < y1; ++x) {
+                rozpakuj_wiersz(x, w.data());
+                t.spakuj_wiersz(x, w.data());
+            }
+        });
+        *this = move(t);
+    }
+    najmniejszy = od;
+    najwiekszy = dod;
+}
+
+/**
+ * @brief Przekształca rozpakowane wiersze i pakuje je w szerokości wynikającej z ograniczeń.
+ *
+ * Bez zmiany szerokości wiersze zapisywane są w miejscu, w przeciwnym razie do nowego bufora.
+ *
+ * @param od Dolne ograniczenie wyniku.
+ * @param dod Górne ograniczenie wyniku.
+ * @param f Przekształcenie rozpakowanego wiersza.
+ */
+template <typename F>
+void CompactMatrix::przeksztalc(long long od, long long dod, F f) {
+    od = do_int(od);
+    dod = do_int(dod);
+    SzerokoscElementu s = dobierz(od, dod);
+    CompactMatrix wynik(s == szer ? 0 : size, s, od, dod);
+    CompactMatrix& cel = s == szer ? *this : wynik;
+
+    rownolegle_wiersze(size, size, [&](int y0, int y1) {
+        vector<int> w(size);
+        vector<int> bufor(size);
+        for (int x = y0; x < y1; ++x) {
+            rozpakuj_wiersz(x, w.data());
+            f(w.data(), bufor.data(), x);
+            cel.spakuj_wiersz(x, w.data());
+        }
+    });
+
+    if (s != szer) {
+        *this = move(wynik);
+    }
+    najmniejszy = od;
+    najwiekszy = dod;
+}
+
+/**
+ * @brief Tworzy macierz o elementach typu int.
+ *
+ * @return Rozpakowana macierz (niezaalokowana dla pustej macierzy).
+ */
+Matrix CompactMatrix::materializuj(void) const {
+    if (size == 0) {
+        return Matrix();
+    }
+
+    Matrix m(size, bez_zerowania);
+    int* d = m.widok_zapisu().dane;
+    rownolegle_wiersze(size, size, [&](int y0, int y1) {
+        for (int x = y0; x < y1; ++x) {
+            rozpakuj_wiersz(x, d + static_cast<long>(x) * size);
+        }
+    });
+    return m;
+}
+
+/**
+ * @brief Wyznacza dokładny zakres wartości i zwęża zapis.
+ *
+ * @return Referencja do bieżącej macierzy.
+ */
+CompactMatrix& CompactMatrix::dopasuj(void) {
+    if (size == 0) {
+        return *this;
+    }
+
+    long long od = INT_MAX;
+    long long dod = INT_MIN;
+    mutex blokada;
+    rownolegle_wiersze(size, size, [&](int y0, int y1) {
+        vector<int> w(size);
+        int mn = INT_MAX;
+        int mx = INT_MIN;
+        for (int x = y0; x < y1; ++x) {
+            rozpakuj_wiersz(x, w.data());
+            for (int j = 0; j < size; ++j) {
+                mn = min(mn, w[j]);
+                mx = max(mx, w[j]);
+            }
+        }
+        lock_guard<mutex> l(blokada);
+        od = min<long long>(od, mn);
+        dod = max<long long>(dod, mx);
+    });
+
+    przepakuj(dobierz(od, dod), od, dod);
+    return *this;
+}
+
+/**
+ * @brief Dodaje macierz element po elemencie.
+ *
+ * @param m Macierz tego samego rozmiaru.
+ * @return Referencja do bieżącej macierzy.
+ */
+CompactMatrix& CompactMatrix::operator+=(const CompactMatrix& m) {
+    if (size != m.size) {
+        cerr << "Macierze mają różne rozmiary, nie można ich dodać." << endl;
+        return *this;
+    }
+
+    przeksztalc(najmniejszy + m.najmniejszy, najwiekszy + m.najwiekszy, [&](int* w, int* b, int x) {
+        m.rozpakuj_wiersz(x, b);
+        for (int j = 0; j < size; ++j) {
+            w[j] += b[j];
+        }
+    });
+    return *this;
+}
+
+/**
+ * @brief Dodaje skalar do każdego elementu.
+ *
+ * @param a Dodawana wartość.
+ * @return Referencja do bieżącej macierzy.
+ */
+CompactMatrix& CompactMatrix::operator+=(int a) {
+    przeksztalc(najmniejszy + a, najwiekszy + a, [&](int* w, int*, int) {
+        for (int j = 0; j < size; ++j) {
+            w[j] += a;
+        }
+    });
+    return *this;
+}
+
+/**
+ * @brief Mnoży każdy element przez skalar.
+ *
+ * @param a Mnożnik.
+ * @return Referencja do bieżącej macierzy.
+ */
+CompactMatrix& CompactMatrix::operator*=(int a) {
+    long long p = najmniejszy * a;
+    long long q = najwiekszy * a;
+    przeksztalc(min(p, q), max(p, q), [&](int* w, int*, int) {
+        for (int j = 0; j < size; ++j) {
+            w[j] *= a;
+        }
+    });
+    return *this;
+}
+
+/**
+ * @brief Oblicza iloczyn macierzy.
+ *
+ * B rozpakowywana jest raz (koszt O(n^2) wobec O(n^3) mnożenia), a wiersze A
+ * blokami po WIERSZE_BLOKU, które mnożone są tym samym jądrem gemm co w Matrix.
+ * Szerokość wyniku wynika z ograniczeń: każdy element jest sumą n iloczynów.
+ *
+ * @param b Prawy czynnik.
+ * @return Iloczyn (pusta macierz przy błędzie).
+ */
+CompactMatrix CompactMatrix::iloczyn(const CompactMatrix& b) const {
+    if (size != b.size) {
+        cerr << "Macierze mają różne rozmiary, nie można ich pomnożyć." << endl;
+        return CompactMatrix(0);
+    }
+
+    long long iloczyny[4] = {najmniejszy * b.najmniejszy, najmniejszy * b.najwiekszy, najwiekszy * b.najmniejszy,
+                             najwiekszy * b.najwiekszy};
+    // Iloczyn dwóch int mieści się w long long, ale pomnożony przez n już nie; po
+    // przycięciu do zakresu int czynnik ma co najwyżej 32 bity, więc mnożenie jest bezpieczne
+    long long od = do_int(do_int(*min_element(iloczyny, iloczyny + 4)) * size);
+    long long dod = do_int(do_int(*max_element(iloczyny, iloczyny + 4)) * size);
+    CompactMatrix c(size, dobierz(od, dod), od, dod);
+
+    vector<int> bb(static_cast<long>(size) * size);
+    rownolegle_wiersze(size, size, [&](int y0, int y1) {
+        for (int x = y0; x < y1; ++x) {
+            b.rozpakuj_wiersz(x, bb.data() + static_cast<long>(x) * size);
+        }
+    });
+
+    const int bloki = (size + WIERSZE_BLOKU - 1) / WIERSZE_BLOKU;
+    rownolegle_wiersze(bloki, static_cast<long>(WIERSZE_BLOKU) * size * size, [&](int b0, int b1) {
+        vector<int> a(static_cast<long>(WIERSZE_BLOKU) * size);
+        vector<int> w(static_cast<long>(WIERSZE_BLOKU) * size);
+        for (int blok = b0; blok < b1; ++blok) {
+            int x0 = blok * WIERSZE_BLOKU;
+            int k = min(WIERSZE_BLOKU, size - x0);
+            for (int i = 0; i < k; ++i) {
+                rozpakuj_wiersz(x0 + i, a.data() + static_cast<long>(i) * size);
+            }
+            fill_n(w.begin(), static_cast<long>(k) * size, 0);
+            gemm(k, size, size, 1, a.data(), size, bb.data(), size, w.data(), size);
+            for (int i = 0; i < k; ++i) {
+                c.spakuj_wiersz(x0 + i, w.data() + static_cast<long>(i) * size);
+            }
+        }
+    });
+    return c;
+}
+
+/**
+ * @brief Sprawdza warunek dla wszystkich par elementów, przerywając po pierwszej niezgodności.
+ *
+ * @param m Druga macierz.
+ * @param warunek Predykat dla pary elementów.
+ * @return true, jeśli warunek zachodzi dla wszystkich par.
+ */
+template <typename P>
+bool CompactMatrix::wszystkie(const CompactMatrix& m, P warunek) const {
+    if (size != m.size) {
+        return false;
+    }
+
+    atomic<bool> zgodne{true};
+    rownolegle_wiersze(size, size, [&](int y0, int y1) {
+        vector<int> a(size);
+        vector<int> b(size);
+        for (int x = y0; x < y1 && zgodne.load(memory_order_relaxed); ++x) {
+            rozpakuj_wiersz(x, a.data());
+            m.rozpakuj_wiersz(x, b.data());
+            int ok = 1;
+            for (int j = 0; j < size; ++j) {
+                ok &= warunek(a[j], b[j]);
+            }
+            if (!ok) {
+                zgodne.store(false, memory_order_relaxed);
+            }
+        }
+    });
+    return zgodne.load(memory_order_relaxed);
+}
+
+/**
+ * @brief Sprawdza, czy macierze są równe.
+ *
+ * Przy tej samej szerokości wystarczy porównać spakowane bajty.
+ *
+ * @param m Macierz do porównania.
+ * @return true, jeśli macierze są równe.
+ */
+bool CompactMatrix::operator==(const CompactMatrix& m) const {
+    if (size == m.size && szer == m.szer) {
+        return dane == m.dane;
+    }
+    return wszystkie(m, [](int a, int b) { return a == b; });
+}
+
+/**
+ * @brief Sprawdza, czy wszystkie elementy są większe od odpowiadających elementów m.
+ *
+ * @param m Macierz do porównania.
+ * @return true, jeśli warunek jest spełniony.
+ */
+bool CompactMatrix::operator>(const CompactMatrix& m) const {
+    return wszystkie(m, [](int a, int b) { return a > b; });
+}
+
+/**
+ * @brief Sprawdza, czy wszystkie elementy są mniejsze od odpowiadających elementów m.
+ *
+ * @param m Macierz do porównania.
+ * @return true, jeśli warunek jest spełniony.
+ */
+bool CompactMatrix::operator<(const CompactMatrix& m) const {
+    return wszystkie(m, [](int a, int b) { return a < b; });
+}
+
+/**
+ * @brief Wypisuje macierz w tym samym formacie co Matrix.
+ *
+ * @param os Strumień wyjściowy.
+ * @param m Macierz do wypisania.
+ * @return Strumień wyjściowy.
+ */
+ostream& operator<<(ostream& os, const CompactMatrix& m) {
+    vector<int> w(m.size);
+    for (int x = 0; x < m.size; ++x) {
+        m.rozpakuj_wiersz(x, w.data());
+        for (int y = 0; y < m.size; ++y) {
+            os << w[y] << " ";
+        }
+        os << endl;
+    }
+    return os;
+}
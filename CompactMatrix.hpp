@@ -0,0 +1,219 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "Matrix.hpp"
+#include "PatternMatrix.hpp"
+
+/**
+ * @brief Liczba bitów przeznaczona na jeden element CompactMatrix.
+ */
+enum class SzerokoscElementu {
+  Bity4 = 4,    /**< Wartości 0..15 (np. z Matrix::losuj() lub macierzy wzorcowych). */
+  Bity8 = 8,    /**< Wartości -128..127. */
+  Bity16 = 16,  /**< Wartości -32768..32767. */
+  Bity32 = 32   /**< Pełny zakres int. */
+};
+
+/**
+ * @class CompactMatrix
+ * @brief Macierz n x n przechowująca elementy na 4, 8, 16 lub 32 bitach.
+ *
+ * Szerokość dobierana jest do zakresu wartości, więc macierz o elementach 0..9
+ * zajmuje 8 razy mniej pamięci niż Matrix. Operacje rozpakowują kolejne wiersze
+ * do tablicy int, liczą na niej pętlą wektoryzowaną jak w Matrix i pakują wynik
+ * z powrotem, dzięki czemu z pamięci czytane są tylko spakowane dane.
+ *
+ * Macierz pamięta ograniczenia swoich wartości. Jeśli wynik operacji może nie
+ * zmieścić się w bieżącej szerokości, dane są najpierw poszerzane. Ograniczenia
+ * po operacjach są zachowawcze; dopasuj() wyznacza je dokładnie i zwęża zapis.
+ */
+class CompactMatrix {
+public:
+  /**
+   * @brief Tworzy macierz n x n wypełnioną zerami (4 bity na element).
+   * @param n Rozmiar macierzy.
+   */
+  explicit CompactMatrix(int n);
+
+  /**
+   * @brief Tworzy spakowaną kopię macierzy w najwęższej mieszczącej ją szerokości.
+   * @param m Macierz źródłowa.
+   */
+  explicit CompactMatrix(const Matrix& m);
+
+  /**
+   * @brief Tworzy spakowaną macierz o wzorze macierzy wzorcowej (4 bity na element).
+   * @param w Macierz wzorcowa.
+   */
+  explicit CompactMatrix(const PatternMatrix& w);
+
+  /**
+   * @brief Zwraca rozmiar macierzy.
+   * @return Liczba wierszy (i kolumn) macierzy.
+   */
+  int rozmiar(void) const { return size; }
+
+  /**
+   * @brief Zwraca bieżącą szerokość elementu.
+   * @return Liczba bitów na element.
+   */
+  SzerokoscElementu szerokosc(void) const { return szer; }
+
+  /**
+   * @brief Zwraca wielkość spakowanych danych.
+   * @return Liczba bajtów zajmowanych przez elementy.
+   */
+  long bajty(void) const { return static_cast<long>(dane.size()); }
+
+  /**
+   * @brief Zwraca element (x, y).
+   * @param x Wiersz.
+   * @param y Kolumna.
+   * @return Wartość elementu.
+   */
+  int operator()(int x, int y) const;
+
+  /**
+   * @brief Ustawia element (x, y), w razie potrzeby poszerzając zapis.
+   * @param x Wiersz.
+   * @param y Kolumna.
+   * @param wartosc Nowa wartość.
+   */
+  void wstaw(int x, int y, int wartosc);
+
+  /**
+   * @brief Tworzy macierz o elementach typu int.
+   * @return Rozpakowana macierz.
+   */
+  Matrix materializuj(void) const;
+
+  /**
+   * @brief Wyznacza dokładny zakres wartości i zapisuje elementy w najwęższej szerokości.
+   * @return Referencja do bieżącej macierzy.
+   */
+  CompactMatrix& dopasuj(void);
+
+  /**
+   * @brief Dodaje macierz element po elemencie.
+   * @param m Macierz tego samego rozmiaru.
+   * @return Referencja do bieżącej macierzy.
+   */
+  CompactMatrix& operator+=(const CompactMatrix& m);
+
+  /**
+   * @brief Dodaje skalar do każdego elementu.
+   * @param a Dodawana wartość.
+   * @return Referencja do bieżącej macierzy.
+   */
+  CompactMatrix& operator+=(int a);
+
+  /**
+   * @brief Mnoży każdy element przez skalar.
+   * @param a Mnożnik.
+   * @return Referencja do bieżącej macierzy.
+   */
+  CompactMatrix& operator*=(int a);
+
+  /**
+   * @brief Oblicza iloczyn macierzy.
+   * @param b Prawy czynnik tego samego rozmiaru.
+   * @return Iloczyn zapisany w najwęższej szerokości wynikającej z ograniczeń czynników.
+   */
+  CompactMatrix iloczyn(const CompactMatrix& b) const;
+
+  /**
+   * @brief Sprawdza, czy dwie macierze mają równe elementy (niezależnie od szerokości zapisu).
+   * @param m Macierz do porównania.
+   * @return true, jeśli macierze są równe.
+   */
+  bool operator==(const CompactMatrix& m) const;
+
+  /**
+   * @brief Sprawdza, czy wszystkie elementy są większe od odpowiadających elementów m.
+   * @param m Macierz do porównania.
+   * @return true, jeśli warunek jest spełniony.
+   */
+  bool operator>(const CompactMatrix& m) const;
+
+  /**
+   * @brief Sprawdza, czy wszystkie elementy są mniejsze od odpowiadających elementów m.
+   * @param m Macierz do porównania.
+   * @return true, jeśli warunek jest spełniony.
+   */
+  bool operator<(const CompactMatrix& m) const;
+
+  /**
+   * @brief Wyświetla macierz na strumieniu wyjściowym.
+   * @param os Strumień wyjściowy.
+   * @param m Macierz do wyświetlenia.
+   * @return Strumień wyjściowy.
+   */
+  friend ostream& operator<<(ostream& os, const CompactMatrix& m);
+
+private:
+  /**
+   * @brief Tworzy macierz n x n o podanej szerokości i ograniczeniach (elementy równe zeru).
+   * @param n Rozmiar macierzy.
+   * @param s Szerokość elementu.
+   * @param najmniejszy Dolne ograniczenie wartości.
+   * @param najwiekszy Górne ograniczenie wartości.
+   */
+  CompactMatrix(int n, SzerokoscElementu s, long long najmniejszy, long long najwiekszy);
+
+  /**
+   * @brief Wybiera najwęższą szerokość dla wartości z przedziału [od, do].
+   * @param od Najmniejsza wartość.
+   * @param dod Największa wartość.
+   * @return Szerokość elementu.
+   */
+  static SzerokoscElementu dobierz(long long od, long long dod);
+
+  /**
+   * @brief Rozpakowuje wiersz x do tablicy size liczb.
+   * @param x Numer wiersza.
+   * @param t Tablica wynikowa.
+   */
+  void rozpakuj_wiersz(int x, int* t) const;
+
+  /**
+   * @brief Pakuje size liczb z tablicy do wiersza x (wartości muszą mieścić się w szerokości).
+   * @param x Numer wiersza.
+   * @param t Tablica źródłowa.
+   */
+  void spakuj_wiersz(int x, const int* t);
+
+  /**
+   * @brief Zapisuje elementy w innej szerokości i ustawia nowe ograniczenia.
+   * @param s Nowa szerokość.
+   * @param najmniejszy Nowe dolne ograniczenie.
+   * @param najwiekszy Nowe górne ograniczenie.
+   */
+  void przepakuj(SzerokoscElementu s, long long najmniejszy, long long najwiekszy);
+
+  /**
+   * @brief Przekształca każdy element funkcją f przy nowych ograniczeniach wartości.
+   * @param najmniejszy Dolne ograniczenie wyniku.
+   * @param najwiekszy Górne ograniczenie wyniku.
+   * @param f Funkcja (int* wiersz, int* bufor, int x) zmieniająca rozpakowany wiersz x;
+   *          bufor to pomocnicza tablica size liczb.
+   */
+  template <typename F>
+  void przeksztalc(long long najmniejszy, long long najwiekszy, F f);
+
+  /**
+   * @brief Sprawdza warunek dla wszystkich par odpowiadających sobie elementów.
+   * @param m Druga macierz.
+   * @param warunek Predykat dla pary elementów.
+   * @return true, jeśli warunek zachodzi dla wszystkich par.
+   */
+  template <typename P>
+  bool wszystkie(const CompactMatrix& m, P warunek) const;
+
+  int size;                    /**< Rozmiar macierzy. */
+  SzerokoscElementu szer;      /**< Liczba bitów na element. */
+  long krok;                   /**< Liczba bajtów w wierszu (wiersze zaczynają się od pełnego bajtu). */
+  long long najmniejszy;       /**< Dolne ograniczenie wartości elementów. */
+  long long najwiekszy;        /**< Górne ograniczenie wartości elementów. */
+  std::vector<uint8_t> dane;   /**< Spakowane wiersze po krok bajtów. */
+};
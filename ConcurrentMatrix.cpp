@@ -0,0 +1,231 @@
+#include "ConcurrentMatrix.hpp"
+#include <iostream>
+#include <vector>
+#include <thread>    // dla funkcji this_thread::yield()
+#include <algorithm> // dla funkcji copy_n
+using namespace std;
+
+namespace {
+
+/**
+ * @brief Liczba prób spójnego odczytu całej macierzy przed zablokowaniem bloków.
+ */
+constexpr int PROBY_MIGAWKI = 8;
+
+/**
+ * @brief Odczytuje element współdzielony z piszącym bez wyścigu danych.
+ */
+inline int odczytaj(const int& x) {
+    return atomic_ref<int>(const_cast<int&>(x)).load(memory_order_relaxed);
+}
+
+/**
+ * @brief Zapisuje element współdzielony z czytelnikami bez wyścigu danych.
+ */
+inline void zapisz(int& x, int wartosc) {
+    atomic_ref<int>(x).store(wartosc, memory_order_relaxed);
+}
+
+} // namespace
+
+/**
+ * @brief Konstruktor alokujący macierz o wymiarach n x n.
+ *
+ * @param n Rozmiar macierzy.
+ * @param wiersze_w_bloku Liczba wierszy chronionych jednym licznikiem wersji.
+ */
+ConcurrentMatrix::ConcurrentMatrix(int n, int wiersze_w_bloku)
+    : size(0), wiersze_w_bloku(wiersze_w_bloku > 0 ? wiersze_w_bloku : 1), liczba_blokow(0) {
+    if (n <= 0) {
+        cout << "Rozmiar macierzy musi być większy od zera. Macierz nie została zaalokowana." << endl;
+        return;
+    }
+
+    size = n;
+    liczba_blokow = (size + this->wiersze_w_bloku - 1) / this->wiersze_w_bloku;
+    data = make_unique<int[]>(static_cast<long>(size) * size);
+    bloki = make_unique<Blok[]>(liczba_blokow);
+}
+
+/**
+ * @brief Konstruktor kopiujący dane ze zwykłej macierzy.
+ *
+ * @param m Macierz źródłowa.
+ * @param wiersze_w_bloku Liczba wierszy chronionych jednym licznikiem wersji.
+ */
+ConcurrentMatrix::ConcurrentMatrix(const Matrix& m, int wiersze_w_bloku)
+    : ConcurrentMatrix(m.rozmiar(), wiersze_w_bloku) {
+    if (m.dane() != nullptr) {
+        copy_n(m.dane(), static_cast<long>(size) * size, data.get());
+    }
+}
+
+/**
+ * @brief Czeka, aż w bloku nie będzie trwał zapis.
+ *
+ * @param b Blok wierszy.
+ * @return Parzysta wersja bloku.
+ */
+uint64_t ConcurrentMatrix::poczatek_odczytu(const Blok& b) {
+    uint64_t v = b.wersja.load(memory_order_acquire);
+    while (v & 1) {
+        this_thread::yield();
+        v = b.wersja.load(memory_order_acquire);
+    }
+    return v;
+}
+
+/**
+ * @brief Kopiuje wiersze [y0, y1) bez weryfikacji wersji.
+ *
+ * @param y0 Pierwszy kopiowany wiersz.
+ * @param y1 Wiersz za ostatnim kopiowanym.
+ * @param t Tablica docelowa.
+ */
+void ConcurrentMatrix::kopiuj_wiersze(int y0, int y1, int* t) const {
+    long poczatek = static_cast<long>(y0) * size;
+    long koniec = static_cast<long>(y1) * size;
+    for (long i = poczatek; i < koniec; ++i) {
+        t[i - poczatek] = odczytaj(data[i]);
+    }
+}
+
+/**
+ * @brief Zwraca wartość elementu macierzy bez zakładania blokad.
+ *
+ * @param x Indeks wiersza.
+ * @param y Indeks kolumny.
+ * @return Wartość elementu lub -1 w przypadku błędu.
+ */
+int ConcurrentMatrix::pokaz(int x, int y) const {
+    if (x < 0 || x >= size || y < 0 || y >= size) {
+        cerr << "Indeksy poza zakresem." << endl;
+        return -1;
+    }
+
+    const Blok& b = blok(x);
+    int wartosc;
+    uint64_t v;
+    do {
+        v = poczatek_odczytu(b);
+        wartosc = odczytaj(data[static_cast<long>(x) * size + y]);
+        atomic_thread_fence(memory_order_acquire);
+    } while (b.wersja.load(memory_order_relaxed) != v);
+
+    return wartosc;
+}
+
+/**
+ * @brief Kopiuje spójny stan wiersza.
+ *
+ * @param y Numer wiersza.
+ * @param t Tablica docelowa.
+ */
+void ConcurrentMatrix::pokaz_wiersz(int y, int* t) const {
+    if (y < 0 || y >= size) {
+        cerr << "Indeks wiersza poza zakresem. Wartość y powinna być w przedziale od 0 do " << size - 1 << "." << endl;
+        return;
+    }
+
+    const Blok& b = blok(y);
+    uint64_t v;
+    do {
+        v = poczatek_odczytu(b);
+        kopiuj_wiersze(y, y + 1, t);
+        atomic_thread_fence(memory_order_acquire);
+    } while (b.wersja.load(memory_order_relaxed) != v);
+}
+
+/**
+ * @brief Tworzy spójną migawkę całej macierzy.
+ *
+ * Najpierw zapamiętywane są wersje wszystkich bloków, potem kopiowane dane,
+ * a na końcu sprawdzane, czy żadna wersja się nie zmieniła. Jeśli kolejne próby
+ * się nie powiodą, wszystkie bloki są blokowane w kolejności rosnącej, co
+ * gwarantuje postęp bez ryzyka zakleszczenia z piszącymi.
+ *
+ * @return Macierz z kopią danych.
+ */
+Matrix ConcurrentMatrix::migawka(void) const {
+    Matrix m(size);
+    if (size == 0) {
+        return m;
+    }
+
+    vector<uint64_t> wersje(liczba_blokow);
+    for (int proba = 0; proba < PROBY_MIGAWKI; ++proba) {
+        for (int b = 0; b < liczba_blokow; ++b) {
+            wersje[b] = poczatek_odczytu(bloki[b]);
+        }
+        kopiuj_wiersze(0, size, m.data);
+        atomic_thread_fence(memory_order_acquire);
+
+        bool spojna = true;
+        for (int b = 0; b < liczba_blokow && spojna; ++b) {
+            spojna = bloki[b].wersja.load(memory_order_relaxed) == wersje[b];
+        }
+        if (spojna) {
+            return m;
+        }
+    }
+
+    for (int b = 0; b < liczba_blokow; ++b) {
+        bloki[b].zapis.lock();
+    }
+    kopiuj_wiersze(0, size, m.data);
+    for (int b = liczba_blokow - 1; b >= 0; --b) {
+        bloki[b].zapis.unlock();
+    }
+
+    return m;
+}
+
+/**
+ * @brief Wstawia wartość do macierzy, blokując tylko blok wiersza x.
+ *
+ * @param x Indeks wiersza.
+ * @param y Indeks kolumny.
+ * @param wartosc Wartość do wstawienia.
+ */
+void ConcurrentMatrix::wstaw(int x, int y, int wartosc) {
+    if (x < 0 || x >= size || y < 0 || y >= size) {
+        cerr << "Indeksy poza zakresem. Indeksy muszą być w zakresie od 0 do " << size - 1 << "." << endl;
+        return;
+    }
+
+    Blok& b = blok(x);
+    lock_guard<mutex> blokada(b.zapis);
+    uint64_t v = b.wersja.load(memory_order_relaxed);
+    b.wersja.store(v + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+
+    zapisz(data[static_cast<long>(x) * size + y], wartosc);
+
+    b.wersja.store(v + 2, memory_order_release);
+}
+
+/**
+ * @brief Wypełnia wiersz danymi z tabeli, blokując tylko blok tego wiersza.
+ *
+ * @param y Indeks wiersza.
+ * @param t Tablica wartości do wstawienia w wierszu.
+ */
+void ConcurrentMatrix::wiersz(int y, const int* t) {
+    if (y < 0 || y >= size) {
+        cerr << "Indeks wiersza poza zakresem. Wartość y powinna być w przedziale od 0 do " << size - 1 << "." << endl;
+        return;
+    }
+
+    Blok& b = blok(y);
+    lock_guard<mutex> blokada(b.zapis);
+    uint64_t v = b.wersja.load(memory_order_relaxed);
+    b.wersja.store(v + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+
+    int* w = &data[static_cast<long>(y) * size];
+    for (int i = 0; i < size; ++i) {
+        zapisz(w[i], t[i]);
+    }
+
+    b.wersja.store(v + 2, memory_order_release);
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include "Matrix.hpp"
+
+/**
+ * @class ConcurrentMatrix
+ * @brief Macierz kwadratowa do współbieżnego odczytu i zapisu przez wiele wątków.
+ *
+ * Wiersze podzielone są na bloki, a każdy blok chroniony jest licznikiem wersji
+ * (seqlock). Czytelnicy nie zakładają blokad: odczytują dane, a następnie sprawdzają,
+ * czy wersja bloku się nie zmieniła, w razie potrzeby ponawiając odczyt.
+ * Piszący blokują wyłącznie modyfikowany blok, więc zapisy do rozłącznych bloków
+ * wierszy wykonują się równolegle.
+ */
+class ConcurrentMatrix {
+public:
+  /**
+   * @brief Konstruktor alokujący macierz o wymiarach n x n wypełnioną zerami.
+   * @param n Rozmiar macierzy.
+   * @param wiersze_w_bloku Liczba wierszy chronionych jednym licznikiem wersji.
+   */
+  explicit ConcurrentMatrix(int n, int wiersze_w_bloku = 64);
+
+  /**
+   * @brief Konstruktor kopiujący dane ze zwykłej macierzy.
+   * @param m Macierz źródłowa.
+   * @param wiersze_w_bloku Liczba wierszy chronionych jednym licznikiem wersji.
+   */
+  explicit ConcurrentMatrix(const Matrix& m, int wiersze_w_bloku = 64);
+
+  /**
+   * @brief Zwraca rozmiar macierzy.
+   * @return Liczba wierszy (i kolumn) macierzy.
+   */
+  int rozmiar(void) const { return size; }
+
+  /**
+   * @brief Zwraca wartość elementu na pozycji (x, y) bez zakładania blokad.
+   * @param x Wiersz.
+   * @param y Kolumna.
+   * @return Wartość elementu lub -1 przy indeksach poza zakresem.
+   */
+  int pokaz(int x, int y) const;
+
+  /**
+   * @brief Kopiuje spójny stan wiersza bez zakładania blokad.
+   * @param y Numer wiersza.
+   * @param t Tablica na co najmniej rozmiar() elementów.
+   */
+  void pokaz_wiersz(int y, int* t) const;
+
+  /**
+   * @brief Tworzy spójną migawkę całej macierzy.
+   *
+   * Migawka odpowiada stanowi macierzy z jednej chwili. Przy bardzo częstych zapisach,
+   * po kilku nieudanych próbach, bloki są na chwilę blokowane w ustalonej kolejności.
+   *
+   * @return Zwykła macierz z kopią danych.
+   */
+  Matrix migawka(void) const;
+
+  /**
+   * @brief Wstawia wartość na pozycji (x, y).
+   * @param x Wiersz.
+   * @param y Kolumna.
+   * @param wartosc Wstawiana wartość.
+   */
+  void wstaw(int x, int y, int wartosc);
+
+  /**
+   * @brief Wypełnia wskazany wiersz danymi z tabeli.
+   * @param y Numer wiersza.
+   * @param t Wskaźnik na tabelę z danymi.
+   */
+  void wiersz(int y, const int* t);
+
+private:
+  /**
+   * @brief Licznik wersji i blokada zapisu jednego bloku wierszy.
+   *
+   * Nieparzysta wersja oznacza trwający zapis.
+   */
+  struct alignas(64) Blok {
+    std::atomic<std::uint64_t> wersja{0}; /**< Licznik wersji bloku. */
+    std::mutex zapis;                     /**< Blokada szeregująca piszących. */
+  };
+
+  /**
+   * @brief Zwraca blok zawierający wiersz y.
+   * @param y Numer wiersza.
+   * @return Referencja do bloku.
+   */
+  Blok& blok(int y) const { return bloki[y / wiersze_w_bloku]; }
+
+  /**
+   * @brief Oczekuje na zakończenie zapisu i zwraca parzystą wersję bloku.
+   * @param b Blok wierszy.
+   * @return Wersja bloku w chwili rozpoczęcia odczytu.
+   */
+  static std::uint64_t poczatek_odczytu(const Blok& b);
+
+  /**
+   * @brief Kopiuje wiersze [y0, y1) do tablicy t, bez weryfikacji wersji.
+   */
+  void kopiuj_wiersze(int y0, int y1, int* t) const;
+
+  int size;                         /**< Rozmiar macierzy. */
+  int wiersze_w_bloku;              /**< Liczba wierszy w bloku. */
+  int liczba_blokow;                /**< Liczba bloków wierszy. */
+  std::unique_ptr<int[]> data;      /**< Dane macierzy zapisane wierszami. */
+  std::unique_ptr<Blok[]> bloki;    /**< Liczniki wersji kolejnych bloków. */
+};
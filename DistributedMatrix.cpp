@@ -0,0 +1,305 @@
+#include "DistributedMatrix.hpp"
+#include "Gemm.hpp"
+#include "Rownolegle.hpp"
+#include <algorithm> // dla funkcji copy() i min()
+using namespace std;
+
+namespace {
+
+/**
+ * @brief Liczy wiersze (lub kolumny) macierzy należące do jednego wiersza (kolumny) siatki.
+ *
+ * @param n Rozmiar macierzy.
+ * @param nb Rozmiar bloku.
+ * @param indeks Wiersz (kolumna) siatki.
+ * @param liczba Liczba wierszy (kolumn) siatki.
+ * @return Liczba lokalnych wierszy (kolumn).
+ */
+int liczba_lokalnych(int n, int nb, int indeks, int liczba) {
+    int wynik = 0;
+    for (long b = indeks; b * nb < n; b += liczba) {
+        wynik += static_cast<int>(min<long>(nb, n - b * nb));
+    }
+    return wynik;
+}
+
+/**
+ * @brief Zamienia lokalny indeks wiersza (kolumny) na globalny.
+ *
+ * @param l Indeks lokalny.
+ * @param nb Rozmiar bloku.
+ * @param indeks Wiersz (kolumna) siatki.
+ * @param liczba Liczba wierszy (kolumn) siatki.
+ * @return Indeks w całej macierzy.
+ */
+int globalny(int l, int nb, int indeks, int liczba) {
+    return ((l / nb) * liczba + indeks) * nb + l % nb;
+}
+
+} // namespace
+
+/**
+ * @brief Tworzy rozproszoną macierz n x n wypełnioną zerami.
+ *
+ * Siatka ma P wierszy, gdzie P jest największym dzielnikiem liczby rang nie
+ * większym od jej pierwiastka, więc dla 4 rang powstaje siatka 2 x 2, a dla 6 rang 2 x 3.
+ *
+ * @param transport Połączenie z pozostałymi rangami.
+ * @param n Rozmiar macierzy.
+ * @param blok Rozmiar bloku.
+ */
+DistributedMatrix::DistributedMatrix(Transport& transport, int n, int blok)
+    : transport(&transport), size(0), nb(1), p(1), q(1), moj_wiersz(0), moja_kolumna(0), wiersze(0), kolumny(0) {
+    if (n <= 0 || blok <= 0) {
+        cerr << "Rozmiar macierzy i bloku musi być większy od zera." << endl;
+        return;
+    }
+
+    const int rangi = transport.liczba_rang();
+    for (int d = 1; d * d <= rangi; ++d) {
+        if (rangi % d == 0) {
+            p = d;
+        }
+    }
+    q = rangi / p;
+
+    size = n;
+    nb = blok;
+    moj_wiersz = transport.ranga() / q;
+    moja_kolumna = transport.ranga() % q;
+    wiersze = liczba_lokalnych(n, nb, moj_wiersz, p);
+    kolumny = liczba_lokalnych(n, nb, moja_kolumna, q);
+    dane.assign(static_cast<long>(wiersze) * kolumny, 0);
+}
+
+/**
+ * @brief Zwraca rangę przechowującą element.
+ *
+ * @param x Wiersz.
+ * @param y Kolumna.
+ * @return Ranga właściciela.
+ */
+int DistributedMatrix::wlasciciel(int x, int y) const {
+    return ranga_w((x / nb) % p, (y / nb) % q);
+}
+
+/**
+ * @brief Wstawia wartość do lokalnego elementu.
+ *
+ * @param x Wiersz.
+ * @param y Kolumna.
+ * @param wartosc Nowa wartość.
+ */
+void DistributedMatrix::wstaw(int x, int y, int wartosc) {
+    if (x < 0 || x >= size || y < 0 || y >= size) {
+        cerr << "Indeksy poza zakresem. Indeksy muszą być w zakresie od 0 do " << size - 1 << "." << endl;
+        return;
+    }
+    if (!lokalny(x, y)) {
+        return;
+    }
+    const int lx = (x / nb / p) * nb + x % nb;
+    const int ly = (y / nb / q) * nb + y % nb;
+    dane[static_cast<long>(lx) * kolumny + ly] = wartosc;
+}
+
+/**
+ * @brief Zwraca lokalny element.
+ *
+ * @param x Wiersz.
+ * @param y Kolumna.
+ * @return Wartość elementu, 0 dla elementu innej rangi albo -1 dla indeksów poza zakresem.
+ */
+int DistributedMatrix::pokaz(int x, int y) const {
+    if (x < 0 || x >= size || y < 0 || y >= size) {
+        cerr << "Indeksy poza zakresem." << endl;
+        return -1;
+    }
+    if (!lokalny(x, y)) {
+        return 0;
+    }
+    const int lx = (x / nb / p) * nb + x % nb;
+    const int ly = (y / nb / q) * nb + y % nb;
+    return dane[static_cast<long>(lx) * kolumny + ly];
+}
+
+/**
+ * @brief Przepisuje lokalną część rangi między macierzą globalną a buforem.
+ *
+ * Kolumny jednego bloku leżą obok siebie w obu układach, więc wiersz lokalny
+ * kopiowany jest odcinkami długości bloku.
+ *
+ * @param r Ranga, której część jest przepisywana.
+ * @param zrodlo Elementy źródłowe.
+ * @param cel Elementy docelowe.
+ * @param do_globalnej Kierunek kopiowania.
+ */
+void DistributedMatrix::przepisz(int r, const int* zrodlo, int* cel, bool do_globalnej) const {
+    const int wr = r / q;
+    const int kr = r % q;
+    const int w = liczba_lokalnych(size, nb, wr, p);
+    const int k = liczba_lokalnych(size, nb, kr, q);
+
+    for (int lx = 0; lx < w; ++lx) {
+        const long gx = globalny(lx, nb, wr, p);
+        for (int ly = 0; ly < k; ly += nb) {
+            const long g = gx * size + globalny(ly, nb, kr, q);
+            const long l = static_cast<long>(lx) * k + ly;
+            const int dlugosc = min(nb, k - ly);
+            if (do_globalnej) {
+                copy(zrodlo + l, zrodlo + l + dlugosc, cel + g);
+            } else {
+                copy(zrodlo + g, zrodlo + g + dlugosc, cel + l);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Rozsyła macierz z rangi korzenia.
+ *
+ * Korzeń pakuje część każdej rangi do bufora i wysyła ją jednym komunikatem.
+ * Jeśli macierz w korzeniu ma zły rozmiar, rangi otrzymują zera, aby operacja
+ * zbiorowa zakończyła się we wszystkich procesach.
+ *
+ * @param m Macierz rozmiaru rozmiar().
+ * @param korzen Ranga, która posiada całą macierz.
+ * @return true, jeśli każda część została przekazana.
+ */
+bool DistributedMatrix::rozprosz(const Matrix& m, int korzen) {
+    const int ja = transport->ranga();
+    if (ja != korzen) {
+        return transport->odbierz(korzen, dane.data(), static_cast<long>(dane.size()) * sizeof(int));
+    }
+
+    bool ok = m.rozmiar() == size && m.dane() != nullptr;
+    if (!ok) {
+        cerr << "Macierz ma inny rozmiar niż macierz rozproszona." << endl;
+    }
+    vector<int> bufor;
+    for (int r = 0; r < transport->liczba_rang(); ++r) {
+        const long elementy = static_cast<long>(liczba_lokalnych(size, nb, r / q, p)) * liczba_lokalnych(size, nb, r % q, q);
+        bufor.assign(elementy, 0);
+        if (m.rozmiar() == size && m.dane() != nullptr) {
+            przepisz(r, m.dane(), bufor.data(), false);
+        }
+        if (r == ja) {
+            dane = bufor;
+        } else if (!transport->wyslij(r, bufor.data(), elementy * static_cast<long>(sizeof(int)))) {
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+/**
+ * @brief Zbiera całą macierz w randze korzenia.
+ *
+ * @param korzen Ranga, która otrzyma macierz.
+ * @return Cała macierz w korzeniu, niezaalokowana macierz w pozostałych rangach
+ *         oraz w korzeniu, gdy brakuje którejś części.
+ */
+Matrix DistributedMatrix::zbierz(int korzen) const {
+    const int ja = transport->ranga();
+    if (ja != korzen) {
+        if (!transport->wyslij(korzen, dane.data(), static_cast<long>(dane.size()) * sizeof(int))) {
+            cerr << "Nie można wysłać części macierzy do rangi " << korzen << "." << endl;
+        }
+        return Matrix();
+    }
+    if (size == 0) {
+        return Matrix();
+    }
+
+    Matrix m(size, bez_zerowania);
+    int* d = m.widok_zapisu().dane;
+    vector<int> bufor;
+    bool ok = kompletna; // Pozostałe części trzeba odebrać także po błędzie
+    for (int r = 0; r < transport->liczba_rang(); ++r) {
+        if (r == ja) {
+            przepisz(r, dane.data(), d, true);
+            continue;
+        }
+        const long elementy = static_cast<long>(liczba_lokalnych(size, nb, r / q, p)) * liczba_lokalnych(size, nb, r % q, q);
+        bufor.assign(elementy, 0);
+        if (!transport->odbierz(r, bufor.data(), elementy * static_cast<long>(sizeof(int)))) {
+            cerr << "Nie otrzymano części macierzy od rangi " << r << "." << endl;
+            ok = false;
+        }
+        przepisz(r, bufor.data(), d, true);
+    }
+    return ok ? m : Matrix();
+}
+
+/**
+ * @brief Mnoży macierze algorytmem SUMMA.
+ *
+ * W kroku k ranga z kolumną bloków k macierzy A rozsyła swój pasek wzdłuż wiersza
+ * siatki, a ranga z wierszem bloków k macierzy B wzdłuż kolumny siatki. Każda ranga
+ * dodaje iloczyn otrzymanych pasków do lokalnej części wyniku jądrem gemm. W każdej
+ * fazie rozsyłania grupa ma jednego nadawcę, więc komunikacja nie może się zakleszczyć.
+ * Pamięć dodatkowa to dwa paski szerokości bloku zamiast całych macierzy.
+ * Po błędzie komunikacji kroki są kontynuowane, aby pozostałe rangi nie czekały
+ * w nieskończoność, a wynik oznaczany jest jako niepoprawny.
+ *
+ * @param b Prawy czynnik.
+ * @return Iloczyn w tym samym układzie.
+ */
+DistributedMatrix DistributedMatrix::iloczyn(const DistributedMatrix& b) const {
+    DistributedMatrix c(*transport, size, nb);
+    if (b.size != size || b.nb != nb || b.transport != transport) {
+        cerr << "Macierze muszą mieć ten sam rozmiar, blok i transport." << endl;
+        c.kompletna = false;
+        return c;
+    }
+
+    vector<int> pasek_a(static_cast<long>(wiersze) * nb);
+    vector<int> pasek_b(static_cast<long>(nb) * kolumny);
+    const int bloki = (size + nb - 1) / nb;
+    for (int k = 0; k < bloki; ++k) {
+        const int kb = min(nb, size - k * nb);
+        const long bajty_a = static_cast<long>(wiersze) * kb * sizeof(int);
+        const long bajty_b = static_cast<long>(kb) * kolumny * sizeof(int);
+
+        const int nadawca_a = k % q;
+        if (moja_kolumna == nadawca_a) {
+            const int l0 = (k / q) * nb;
+            for (int x = 0; x < wiersze; ++x) {
+                const int* w = dane.data() + static_cast<long>(x) * kolumny + l0;
+                copy(w, w + kb, pasek_a.data() + static_cast<long>(x) * kb);
+            }
+            for (int j = 0; j < q; ++j) {
+                if (j != moja_kolumna && !transport->wyslij(ranga_w(moj_wiersz, j), pasek_a.data(), bajty_a)) {
+                    c.kompletna = false;
+                }
+            }
+        } else if (!transport->odbierz(ranga_w(moj_wiersz, nadawca_a), pasek_a.data(), bajty_a)) {
+            c.kompletna = false;
+        }
+
+        const int nadawca_b = k % p;
+        if (moj_wiersz == nadawca_b) {
+            const int* w = b.dane.data() + static_cast<long>((k / p) * nb) * kolumny;
+            copy(w, w + static_cast<long>(kb) * kolumny, pasek_b.data());
+            for (int i = 0; i < p; ++i) {
+                if (i != moj_wiersz && !transport->wyslij(ranga_w(i, moja_kolumna), pasek_b.data(), bajty_b)) {
+                    c.kompletna = false;
+                }
+            }
+        } else if (!transport->odbierz(ranga_w(nadawca_b, moja_kolumna), pasek_b.data(), bajty_b)) {
+            c.kompletna = false;
+        }
+
+        const int* pa = pasek_a.data();
+        const int* pb = pasek_b.data();
+        int* pc = c.dane.data();
+        const int n = kolumny;
+        rownolegle_wiersze(wiersze, static_cast<long>(kb) * n, [=](int y0, int y1) {
+            gemm(y1 - y0, n, kb, 1, pa + static_cast<long>(y0) * kb, kb, pb, n, pc + static_cast<long>(y0) * n, n);
+        });
+    }
+    if (!c.kompletna) {
+        cerr << "Komunikacja podczas mnożenia rozproszonego zawiodła." << endl;
+    }
+    return c;
+}
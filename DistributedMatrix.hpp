@@ -0,0 +1,162 @@
+#pragma once
+
+#include <vector>
+#include "Matrix.hpp"
+#include "Transport.hpp"
+
+/**
+ * @class DistributedMatrix
+ * @brief Macierz rozłożona blokowo-cyklicznie (2D) na siatkę procesów.
+ *
+ * Rangi tworzą siatkę P x Q (możliwie kwadratową), a macierz dzielona jest na bloki
+ * blok x blok. Blok (I, J) należy do rangi w wierszu siatki I mod P i kolumnie J mod Q,
+ * a każda ranga przechowuje swoje bloki w jednej gęstej macierzy lokalnej. Układ
+ * cykliczny równoważy obciążenie także wtedy, gdy liczba bloków nie dzieli się przez
+ * wymiary siatki.
+ *
+ * Wszystkie operacje poza dostępem do elementów lokalnych są zbiorowe: każda ranga
+ * musi je wywołać w tej samej kolejności z tymi samymi argumentami.
+ */
+class DistributedMatrix {
+public:
+  /**
+   * @brief Tworzy rozproszoną macierz n x n wypełnioną zerami.
+   * @param transport Połączenie z pozostałymi rangami (musi istnieć dłużej niż macierz).
+   * @param n Rozmiar macierzy.
+   * @param blok Rozmiar bloku układu blokowo-cyklicznego.
+   */
+  DistributedMatrix(Transport& transport, int n, int blok = 64);
+
+  /**
+   * @brief Zwraca rozmiar macierzy.
+   * @return Liczba wierszy (i kolumn) całej macierzy.
+   */
+  int rozmiar(void) const { return size; }
+
+  /**
+   * @brief Zwraca rozmiar bloku.
+   * @return Liczba wierszy (i kolumn) bloku.
+   */
+  int blok(void) const { return nb; }
+
+  /**
+   * @brief Zwraca liczbę wierszy siatki procesów.
+   * @return P.
+   */
+  int wiersze_siatki(void) const { return p; }
+
+  /**
+   * @brief Zwraca liczbę kolumn siatki procesów.
+   * @return Q.
+   */
+  int kolumny_siatki(void) const { return q; }
+
+  /**
+   * @brief Sprawdza, czy macierz została w pełni utworzona.
+   * @return false, jeśli przy jej wyznaczaniu (np. w iloczyn()) zawiodła komunikacja.
+   */
+  bool poprawna(void) const { return kompletna; }
+
+  /**
+   * @brief Zwraca rangę przechowującą element.
+   * @param x Wiersz.
+   * @param y Kolumna.
+   * @return Ranga właściciela.
+   */
+  int wlasciciel(int x, int y) const;
+
+  /**
+   * @brief Sprawdza, czy element przechowywany jest przez bieżącą rangę.
+   * @param x Wiersz.
+   * @param y Kolumna.
+   * @return true, jeśli element jest lokalny.
+   */
+  bool lokalny(int x, int y) const { return wlasciciel(x, y) == transport->ranga(); }
+
+  /**
+   * @brief Wstawia wartość do lokalnego elementu (wywołania dla cudzych elementów są ignorowane).
+   * @param x Wiersz.
+   * @param y Kolumna.
+   * @param wartosc Nowa wartość.
+   */
+  void wstaw(int x, int y, int wartosc);
+
+  /**
+   * @brief Zwraca lokalny element.
+   * @param x Wiersz.
+   * @param y Kolumna.
+   * @return Wartość elementu, 0 dla elementu innej rangi albo -1 dla indeksów poza zakresem.
+   */
+  int pokaz(int x, int y) const;
+
+  /**
+   * @brief Zwraca lokalną część macierzy.
+   * @return Bloki bieżącej rangi ułożone wierszami (wiersze_lokalne() x kolumny_lokalne()).
+   */
+  const std::vector<int>& lokalne(void) const { return dane; }
+
+  /**
+   * @brief Zwraca liczbę wierszy lokalnej części.
+   * @return Liczba wierszy macierzy należących do wiersza siatki bieżącej rangi.
+   */
+  int wiersze_lokalne(void) const { return wiersze; }
+
+  /**
+   * @brief Zwraca liczbę kolumn lokalnej części.
+   * @return Liczba kolumn macierzy należących do kolumny siatki bieżącej rangi.
+   */
+  int kolumny_lokalne(void) const { return kolumny; }
+
+  /**
+   * @brief Rozsyła macierz z rangi korzenia (operacja zbiorowa).
+   * @param m Macierz rozmiaru rozmiar() (znaczenie ma tylko w korzeniu).
+   * @param korzen Ranga, która posiada całą macierz.
+   * @return true, jeśli każda część została przekazana.
+   */
+  bool rozprosz(const Matrix& m, int korzen = 0);
+
+  /**
+   * @brief Zbiera całą macierz w randze korzenia (operacja zbiorowa).
+   * @param korzen Ranga, która otrzyma macierz.
+   * @return Cała macierz w korzeniu, niezaalokowana macierz w pozostałych rangach
+   *         i w korzeniu, gdy nie otrzymał którejś części.
+   */
+  Matrix zbierz(int korzen = 0) const;
+
+  /**
+   * @brief Mnoży macierze algorytmem SUMMA (operacja zbiorowa).
+   * @param b Prawy czynnik o tym samym rozmiarze, bloku i transporcie.
+   * @return Iloczyn w tym samym układzie (poprawna() == false, gdy komunikacja zawiodła).
+   */
+  DistributedMatrix iloczyn(const DistributedMatrix& b) const;
+
+private:
+  /**
+   * @brief Zwraca rangę w danym miejscu siatki.
+   * @param wiersz Wiersz siatki.
+   * @param kolumna Kolumna siatki.
+   * @return Ranga.
+   */
+  int ranga_w(int wiersz, int kolumna) const { return wiersz * q + kolumna; }
+
+  /**
+   * @brief Przepisuje lokalną część rangi między macierzą globalną a buforem.
+   * @param r Ranga, której część jest przepisywana.
+   * @param zrodlo Elementy źródłowe (cała macierz albo część lokalna).
+   * @param cel Elementy docelowe (część lokalna albo cała macierz).
+   * @param do_globalnej Kierunek: true kopiuje z części lokalnej do całej macierzy.
+   */
+  void przepisz(int r, const int* zrodlo, int* cel, bool do_globalnej) const;
+
+  Transport* transport;     /**< Połączenie z pozostałymi rangami. */
+  int size;                 /**< Rozmiar całej macierzy. */
+  int nb;                   /**< Rozmiar bloku. */
+  int p;                    /**< Liczba wierszy siatki procesów. */
+  int q;                    /**< Liczba kolumn siatki procesów. */
+  int moj_wiersz;           /**< Wiersz siatki bieżącej rangi. */
+  int moja_kolumna;         /**< Kolumna siatki bieżącej rangi. */
+  int wiersze;              /**< Liczba lokalnych wierszy. */
+  int kolumny;              /**< Liczba lokalnych kolumn. */
+  std::vector<int> dane;    /**< Lokalne bloki ułożone wierszami. */
+  bool kompletna = true;    /**< Czy wszystkie części zostały wyznaczone. */
+};
@@ -0,0 +1,214 @@
+#pragma once
+
+#include <array>
+#include <memory>
+#include "Matrix.hpp"
+
+/**
+ * @class FixedMatrix
+ * @brief Macierz N x N o rozmiarze znanym w czasie kompilacji, obliczana w kontekstach constexpr.
+ *
+ * Elementy przechowywane są wierszami w std::array, więc macierz nie alokuje pamięci
+ * i nie wypisuje komunikatów. Zmienna `static constexpr` tego typu (np. macierz
+ * jednostkowa albo tablica współczynników) jest wyznaczana przez kompilator i trafia
+ * do sekcji danych tylko do odczytu, nie kosztując nic przy starcie programu.
+ * widok() udostępnia ją jako zwykłą Matrix bez kopiowania elementów.
+ *
+ * Operacje odpowiadają metodom Matrix, ale zwracają nowe wartości zamiast
+ * modyfikować obiekt, co pozwala łączyć je w wyrażeniach stałych.
+ *
+ * @tparam N Rozmiar macierzy.
+ */
+template <int N>
+class FixedMatrix {
+  static_assert(N > 0, "Rozmiar macierzy musi być większy od zera");
+
+public:
+  /**
+   * @brief Tworzy macierz wypełnioną zerami.
+   */
+  constexpr FixedMatrix(void) : data{} {}
+
+  /**
+   * @brief Tworzy macierz z tablicy elementów ułożonych wierszami.
+   * @param t Tablica N * N elementów.
+   */
+  constexpr explicit FixedMatrix(const std::array<int, N * N>& t) : data(t) {}
+
+  /**
+   * @brief Tworzy macierz jednostkową.
+   * @return Macierz z jedynkami na przekątnej.
+   */
+  static constexpr FixedMatrix przekatna(void) {
+    return wypelnij([](int i, int j) { return i == j ? 1 : 0; });
+  }
+
+  /**
+   * @brief Tworzy macierz z jedynkami poniżej głównej przekątnej.
+   * @return Macierz trójkątna.
+   */
+  static constexpr FixedMatrix pod_przekatna(void) {
+    return wypelnij([](int i, int j) { return i > j ? 1 : 0; });
+  }
+
+  /**
+   * @brief Tworzy macierz z jedynkami powyżej głównej przekątnej.
+   * @return Macierz trójkątna.
+   */
+  static constexpr FixedMatrix nad_przekatna(void) {
+    return wypelnij([](int i, int j) { return i < j ? 1 : 0; });
+  }
+
+  /**
+   * @brief Tworzy szachownicę z zerem w lewym górnym rogu.
+   * @return Macierz z naprzemiennymi zerami i jedynkami.
+   */
+  static constexpr FixedMatrix szachownica(void) {
+    return wypelnij([](int i, int j) { return (i + j) % 2 == 0 ? 0 : 1; });
+  }
+
+  /**
+   * @brief Zwraca rozmiar macierzy.
+   * @return N.
+   */
+  static constexpr int rozmiar(void) { return N; }
+
+  /**
+   * @brief Zwraca element macierzy.
+   * @param x Wiersz.
+   * @param y Kolumna.
+   * @return Wartość elementu albo -1 dla indeksów poza zakresem.
+   */
+  constexpr int pokaz(int x, int y) const {
+    if (x < 0 || x >= N || y < 0 || y >= N) {
+      return -1;
+    }
+    return data[x * N + y];
+  }
+
+  /**
+   * @brief Wstawia wartość do macierzy (indeksy poza zakresem są ignorowane).
+   * @param x Wiersz.
+   * @param y Kolumna.
+   * @param wartosc Nowa wartość.
+   */
+  constexpr void wstaw(int x, int y, int wartosc) {
+    if (x >= 0 && x < N && y >= 0 && y < N) {
+      data[x * N + y] = wartosc;
+    }
+  }
+
+  /**
+   * @brief Zwraca elementy macierzy.
+   * @return Tablica N * N elementów ułożonych wierszami.
+   */
+  constexpr const std::array<int, N * N>& elementy(void) const { return data; }
+
+  /**
+   * @brief Mnoży macierze.
+   * @param m Prawy czynnik.
+   * @return Iloczyn (przepełnienie w wyrażeniu stałym jest błędem kompilacji).
+   */
+  constexpr FixedMatrix operator*(const FixedMatrix& m) const {
+    FixedMatrix wynik;
+    for (int i = 0; i < N; ++i) {
+      for (int k = 0; k < N; ++k) {
+        const int a = data[i * N + k];
+        for (int j = 0; j < N; ++j) {
+          wynik.data[i * N + j] += a * m.data[k * N + j];
+        }
+      }
+    }
+    return wynik;
+  }
+
+  /**
+   * @brief Dodaje macierze element po elemencie.
+   * @param m Drugi składnik.
+   * @return Suma.
+   */
+  constexpr FixedMatrix operator+(const FixedMatrix& m) const {
+    FixedMatrix wynik;
+    for (int i = 0; i < N * N; ++i) {
+      wynik.data[i] = data[i] + m.data[i];
+    }
+    return wynik;
+  }
+
+  /**
+   * @brief Zwraca macierz transponowaną.
+   * @return Transpozycja.
+   */
+  constexpr FixedMatrix dowroc(void) const {
+    FixedMatrix wynik;
+    for (int i = 0; i < N; ++i) {
+      for (int j = 0; j < N; ++j) {
+        wynik.data[j * N + i] = data[i * N + j];
+      }
+    }
+    return wynik;
+  }
+
+  /**
+   * @brief Podnosi macierz do potęgi szybkim potęgowaniem.
+   * @param k Wykładnik (dla ujemnego zwracana jest niezmieniona macierz).
+   * @return Potęga macierzy (jednostkowa dla k = 0).
+   */
+  constexpr FixedMatrix potega(int k) const {
+    if (k < 0) {
+      return *this;
+    }
+    FixedMatrix wynik = przekatna();
+    FixedMatrix baza = *this;
+    while (k > 0) {
+      if (k & 1) {
+        wynik = wynik * baza;
+      }
+      k >>= 1;
+      if (k > 0) {
+        baza = baza * baza;
+      }
+    }
+    return wynik;
+  }
+
+  /**
+   * @brief Porównuje macierze element po elemencie.
+   * @param m Druga macierz.
+   * @return true, jeśli wszystkie elementy są równe.
+   */
+  constexpr bool operator==(const FixedMatrix& m) const { return data == m.data; }
+
+  /**
+   * @brief Udostępnia elementy jako Matrix bez ich kopiowania.
+   *
+   * Widok nie przejmuje pamięci, więc nie może istnieć dłużej niż bieżący obiekt;
+   * dla zmiennych `static constexpr` warunek ten jest zawsze spełniony. Modyfikacja
+   * widoku najpierw kopiuje elementy do własnego bufora.
+   *
+   * @return Macierz N x N korzystająca z elementów bieżącego obiektu.
+   */
+  Matrix widok(void) const {
+    // Pusty deleter: Matrix tylko sprawdza obecność właściciela, aby nie zwalniać bufora
+    return Matrix(N, data.data(), std::shared_ptr<void>(const_cast<int*>(data.data()), [](void*) {}));
+  }
+
+private:
+  /**
+   * @brief Tworzy macierz z wartości zwracanych przez funkcję pozycji.
+   * @param f Funkcja (wiersz, kolumna) -> wartość.
+   * @return Wypełniona macierz.
+   */
+  template <typename F>
+  static constexpr FixedMatrix wypelnij(F f) {
+    FixedMatrix wynik;
+    for (int i = 0; i < N; ++i) {
+      for (int j = 0; j < N; ++j) {
+        wynik.data[i * N + j] = f(i, j);
+      }
+    }
+    return wynik;
+  }
+
+  std::array<int, N * N> data; /**< Elementy macierzy ułożone wierszami. */
+};
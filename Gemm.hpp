@@ -0,0 +1,104 @@
+#pragma once
+
+#include <atomic>
+
+/**
+ * @file Gemm.hpp
+ * @brief Blokowe jądro mnożenia macierzy (GEMM) wspólne dla klasy Matrix i rozkładów.
+ *
+ * Macierze przechowywane są wierszami, a każdy operand opisany jest wskaźnikiem
+ * na pierwszy element oraz odstępem między kolejnymi wierszami (ld).
+ */
+
+/**
+ * @brief Domyślne rozmiary bloków używane przez jądro gemm.
+ */
+namespace gemm_bloki {
+  constexpr int BLOK_I = 64;  /**< Liczba wierszy wyniku w bloku. */
+  constexpr int BLOK_K = 256; /**< Długość bloku wymiaru sumowania. */
+  constexpr int BLOK_J = 512; /**< Liczba kolumn wyniku w bloku. */
+
+  inline std::atomic<int> blok_i{BLOK_I}; /**< Bieżąca liczba wierszy w bloku. */
+  inline std::atomic<int> blok_k{BLOK_K}; /**< Bieżąca długość bloku wymiaru sumowania. */
+  inline std::atomic<int> blok_j{BLOK_J}; /**< Bieżąca liczba kolumn w bloku. */
+}
+
+/**
+ * @brief Zestaw rozmiarów bloków jądra gemm.
+ */
+struct BlokiGemm {
+  int i = gemm_bloki::BLOK_I; /**< Liczba wierszy wyniku w bloku. */
+  int k = gemm_bloki::BLOK_K; /**< Długość bloku wymiaru sumowania. */
+  int j = gemm_bloki::BLOK_J; /**< Liczba kolumn wyniku w bloku. */
+};
+
+/**
+ * @brief Zwraca rozmiary bloków używane domyślnie przez gemm (np. wczytane z profilu strojenia).
+ * @return Bieżące rozmiary bloków.
+ */
+inline BlokiGemm bloki_gemm(void) {
+  return {gemm_bloki::blok_i.load(std::memory_order_relaxed), gemm_bloki::blok_k.load(std::memory_order_relaxed),
+          gemm_bloki::blok_j.load(std::memory_order_relaxed)};
+}
+
+/**
+ * @brief Ustawia rozmiary bloków używane domyślnie przez gemm.
+ * @param b Nowe rozmiary (wartości niedodatnie są ignorowane).
+ */
+inline void ustaw_bloki_gemm(BlokiGemm b) {
+  if (b.i > 0 && b.k > 0 && b.j > 0) {
+    gemm_bloki::blok_i.store(b.i, std::memory_order_relaxed);
+    gemm_bloki::blok_k.store(b.k, std::memory_order_relaxed);
+    gemm_bloki::blok_j.store(b.j, std::memory_order_relaxed);
+  }
+}
+
+/**
+ * @brief Wykonuje operację C += alfa * A * B na blokach mieszczących się w pamięci podręcznej.
+ *
+ * Pętla najgłębsza przebiega po kolejnych kolumnach wiersza B i C,
+ * dzięki czemu kompilator może ją zwektoryzować.
+ *
+ * @param m Liczba wierszy A i C.
+ * @param n Liczba kolumn B i C.
+ * @param k Liczba kolumn A i wierszy B.
+ * @param alfa Współczynnik mnożący iloczyn.
+ * @param a Wskaźnik na macierz A.
+ * @param lda Odstęp między wierszami A.
+ * @param b Wskaźnik na macierz B.
+ * @param ldb Odstęp między wierszami B.
+ * @param c Wskaźnik na macierz wynikową C.
+ * @param ldc Odstęp między wierszami C.
+ * @param bloki Rozmiary bloków (domyślnie bieżące ustawienia bloki_gemm()).
+ */
+template <typename T>
+void gemm(int m, int n, int k, T alfa, const T* a, int lda, const T* b, int ldb, T* c, int ldc,
+          BlokiGemm bloki = bloki_gemm()) {
+  const int BLOK_I = bloki.i;
+  const int BLOK_K = bloki.k;
+  const int BLOK_J = bloki.j;
+
+  for (int ii = 0; ii < m; ii += BLOK_I) {
+    int ik = ii + BLOK_I < m ? ii + BLOK_I : m;
+    for (int kk = 0; kk < k; kk += BLOK_K) {
+      int kl = kk + BLOK_K < k ? kk + BLOK_K : k;
+      for (int jj = 0; jj < n; jj += BLOK_J) {
+        int jk = jj + BLOK_J < n ? jj + BLOK_J : n;
+
+        for (int i = ii; i < ik; ++i) {
+          T* ci = c + static_cast<long>(i) * ldc;
+          for (int p = kk; p < kl; ++p) {
+            T aip = alfa * a[static_cast<long>(i) * lda + p];
+            if (aip == T(0)) {
+              continue; // Zerowe elementy A nie wnoszą nic do wyniku
+            }
+            const T* bp = b + static_cast<long>(p) * ldb;
+            for (int j = jj; j < jk; ++j) {
+              ci[j] += aip * bp[j];
+            }
+          }
+        }
+      }
+    }
+  }
+}
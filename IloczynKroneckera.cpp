@@ -0,0 +1,67 @@
+#include "IloczynKroneckera.hpp"
+#include "Rownolegle.hpp"
+using namespace std;
+
+/**
+ * @brief Tworzy operator A ⊗ B.
+ *
+ * @param a Lewy czynnik.
+ * @param b Prawy czynnik.
+ */
+IloczynKroneckera::IloczynKroneckera(const Matrix& a, const Matrix& b) : a(a), b(b) {}
+
+/**
+ * @brief Mnoży operator przez wektor bez tworzenia macierzy A ⊗ B.
+ *
+ * Najpierw liczone jest T = X * B^T (iloczyny skalarne ciągłych wierszy X i B),
+ * a następnie Y = A * T (sumy wierszy T przemnożonych przez elementy A).
+ * Obie pętle wewnętrzne przechodzą pamięć sekwencyjnie i wektoryzują się.
+ *
+ * @param x Wektor o długości na * nb.
+ * @return Wektor (A ⊗ B) x.
+ */
+vector<double> IloczynKroneckera::razy(const vector<double>& x) const {
+    const int na = a.rozmiar();
+    const int nb = b.rozmiar();
+    if (static_cast<long>(x.size()) != rozmiar() || rozmiar() == 0) {
+        cerr << "Wektor ma niewłaściwą długość, nie można go pomnożyć." << endl;
+        return {};
+    }
+
+    const int* pa = a.dane();
+    const int* pb = b.dane();
+    vector<double> t(x.size());
+    rownolegle_wiersze(na, static_cast<long>(nb) * nb, [&](int j0, int j1) {
+        for (int j = j0; j < j1; ++j) {
+            const double* xj = x.data() + static_cast<long>(j) * nb;
+            double* tj = t.data() + static_cast<long>(j) * nb;
+            for (int k = 0; k < nb; ++k) {
+                const int* bk = pb + static_cast<long>(k) * nb;
+                double s = 0;
+                for (int l = 0; l < nb; ++l) {
+                    s += xj[l] * bk[l];
+                }
+                tj[k] = s;
+            }
+        }
+    });
+
+    vector<double> y(x.size(), 0.0);
+    rownolegle_wiersze(na, static_cast<long>(na) * nb, [&](int i0, int i1) {
+        for (int i = i0; i < i1; ++i) {
+            const int* ai = pa + static_cast<long>(i) * na;
+            double* yi = y.data() + static_cast<long>(i) * nb;
+            for (int j = 0; j < na; ++j) {
+                const double aij = ai[j];
+                if (aij == 0) {
+                    continue;
+                }
+                const double* tj = t.data() + static_cast<long>(j) * nb;
+                for (int k = 0; k < nb; ++k) {
+                    yi[k] += aij * tj[k];
+                }
+            }
+        }
+    });
+    return y;
+}
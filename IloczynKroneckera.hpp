@@ -0,0 +1,46 @@
+#pragma once
+
+#include <vector>
+#include "Matrix.hpp"
+
+/**
+ * @class IloczynKroneckera
+ * @brief Niejawny iloczyn Kroneckera A ⊗ B używany jako operator liniowy.
+ *
+ * Macierz A ⊗ B ma (na * nb)^2 elementów, ale mnożenie jej przez wektor nie wymaga
+ * ich tworzenia: jeśli wektor x zapisać jako macierz X o wymiarach na x nb
+ * (x[j * nb + l] = X(j, l)), to (A ⊗ B) x odpowiada macierzy A * X * B^T.
+ * Koszt spada z (na * nb)^2 do na * nb * (na + nb) mnożeń, a pamięć do rozmiaru wektora.
+ */
+class IloczynKroneckera {
+public:
+  /**
+   * @brief Tworzy operator A ⊗ B.
+   * @param a Lewy czynnik (kopiowany bez kopiowania elementów).
+   * @param b Prawy czynnik (kopiowany bez kopiowania elementów).
+   */
+  IloczynKroneckera(const Matrix& a, const Matrix& b);
+
+  /**
+   * @brief Zwraca rozmiar operatora.
+   * @return Liczba wierszy (i kolumn) macierzy A ⊗ B.
+   */
+  long rozmiar(void) const { return static_cast<long>(a.rozmiar()) * b.rozmiar(); }
+
+  /**
+   * @brief Mnoży operator przez wektor.
+   * @param x Wektor o długości rozmiar().
+   * @return Wektor (A ⊗ B) x albo pusty wektor, gdy długość x jest niewłaściwa.
+   */
+  std::vector<double> razy(const std::vector<double>& x) const;
+
+  /**
+   * @brief Tworzy jawną macierz A ⊗ B.
+   * @return Macierz z Matrix::kronecker().
+   */
+  Matrix materializuj(void) const { return a.kronecker(b); }
+
+private:
+  Matrix a;  /**< Lewy czynnik. */
+  Matrix b;  /**< Prawy czynnik. */
+};
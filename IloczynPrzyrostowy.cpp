@@ -0,0 +1,189 @@
+#include "IloczynPrzyrostowy.hpp"
+#include "Gemm.hpp"
+#include "Rownolegle.hpp"
+#include <algorithm> // dla funkcji fill() i min()
+using namespace std;
+
+namespace {
+
+/**
+ * @brief Pakuje wskazane kolumny macierzy n x n (opcjonalnie pomniejszone o kolumny drugiej macierzy).
+ *
+ * @param m Macierz źródłowa.
+ * @param odjemnik Macierz odejmowana albo nullptr.
+ * @param n Rozmiar macierzy.
+ * @param kolumny Numery kolumn.
+ * @return Macierz n x k przechowywana wierszami.
+ */
+vector<int> pakuj_kolumny(const int* m, const int* odjemnik, int n, const vector<int>& kolumny) {
+    long k = static_cast<long>(kolumny.size());
+    vector<int> p(n * k);
+    for (long i = 0; i < n; ++i) {
+        for (long c = 0; c < k; ++c) {
+            long z = i * n + kolumny[c];
+            p[i * k + c] = odjemnik != nullptr ? m[z] - odjemnik[z] : m[z];
+        }
+    }
+    return p;
+}
+
+/**
+ * @brief Pakuje wskazane wiersze macierzy n x n (opcjonalnie pomniejszone o wiersze drugiej macierzy).
+ *
+ * @param m Macierz źródłowa.
+ * @param odjemnik Macierz odejmowana albo nullptr.
+ * @param n Rozmiar macierzy.
+ * @param wiersze Numery wierszy.
+ * @return Macierz k x n przechowywana wierszami.
+ */
+vector<int> pakuj_wiersze(const int* m, const int* odjemnik, int n, const vector<int>& wiersze) {
+    long k = static_cast<long>(wiersze.size());
+    vector<int> p(k * n);
+    for (long r = 0; r < k; ++r) {
+        const int* w = m + static_cast<long>(wiersze[r]) * n;
+        const int* o = odjemnik != nullptr ? odjemnik + static_cast<long>(wiersze[r]) * n : nullptr;
+        for (long j = 0; j < n; ++j) {
+            p[r * n + j] = o != nullptr ? w[j] - o[j] : w[j];
+        }
+    }
+    return p;
+}
+
+/**
+ * @brief Wykonuje poprawkę rzędu k: C += P * D.
+ *
+ * @param n Rozmiar C.
+ * @param k Rząd poprawki.
+ * @param p Macierz n x k.
+ * @param d Macierz k x n.
+ * @param c Macierz wynikowa n x n.
+ */
+void popraw_rzedem(int n, int k, const int* p, const int* d, int* c) {
+    rownolegle_wiersze(n, static_cast<long>(n) * k, [&](int y0, int y1) {
+        gemm(y1 - y0, n, k, 1, p + static_cast<long>(y0) * k, k, d, n, c + static_cast<long>(y0) * n, n);
+    });
+}
+
+} // namespace
+
+/**
+ * @brief Oblicza iloczyn i włącza śledzenie zmian czynników.
+ *
+ * @param a Lewy czynnik.
+ * @param b Prawy czynnik.
+ */
+IloczynPrzyrostowy::IloczynPrzyrostowy(Matrix& a, Matrix& b) : a(&a), b(&b), wersja_a(0), wersja_b(0), poprawka(0) {
+    a.sledz_zmiany();
+    b.sledz_zmiany();
+    przelicz_calosc();
+}
+
+/**
+ * @brief Liczy iloczyn od nowa.
+ */
+void IloczynPrzyrostowy::przelicz_calosc(void) {
+    if (a->size != b->size) {
+        cerr << "Macierze mają różne rozmiary, nie można ich pomnożyć." << endl;
+        c = Matrix();
+    } else {
+        Matrix t(*a);
+        t * *b;
+        c = move(t);
+    }
+    poprawka = c.size;
+    zapamietaj_stan();
+}
+
+/**
+ * @brief Zapamiętuje kopie czynników (bez kopiowania elementów) i ich wersje.
+ */
+void IloczynPrzyrostowy::zapamietaj_stan(void) {
+    stara_a = *a;
+    stara_b = *b;
+    wersja_a = a->wersja();
+    wersja_b = b->wersja();
+}
+
+/**
+ * @brief Uwzględnia zmiany czynników od ostatniego obliczenia.
+ *
+ * Najpierw uwzględniane są zmiany B przy starym A (C = A0 * B1), a następnie
+ * zmiany A przy nowym B (C = A1 * B1). Dla każdego czynnika wybierany jest
+ * tańszy z dwóch wariantów: według wierszy albo według kolumn. Jeśli łączny
+ * rząd poprawek przekracza połowę rozmiaru, iloczyn liczony jest od nowa.
+ *
+ * @return Aktualny iloczyn.
+ */
+const Matrix& IloczynPrzyrostowy::aktualizuj(void) {
+    const int n = c.size;
+    if (n == 0 || a->size != n || b->size != n || stara_a.size != n || stara_b.size != n) {
+        przelicz_calosc();
+        return c;
+    }
+
+    vector<int> wiersze_a = a->zmienione_wiersze(wersja_a);
+    vector<int> kolumny_a = a->zmienione_kolumny(wersja_a);
+    vector<int> wiersze_b = b->zmienione_wiersze(wersja_b);
+    vector<int> kolumny_b = b->zmienione_kolumny(wersja_b);
+    if (wiersze_a.empty() && wiersze_b.empty()) {
+        poprawka = 0;
+        return c;
+    }
+
+    size_t ka = min(wiersze_a.size(), kolumny_a.size());
+    size_t kb = min(wiersze_b.size(), kolumny_b.size());
+    if (2 * (ka + kb) >= static_cast<size_t>(n)) {
+        przelicz_calosc();
+        return c;
+    }
+
+    c.odlacz(); // Kopie wcześniejszego wyniku zachowują stare wartości
+    c.zmieniono();
+    const int* a0 = stara_a.data;
+    const int* a1 = a->data;
+    const int* b0 = stara_b.data;
+    const int* b1 = b->data;
+    int* w = c.data;
+
+    if (kb > 0 && wiersze_b.size() <= kolumny_b.size()) {
+        // C += A0[:, K] * (B1[K, :] - B0[K, :])
+        vector<int> p = pakuj_kolumny(a0, nullptr, n, wiersze_b);
+        vector<int> d = pakuj_wiersze(b1, b0, n, wiersze_b);
+        popraw_rzedem(n, static_cast<int>(kb), p.data(), d.data(), w);
+    } else if (kb > 0) {
+        // C[:, J] = A0 * B1[:, J]
+        int k = static_cast<int>(kb);
+        vector<int> p = pakuj_kolumny(b1, nullptr, n, kolumny_b);
+        vector<int> t(static_cast<long>(n) * k, 0);
+        rownolegle_wiersze(n, static_cast<long>(n) * k, [&](int y0, int y1) {
+            gemm(y1 - y0, k, n, 1, a0 + static_cast<long>(y0) * n, n, p.data(), k, t.data() + static_cast<long>(y0) * k, k);
+            for (long i = y0; i < y1; ++i) {
+                for (int j = 0; j < k; ++j) {
+                    w[i * n + kolumny_b[j]] = t[i * k + j];
+                }
+            }
+        });
+    }
+
+    if (ka > 0 && wiersze_a.size() <= kolumny_a.size()) {
+        // C[R, :] = A1[R, :] * B1
+        int k = static_cast<int>(ka);
+        vector<int> p = pakuj_wiersze(a1, nullptr, n, wiersze_a);
+        rownolegle_wiersze(k, static_cast<long>(n) * n, [&](int r0, int r1) {
+            for (int r = r0; r < r1; ++r) {
+                int* wiersz = w + static_cast<long>(wiersze_a[r]) * n;
+                fill(wiersz, wiersz + n, 0);
+                gemm(1, n, n, 1, p.data() + static_cast<long>(r) * n, n, b1, n, wiersz, n);
+            }
+        });
+    } else if (ka > 0) {
+        // C += (A1[:, Q] - A0[:, Q]) * B1[Q, :]
+        vector<int> p = pakuj_kolumny(a1, a0, n, kolumny_a);
+        vector<int> d = pakuj_wiersze(b1, nullptr, n, kolumny_a);
+        popraw_rzedem(n, static_cast<int>(ka), p.data(), d.data(), w);
+    }
+
+    poprawka = static_cast<int>(ka + kb);
+    zapamietaj_stan();
+    return c;
+}
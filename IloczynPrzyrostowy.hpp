@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "Matrix.hpp"
+
+/**
+ * @class IloczynPrzyrostowy
+ * @brief Iloczyn C = A * B aktualizowany po zmianach czynników bez pełnego przeliczania.
+ *
+ * Obiekt włącza śledzenie zmian w obu czynnikach i pamięta ich kopie z chwili ostatniego
+ * obliczenia (dzięki kopiowaniu przy zapisie kopia zachowuje stare wartości dopiero wtedy,
+ * gdy czynnik zostanie zmieniony). Przy aktualizacji:
+ * - k zmienionych wierszy A oznacza przeliczenie tylko tych k wierszy C,
+ * - k zmienionych kolumn A (lub wierszy B) oznacza poprawkę rzędu k: C += dA * B,
+ * - k zmienionych kolumn B oznacza przeliczenie tylko tych k kolumn C,
+ * więc koszt wynosi O(k * n^2) zamiast O(n^3). Zmiany zapisują tylko operacje zapisu
+ * (element(), wstaw(), widoki do zapisu), więc odczyt czynników, także przez niestałą
+ * referencję, nie wymusza przeliczenia.
+ *
+ * Czynniki muszą istnieć co najmniej tak długo jak obiekt.
+ */
+class IloczynPrzyrostowy {
+public:
+  /**
+   * @brief Oblicza iloczyn a * b i zaczyna śledzić zmiany czynników.
+   * @param a Lewy czynnik.
+   * @param b Prawy czynnik.
+   */
+  IloczynPrzyrostowy(Matrix& a, Matrix& b);
+
+  IloczynPrzyrostowy(const IloczynPrzyrostowy&) = delete;
+  IloczynPrzyrostowy& operator=(const IloczynPrzyrostowy&) = delete;
+
+  /**
+   * @brief Uwzględnia zmiany czynników od ostatniego obliczenia i zwraca iloczyn.
+   * @return Aktualny iloczyn A * B.
+   */
+  const Matrix& aktualizuj(void);
+
+  /**
+   * @brief Zwraca iloczyn z ostatniego obliczenia (bez uwzględniania nowych zmian).
+   * @return Iloczyn.
+   */
+  const Matrix& wynik(void) const { return c; }
+
+  /**
+   * @brief Zwraca liczbę wierszy lub kolumn przeliczonych przy ostatniej aktualizacji.
+   * @return Rząd ostatniej poprawki (rozmiar macierzy przy pełnym przeliczeniu).
+   */
+  int ostatnia_poprawka(void) const { return poprawka; }
+
+private:
+  /**
+   * @brief Liczy iloczyn od nowa i zapamiętuje stan czynników.
+   */
+  void przelicz_calosc(void);
+
+  /**
+   * @brief Zapamiętuje kopie czynników i ich wersje po obliczeniu.
+   */
+  void zapamietaj_stan(void);
+
+  Matrix* a;            /**< Lewy czynnik. */
+  Matrix* b;            /**< Prawy czynnik. */
+  Matrix stara_a;       /**< Lewy czynnik z chwili ostatniego obliczenia. */
+  Matrix stara_b;       /**< Prawy czynnik z chwili ostatniego obliczenia. */
+  Matrix c;             /**< Iloczyn. */
+  uint64_t wersja_a;    /**< Wersja A uwzględniona w iloczynie. */
+  uint64_t wersja_b;    /**< Wersja B uwzględniona w iloczynie. */
+  int poprawka;         /**< Rząd ostatniej poprawki. */
+};
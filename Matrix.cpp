@@ -1,8 +1,21 @@
 #include "Matrix.hpp"
+#include "Gemm.hpp"
+#include "PatternMatrix.hpp"
+#include "TriangularMatrix.hpp"
+#include "Rownolegle.hpp"
+#include "Strojenie.hpp"
+#include "PamiecIloczynow.hpp"
+#include "Polpierscien.hpp"
+#include "Permutation.hpp"
 #include <iostream>
 #include <cstdlib>  // dla funkcji rand()
 #include <ctime>    // dla funkcji time()
-#include <algorithm> // dla funkcji copy_n
+#include <algorithm> // dla funkcji copy_n, copy_backward, find() i max_element()
+#include <bit>       // dla funkcji rotl()
+#include <cmath>     // dla funkcji sqrt()
+#include <limits>
+#include <mutex>
+#include <vector>
 using namespace std;
 
 /**
@@ -11,7 +24,7 @@ using namespace std;
  * Ustawia wskaźnik danych na nullptr i rozmiar macierzy na 0.
  * Nie alokuje pamięci dla macierzy.
  */
-Matrix::Matrix() : data(nullptr), size(0) {
+Matrix::Matrix() : mag(nullptr), data(nullptr), size(0), zmiany(nullptr) {
     cout << "Domyślny konstruktor wywołany. Macierz nie została zaalokowana." << endl;
 }
 
@@ -23,22 +36,65 @@ Matrix::Matrix() : data(nullptr), size(0) {
  *
  * @param n Rozmiar macierzy (liczba wierszy i kolumn).
  */
-Matrix::Matrix(int n) : data(nullptr), size(0) {
+Matrix::Matrix(int n) : mag(nullptr), data(nullptr), size(0), zmiany(nullptr) {
     if (n <= 0) {
         cout << "Rozmiar macierzy musi być większy od zera. Macierz nie została zaalokowana." << endl;
         return;
     }
 
     size = n;
-    data = new int[size * size];
-    for (int i = 0; i < size * size; ++i) {
-        data[i] = 0; // Inicjalizacja elementów macierzy zerami
-    }
+    mag = nowy_magazyn(size, true); // Zera pochodzą z calloc() lub ze stron zerowych mmap
+    data = mag->dane;
 
     cout << "Konstruktor alokujący wywołany. Macierz o rozmiarze "
          << size << " x " << size << " została zaalokowana." << endl;
 }
 
+/**
+ * @brief Konstruktor alokujący macierz bez zerowania elementów.
+ *
+ * Przeznaczony dla wyników, które zostaną w całości nadpisane.
+ *
+ * @param n Rozmiar macierzy (liczba wierszy i kolumn).
+ */
+Matrix::Matrix(int n, BezZerowania) : mag(nullptr), data(nullptr), size(0), zmiany(nullptr) {
+    if (n <= 0) {
+        cout << "Rozmiar macierzy musi być większy od zera. Macierz nie została zaalokowana." << endl;
+        return;
+    }
+
+    size = n;
+    mag = nowy_magazyn(size, false);
+    data = mag->dane;
+
+    cout << "Konstruktor alokujący wywołany. Macierz o rozmiarze "
+         << size << " x " << size << " została zaalokowana bez zerowania." << endl;
+}
+
+/**
+ * @brief Konstruktor macierzy korzystającej z cudzego bufora.
+ *
+ * @param n Rozmiar macierzy.
+ * @param dane Elementy macierzy.
+ * @param wlasciciel Obiekt utrzymujący bufor przy życiu.
+ */
+Matrix::Matrix(int n, const int* dane, shared_ptr<void> wlasciciel)
+    : mag(nullptr), data(nullptr), size(0), zmiany(nullptr) {
+    if (n <= 0 || dane == nullptr) {
+        return;
+    }
+
+    size = n;
+    mag = new Magazyn;
+    mag->licznik.store(1, memory_order_relaxed);
+    mag->skrot.store(0, memory_order_relaxed);
+    mag->pojemnosc = static_cast<long>(n) * n;
+    mag->dane = const_cast<int*>(dane); // Zapis zawsze poprzedza skopiowanie (odlacz())
+    mag->mapowany = false;
+    mag->wlasciciel = move(wlasciciel);
+    data = mag->dane;
+}
+
 /**
  * @brief Konstruktor alokujący macierz o wymiarach n x n i kopiujący dane z tabeli.
  *
@@ -49,7 +105,7 @@ Matrix::Matrix(int n) : data(nullptr), size(0) {
  *          Tablica powinna zawierać co najmniej n * n elementów.
  */
 
-Matrix::Matrix(int n, int* t) : data(nullptr), size(0) {
+Matrix::Matrix(int n, int* t) : mag(nullptr), data(nullptr), size(0), zmiany(nullptr) {
     if (n <= 0) {
         cout << "Rozmiar macierzy musi być większy od zera. Macierz nie została zaalokowana." << endl;
         return;
@@ -61,7 +117,8 @@ Matrix::Matrix(int n, int* t) : data(nullptr), size(0) {
     }
 
     size = n;
-    data = new int[size * size];
+    mag = nowy_magazyn(size, false);
+    data = mag->dane;
     for (int i = 0; i < size * size; ++i) {
         data[i] = t[i]; // Kopiowanie danych z tablicy t
     }
@@ -74,41 +131,115 @@ Matrix::Matrix(int n, int* t) : data(nullptr), size(0) {
  * @brief Konstruktor kopiujący klasy Matrix.
  *
  * Tworzy nową macierz, która jest kopią innej macierzy.
- * Alokuje pamięć dla nowej macierzy i kopiuje wartości z macierzy źródłowej.
+ * Dane nie są kopiowane: obie macierze współdzielą bufor, a prywatna kopia
+ * powstaje dopiero przy pierwszej modyfikacji jednej z nich (kopiowanie przy zapisie).
  *
  * @param m Macierz, która ma zostać skopiowana.
  */
-Matrix::Matrix(Matrix& m) : data(nullptr), size(0) {
-    // Kopiowanie rozmiaru macierzy
-    size = m.size;
-
-    // Alokacja pamięci dla nowej macierzy
-    data = new int[size * size];
-
-    // Kopiowanie danych z macierzy źródłowej
-    for (int i = 0; i < size * size; ++i) {
-        data[i] = m.data[i]; // Kopiowanie każdego elementu z m
+Matrix::Matrix(const Matrix& m) : mag(m.mag), data(m.data), size(m.size), zmiany(nullptr) {
+    if (mag != nullptr) {
+        mag->licznik.fetch_add(1, memory_order_relaxed);
     }
 
     cout << "Konstruktor kopiujący wywołany. Macierz została skopiowana." << endl;
 }
 
+/**
+ * @brief Konstruktor przenoszący klasy Matrix.
+ *
+ * Przejmuje bufor macierzy m, pozostawiając ją niezaalokowaną.
+ *
+ * @param m Macierz, której dane zostają przejęte.
+ */
+Matrix::Matrix(Matrix&& m) noexcept : mag(m.mag), data(m.data), size(m.size), zmiany(nullptr) {
+    m.mag = nullptr;
+    m.data = nullptr;
+    m.size = 0;
+}
+
 /**
  * @brief Destruktor klasy Matrix.
  *
- * Zwolnia pamięć zaalokowaną dla danych macierzy.
+ * Zwolnia pamięć zaalokowaną dla danych macierzy, o ile nie korzysta z niej żadna kopia.
  * Zapewnia, że zasoby są poprawnie zwolnione, aby uniknąć wycieków pamięci.
  */
 Matrix::~Matrix() {
-    // Sprawdzamy, czy pamięć została wcześniej zaalokowana
-    if (data != nullptr) {
-        delete[] data; // Zwalniamy pamięć
-        data = nullptr; // Ustawiamy wskaźnik na nullptr po zwolnieniu pamięci
-    }
+    zwolnij();
+    delete zmiany;
 
     cout << "Destruktor wywołany. Pamięć macierzy została zwolniona." << endl;
 }
 
+/**
+ * @brief Tworzy nowy bufor danych.
+ *
+ * Duże bufory alokowane są przez alokuj_bufor() zgodnie z polityką NUMA,
+ * małe pochodzą ze zwykłej sterty.
+ *
+ * @param n Rozmiar macierzy (bufor ma n * n elementów).
+ * @param zeruj Czy bufor ma być wyzerowany.
+ * @return Bufor z licznikiem odwołań równym 1.
+ */
+Matrix::Magazyn* Matrix::nowy_magazyn(int n, bool zeruj) {
+    bool wyzerowany = false;
+    Magazyn* m = new Magazyn;
+    m->licznik.store(1, memory_order_relaxed);
+    m->skrot.store(0, memory_order_relaxed);
+    m->pojemnosc = static_cast<long>(n) * n;
+    m->dane = alokuj_bufor(n, n, m->mapowany, wyzerowany, zeruj);
+    if (zeruj && !wyzerowany) {
+        fill_n(m->dane, m->pojemnosc, 0);
+    }
+    return m;
+}
+
+/**
+ * @brief Odłącza macierz od bufora danych.
+ *
+ * Ostatnia macierz korzystająca z bufora zwalnia jego pamięć (cudzy bufor
+ * zwalnia jego właściciel, gdy zniknie ostatnie odwołanie).
+ */
+void Matrix::zwolnij(void) {
+    if (mag != nullptr && mag->licznik.fetch_sub(1, memory_order_acq_rel) == 1) {
+        if (!mag->wlasciciel) {
+            zwolnij_bufor(mag->dane, mag->pojemnosc, mag->mapowany);
+        }
+        delete mag;
+    }
+    mag = nullptr;
+    data = nullptr;
+}
+
+/**
+ * @brief Zapewnia wyłączny dostęp do bufora przed zapisem.
+ *
+ * Elementy współdzielonego bufora kopiowane są do nowego bufora,
+ * z którego korzysta tylko bieżący obiekt.
+ */
+void Matrix::rozdziel(void) {
+    Magazyn* nowy = nowy_magazyn(size, false);
+    const int* zrodlo = data;
+    rownolegle_wiersze(size, size, [&](int y0, int y1) {
+        copy(zrodlo + static_cast<long>(y0) * size, zrodlo + static_cast<long>(y1) * size,
+             nowy->dane + static_cast<long>(y0) * size);
+    });
+
+    zwolnij();
+    mag = nowy;
+    data = nowy->dane;
+}
+
+/**
+ * @brief Przejmuje bufor macierzy tymczasowej zamiast kopiować jej elementy.
+ *
+ * @param m Macierz tymczasowa, która otrzymuje dotychczasowy bufor bieżącego obiektu.
+ */
+void Matrix::przejmij(Matrix& m) {
+    swap(mag, m.mag);
+    swap(data, m.data);
+    zmieniono();
+}
+
 /**
  * @brief Ustawia macierz diagonalną na podstawie podanego wektora.
  *
@@ -122,6 +253,9 @@ Matrix& Matrix::diagonalna(int* t) {
         return *this;
     }
 
+    odlacz();
+    zmieniono();
+
     for (int i = 0; i < size; ++i) {
         for (int j = 0; j < size; ++j) {
             if (i == j) {
@@ -149,6 +283,9 @@ Matrix& Matrix::diagonalna_k(int k, int* t) {
         return *this;
     }
 
+    odlacz();
+    zmieniono();
+
     for (int i = 0; i < size * size; ++i) {
         data[i] = 0;
     }
@@ -183,6 +320,9 @@ Matrix& Matrix::kolumna(int x, int* t) {
         return *this;
     }
 
+    odlacz();
+    zmieniono(WSZYSTKIE, x);
+
     for (int i = 0; i < size; ++i) {
         data[i * size + x] = t[i];
     }
@@ -209,6 +349,9 @@ Matrix& Matrix::wiersz(int y, int* t) {
         return *this;
     }
 
+    odlacz();
+    zmieniono(y, WSZYSTKIE);
+
     for (int i = 0; i < size; ++i) {
         data[y * size + i] = t[i];
     }
@@ -228,6 +371,9 @@ Matrix& Matrix::przekatna(void) {
         return *this;
     }
 
+    odlacz();
+    zmieniono();
+
     for (int i = 0; i < size; ++i) {
         for (int j = 0; j < size; ++j) {
             if (i == j) {
@@ -253,6 +399,9 @@ Matrix& Matrix::pod_przekatna(void) {
         return *this;
     }
 
+    odlacz();
+    zmieniono();
+
     for (int i = 0; i < size; ++i) {
         for (int j = 0; j < size; ++j) {
             if (i > j) {
@@ -278,6 +427,9 @@ Matrix& Matrix::nad_przekatna(void) {
         return *this;
     }
 
+    odlacz();
+    zmieniono();
+
     for (int i = 0; i < size; ++i) {
         for (int j = 0; j < size; ++j) {
             if (i < j) {
@@ -303,6 +455,9 @@ Matrix& Matrix::szachownica(void) {
         return *this;
     }
 
+    odlacz();
+    zmieniono();
+
     for (int i = 0; i < size; ++i) {
         for (int j = 0; j < size; ++j) {
             if ((i + j) % 2 == 0) {
@@ -333,12 +488,15 @@ Matrix& Matrix::operator+(Matrix& m) {
 
     Matrix result(size);
 
-    for (int i = 0; i < size; ++i) {
-        for (int j = 0; j < size; ++j) {
-            result.data[i * size + j] = data[i * size + j] + m.data[i * size + j];
+    // Bloki wierszy przetwarzane są przez wątki przypięte do węzłów NUMA tych wierszy
+    rownolegle_wiersze(size, size, [&](int y0, int y1) {
+        for (int i = y0; i < y1; ++i) {
+            for (int j = 0; j < size; ++j) {
+                result.data[i * size + j] = data[i * size + j] + m.data[i * size + j];
+            }
         }
-    }
-    copy_n(result.data, size * size, data);
+    });
+    przejmij(result);
 
     return *this;
 }
@@ -358,241 +516,863 @@ Matrix& Matrix::operator*(Matrix& m) {
         return *this;
     }
 
+    // Przy włączonej pamięci iloczynów powtarzane mnożenie jest tylko wyszukaniem
+    PamiecIloczynow* pamiec = data != nullptr ? pamiec_iloczynow() : nullptr;
+    if (pamiec != nullptr) {
+        Matrix zapamietany;
+        if (pamiec->znajdz(*this, m, zapamietany)) {
+            przejmij(zapamietany);
+            return *this;
+        }
+    }
+
     Matrix result(size);
 
-    for (int i = 0; i < size; ++i) {
-        for (int j = 0; j < size; ++j) {
-            result.data[i * size + j] = 0;
-            for (int k = 0; k < size; ++k) {
-                result.data[i * size + j] += data[i * size + k] * m.data[k * size + j];
-            }
-        }
+    // Mnożenie blokowe, to samo jądro obsługuje rozkłady LU, Cholesky'ego i QR.
+    // Każdy wątek liczy swój blok wierszy wyniku.
+    rownolegle_wiersze(size, static_cast<long>(size) * size, [&](int y0, int y1) {
+        gemm(y1 - y0, size, size, 1, data + static_cast<long>(y0) * size, size, m.data, size,
+             result.data + static_cast<long>(y0) * size, size);
+    });
+    if (pamiec != nullptr) {
+        pamiec->zapamietaj(*this, m, result);
     }
-    copy_n(result.data, size * size, data);
+    przejmij(result);
 
     return *this;
 }
 
+namespace {
+
 /**
- * @brief Wstawia wartość do macierzy w określonej pozycji.
+ * @brief Oblicza C = A (*) B nad półpierścieniem P w wielu wątkach.
  *
- * @param x Indeks wiersza.
- * @param y Indeks kolumny.
- * @param wartosc Wartość do wstawienia.
+ * @param n Rozmiar macierzy.
+ * @param a Macierz A.
+ * @param b Macierz B.
+ * @param c Macierz wynikowa.
  */
-
-void Matrix::wstaw(int x, int y, int wartosc) {
-    if (x < 0 || x >= size || y < 0 || y >= size) {
-        cerr << "Indeksy poza zakresem. Indeksy muszą być w zakresie od 0 do " << size - 1 << "." << endl;
-        return;
-    }
-    data[x * size + y] = wartosc;
+template <typename P>
+void iloczyn_nad(int n, const int* a, const int* b, int* c) {
+    rownolegle_wiersze(n, static_cast<long>(n) * n, [&](int y0, int y1) {
+        int* cy = c + static_cast<long>(y0) * n;
+        fill(cy, cy + static_cast<long>(y1 - y0) * n, P::zero());
+        gemm_polpierscien<P>(y1 - y0, n, n, a + static_cast<long>(y0) * n, n, b, n, cy, n);
+    });
 }
 
 /**
- * @brief Alokuje pamięć dla macierzy o określonym rozmiarze.
+ * @brief Zwraca zero i jedynkę półpierścienia.
  *
- * @param n Rozmiar macierzy (n x n).
+ * @param p Półpierścień.
+ * @return Para (zero, jedynka).
  */
-
-void Matrix::alokuj(int n) {
-    if (data != nullptr) {
-        cerr << "Pamięć dla macierzy już została zaalokowana." << endl;
-        return;
-    }
-    size = n;
-    data = new int[size * size]();
-    if (data == nullptr) {
-        cerr << "Nie udało się zaalokować pamięci." << endl;
-        exit(1);
+pair<int, int> zero_i_jeden(Polpierscien p) {
+    using namespace polpierscienie;
+    switch (p) {
+    case Polpierscien::MinPlus:
+        return {MinPlus::zero(), MinPlus::jeden()};
+    case Polpierscien::MaxPlus:
+        return {MaxPlus::zero(), MaxPlus::jeden()};
+    case Polpierscien::MaxMin:
+        return {MaxMin::zero(), MaxMin::jeden()};
+    case Polpierscien::Logiczny:
+        return {Logiczny::zero(), Logiczny::jeden()};
+    default:
+        return {PlusRazy::zero(), PlusRazy::jeden()};
     }
 }
 
+} // namespace
+
 /**
- * @brief Pobiera wartość z macierzy w określonej pozycji.
+ * @brief Mnoży dwie macierze nad wskazanym półpierścieniem.
  *
- * @param x Indeks wiersza.
- * @param y Indeks kolumny.
- * @return Zwraca wartość w macierzy na pozycji (x, y). Zwraca -1 w przypadku błędu.
+ * Dla zwykłego półpierścienia (+, *) wywołuje operator*, a dla pozostałych
+ * blokowe jądro gemm_polpierscien dopasowane do ich operacji.
+ *
+ * @param m Macierz, przez którą chcemy pomnożyć.
+ * @param p Półpierścień.
+ * @return Referencja do macierzy zawierającej wynik.
  */
 
-int Matrix::pokaz(int x, int y) {
-    if (x < 0 || x >= size || y < 0 || y >= size) {
-        cerr << "Indeksy poza zakresem." << endl;
-        return -1;
+Matrix& Matrix::iloczyn(Matrix& m, Polpierscien p) {
+    if (size != m.size) {
+        cerr << "Macierze mają różne rozmiary, nie można ich pomnożyć." << endl;
+        return *this;
     }
-    return data[x * size + y];
+    if (p == Polpierscien::PlusRazy || p == Polpierscien::Zliczajacy) {
+        return *this * m;
+    }
+
+    Matrix result(size);
+    switch (p) {
+    case Polpierscien::MinPlus:
+        iloczyn_nad<polpierscienie::MinPlus>(size, data, m.data, result.data);
+        break;
+    case Polpierscien::MaxPlus:
+        iloczyn_nad<polpierscienie::MaxPlus>(size, data, m.data, result.data);
+        break;
+    case Polpierscien::MaxMin:
+        iloczyn_nad<polpierscienie::MaxMin>(size, data, m.data, result.data);
+        break;
+    default:
+        iloczyn_nad<polpierscienie::Logiczny>(size, data, m.data, result.data);
+        break;
+    }
+    przejmij(result);
+
+    return *this;
 }
 
 /**
- * @brief Operator dodawania skalaru do macierzy.
+ * @brief Podnosi macierz do potęgi k nad wskazanym półpierścieniem.
  *
- * Dodaje skalar do każdego elementu macierzy.
+ * Wykonuje O(log k) mnożeń; np. dla MinPlus i zer na przekątnej potęga n - 1
+ * daje długości najkrótszych ścieżek między wszystkimi parami wierzchołków.
  *
- * @param a Wartość skalara.
- * @return Zwraca referencję do zmodyfikowanej macierzy.
+ * @param k Wykładnik.
+ * @param p Półpierścień.
+ * @return Referencja do macierzy zawierającej wynik.
  */
 
-Matrix& Matrix::operator+(int a) {
+Matrix& Matrix::potega(int k, Polpierscien p) {
     if (!data) {
         cerr << "Pamięć dla macierzy nie została zaalokowana. Najpierw zaalokuj pamięć." << endl;
         return *this;
     }
+    if (k < 0) {
+        cerr << "Wykładnik musi być nieujemny." << endl;
+        return *this;
+    }
 
-    for (int i = 0; i < size; ++i) {
-        for (int j = 0; j < size; ++j) {
-            data[i * size + j] += a;
+    if (k == 0) {
+        auto [zero, jeden] = zero_i_jeden(p);
+        odlacz();
+        zmieniono();
+        for (int i = 0; i < size; ++i) {
+            for (int j = 0; j < size; ++j) {
+                data[i * size + j] = i == j ? jeden : zero;
+            }
+        }
+        return *this;
+    }
+
+    Matrix baza(*this);
+    Matrix wynik;
+    bool pusty = true;
+    while (k > 0) {
+        if (k & 1) {
+            if (pusty) {
+                wynik = baza;
+                pusty = false;
+            } else {
+                wynik.iloczyn(baza, p);
+            }
+        }
+        k >>= 1;
+        if (k > 0) {
+            Matrix kwadrat(baza);
+            kwadrat.iloczyn(baza, p);
+            baza = move(kwadrat);
         }
     }
+    przejmij(wynik);
 
     return *this;
 }
 
 /**
- * @brief Operator mnożenia macierzy przez skalar.
+ * @brief Iloczyn Hadamarda (element po elemencie).
  *
- * Mnoży każdy element macierzy przez skalar.
+ * Pętla bez rozgałęzień wektoryzuje się, a bloki wierszy liczone są równolegle.
  *
- * @param a Wartość skalara.
- * @return Zwraca referencję do zmodyfikowanej macierzy.
+ * @param m Macierz tego samego rozmiaru.
+ * @return Zwraca referencję do bieżącej macierzy.
  */
+Matrix& Matrix::hadamard(const Matrix& m) {
+    return zip_inplace(m, [](int a, int b) { return a * b; });
+}
 
-Matrix& Matrix::operator*(int a) {
-    if (!data) {
+/**
+ * @brief Iloczyn Kroneckera.
+ *
+ * Wiersz r wyniku odpowiada parze (i, k) = (r / nb, r % nb) i składa się z bloków
+ * A(i, j) * B(k, :), zapisywanych kolejno. Wątki dostają rozłączne bloki wierszy wyniku.
+ *
+ * @param b Prawy czynnik.
+ * @return Macierz rozmiaru na * nb.
+ */
+Matrix Matrix::kronecker(const Matrix& b) const {
+    if (!data || !b.data) {
         cerr << "Pamięć dla macierzy nie została zaalokowana. Najpierw zaalokuj pamięć." << endl;
-        return *this;
+        return Matrix();
     }
-
-    for (int i = 0; i < size; ++i) {
-        for (int j = 0; j < size; ++j) {
-            data[i * size + j] *= a;
-        }
+    const long n = static_cast<long>(size) * b.size;
+    if (n > numeric_limits<int>::max()) {
+        cerr << "Iloczyn Kroneckera jest zbyt duży." << endl;
+        return Matrix();
     }
 
-    return *this;
+    Matrix wynik(static_cast<int>(n), bez_zerowania);
+    const int na = size;
+    const int nb = b.size;
+    const int* a = data;
+    const int* e = b.data;
+    int* d = wynik.data;
+    rownolegle_wiersze(static_cast<int>(n), n, [=](int y0, int y1) {
+        for (int r = y0; r < y1; ++r) {
+            const int* ai = a + static_cast<long>(r / nb) * na;
+            const int* bk = e + static_cast<long>(r % nb) * nb;
+            int* w = d + r * n;
+            for (int j = 0; j < na; ++j) {
+                const int aij = ai[j];
+                int* blok = w + static_cast<long>(j) * nb;
+                for (int l = 0; l < nb; ++l) {
+                    blok[l] = aij * bk[l];
+                }
+            }
+        }
+    });
+    return wynik;
 }
 
+namespace {
+
 /**
- * @brief Operator odejmowania skalara od macierzy.
+ * @brief Liczba bajtów paska wierszy kopiowanego przez permutuj_kolumny() (rozmiar L2).
+ */
+constexpr long BAJTY_PASKA = 1L << 18;
+
+/**
+ * @brief Liczba kolumn kafelka w permutuj_kolumny(); ich indeksy (4 KiB) pozostają w L1.
+ */
+constexpr int KOLUMNY_KAFELKA = 1024;
+
+/**
+ * @brief Rozkłada permutację na nietrywialne cykle (punkty stałe są pomijane).
  *
- * Odejmuje skalar od każdego elementu macierzy.
+ * Cykl zapisywany jest jako c0, p[c0], p[p[c0]], ..., więc przesunięcie elementów
+ * pozycji c(t+1) na pozycje c(t) i elementu c0 na ostatnią pozycję realizuje permutację.
  *
- * @param a Wartość skalara.
- * @return Zwraca referencję do zmodyfikowanej macierzy.
+ * @param p Permutacja.
+ * @param elementy Kolejne cykle zapisane jeden za drugim.
+ * @param poczatki Początek każdego cyklu w elementy oraz na końcu długość elementy.
  */
+void cykle_permutacji(const Permutation& p, vector<int>& elementy, vector<int>& poczatki) {
+    const int n = p.rozmiar();
+    vector<char> odwiedzony(n, 0);
+    poczatki.push_back(0);
+    for (int s = 0; s < n; ++s) {
+        if (odwiedzony[s] || p[s] == s) {
+            continue;
+        }
+        for (int i = s; !odwiedzony[i]; i = p[i]) {
+            odwiedzony[i] = 1;
+            elementy.push_back(i);
+        }
+        poczatki.push_back(static_cast<int>(elementy.size()));
+    }
+}
 
-Matrix& Matrix::operator-(int a) {
+} // namespace
+
+/**
+ * @brief Permutuje wiersze w miejscu.
+ *
+ * Wiersze przesuwane są wzdłuż cykli ciągłymi kopiami, a każdy wątek przesuwa
+ * ten sam układ cykli w swoim zakresie kolumn, więc wątki nie piszą do wspólnych
+ * linii pamięci poza granicami zakresów.
+ *
+ * @param p Permutacja o rozmiarze macierzy.
+ * @return Zwraca referencję do bieżącej macierzy.
+ */
+Matrix& Matrix::permutuj_wiersze(const Permutation& p) {
     if (!data) {
         cerr << "Pamięć dla macierzy nie została zaalokowana. Najpierw zaalokuj pamięć." << endl;
         return *this;
     }
+    if (p.rozmiar() != size) {
+        cerr << "Permutacja ma inny rozmiar niż macierz." << endl;
+        return *this;
+    }
 
-    for (int i = 0; i < size; ++i) {
-        for (int j = 0; j < size; ++j) {
-            data[i * size + j] -= a;
-        }
+    vector<int> elementy, poczatki;
+    cykle_permutacji(p, elementy, poczatki);
+    if (elementy.empty()) {
+        return *this;
     }
+    odlacz();
+    zmieniono();
+
+    int* d = data;
+    const int n = size;
+    rownolegle_wiersze(n, static_cast<long>(elementy.size()), [&, d, n](int k0, int k1) {
+        const int szer = k1 - k0;
+        vector<int> bufor(szer);
+        for (size_t c = 0; c + 1 < poczatki.size(); ++c) {
+            const int* cykl = elementy.data() + poczatki[c];
+            const int dl = poczatki[c + 1] - poczatki[c];
+            copy_n(d + static_cast<long>(cykl[0]) * n + k0, szer, bufor.data());
+            for (int t = 0; t + 1 < dl; ++t) {
+                copy_n(d + static_cast<long>(cykl[t + 1]) * n + k0, szer, d + static_cast<long>(cykl[t]) * n + k0);
+            }
+            copy_n(bufor.data(), szer, d + static_cast<long>(cykl[dl - 1]) * n + k0);
+        }
+    });
 
     return *this;
 }
 
 /**
- * @brief Transponuje macierz.
+ * @brief Permutuje kolumny w miejscu.
  *
- * Zamienia wiersze z kolumnami macierzy.
+ * Wiersze przetwarzane są paskami mieszczącymi się w pamięci podręcznej L2:
+ * pasek kopiowany jest do bufora, a następnie odczytywany z niego kafelkami
+ * kolumn docelowych, dla których indeksy p[j] pozostają w L1 podczas przejścia
+ * przez wszystkie wiersze paska. Losowe odczyty trafiają więc do bufora w L2,
+ * a zapisy do macierzy są ciągłe.
  *
- * @return Zwraca nową macierz będącą transpozycją macierzy oryginalnej.
+ * @param p Permutacja o rozmiarze macierzy.
+ * @return Zwraca referencję do bieżącej macierzy.
  */
+Matrix& Matrix::permutuj_kolumny(const Permutation& p) {
+    if (!data) {
+        cerr << "Pamięć dla macierzy nie została zaalokowana. Najpierw zaalokuj pamięć." << endl;
+        return *this;
+    }
+    if (p.rozmiar() != size) {
+        cerr << "Permutacja ma inny rozmiar niż macierz." << endl;
+        return *this;
+    }
+    if (p.jednostkowa()) {
+        return *this;
+    }
+    odlacz();
+    zmieniono();
+
+    int* d = data;
+    const int n = size;
+    const int* zrodlo = p.indeksy().data();
+    const int pasek = static_cast<int>(clamp<long>(BAJTY_PASKA / (static_cast<long>(n) * sizeof(int)), 1, n));
+    rownolegle_wiersze(n, n, [=](int y0, int y1) {
+        vector<int> bufor(static_cast<long>(min(pasek, y1 - y0)) * n);
+        for (int x0 = y0; x0 < y1; x0 += pasek) {
+            const int x1 = min(x0 + pasek, y1);
+            int* w = d + static_cast<long>(x0) * n;
+            copy(w, w + static_cast<long>(x1 - x0) * n, bufor.data());
+            for (int j0 = 0; j0 < n; j0 += KOLUMNY_KAFELKA) {
+                const int j1 = min(j0 + KOLUMNY_KAFELKA, n);
+                for (int x = 0; x < x1 - x0; ++x) {
+                    const int* b = bufor.data() + static_cast<long>(x) * n;
+                    int* v = w + static_cast<long>(x) * n;
+                    for (int j = j0; j < j1; ++j) {
+                        v[j] = b[zrodlo[j]];
+                    }
+                }
+            }
+        }
+    });
 
-Matrix& Matrix::dowroc(void) {
-    Matrix temp(size);
+    return *this;
+}
 
+/**
+ * @brief Permutuje symetrycznie wiersze i kolumny.
+ *
+ * @param p Permutacja o rozmiarze macierzy.
+ * @return Zwraca referencję do bieżącej macierzy.
+ */
+Matrix& Matrix::permutuj(const Permutation& p) {
+    permutuj_wiersze(p);
+    return permutuj_kolumny(p);
+}
+
+/**
+ * @brief Zwraca szerokość pasma macierzy.
+ *
+ * Każdy wiersz przeszukiwany jest od lewej tylko do przekątnej i od prawej
+ * tylko do niej, a przeszukiwanie kończy się na pierwszym niezerowym elemencie.
+ *
+ * @return Największe |i - j| wśród niezerowych elementów.
+ */
+int Matrix::pasmo(void) const {
+    int wynik = 0;
     for (int i = 0; i < size; ++i) {
-        for (int j = 0; j < size; ++j) {
-            temp.data[j * size + i] = data[i * size + j];
+        const int* w = data + static_cast<long>(i) * size;
+        for (int j = 0; j < i - wynik; ++j) {
+            if (w[j] != 0) {
+                wynik = i - j;
+                break;
+            }
+        }
+        for (int j = size - 1; j > i + wynik; --j) {
+            if (w[j] != 0) {
+                wynik = j - i;
+                break;
+            }
         }
     }
-    copy_n(temp.data, size * size, data);
-
-    return *this;
+    return wynik;
 }
 
 /**
- * @brief Operator odejmowania macierzy.
+ * @brief Operator mnożenia przez niejawną macierz wzorcową.
  *
- * Odejmuje dwie macierze element po elemencie.
+ * Zamiast ogólnego mnożenia O(n^3) wykorzystuje jądro dopasowane do wzoru.
  *
- * @param m Macierz, którą chcemy odjąć.
- * @return Zwraca nową macierz będącą wynikiem odejmowania.
+ * @param w Macierz wzorcowa, przez którą chcemy pomnożyć.
+ * @return Zwraca referencję do macierzy zawierającej wynik mnożenia.
  */
 
-Matrix& Matrix::operator-(Matrix& m) {
-    if (size != m.size) {
-        cerr << "Macierze mają różne rozmiary, nie można ich odjąć." << endl;
+Matrix& Matrix::operator*(const PatternMatrix& w) {
+    if (size != w.rozmiar()) {
+        cerr << "Macierze mają różne rozmiary, nie można ich pomnożyć." << endl;
         return *this;
     }
 
     Matrix result(size);
-
-    for (int i = 0; i < size; ++i) {
-        for (int j = 0; j < size; ++j) {
-            result.data[i * size + j] = data[i * size + j] - m.data[i * size + j];
-        }
-    }
-    copy_n(result.data, size * size, data);
+    w.mnoz_z_prawej(data, result.data);
+    przejmij(result);
 
     return *this;
 }
 
 /**
- * @brief Operator przypisania.
+ * @brief Operator mnożenia przez spakowaną macierz trójkątną.
  *
- * Kopiuje wartości z jednej macierzy do drugiej.
+ * Każdy wiersz macierzy mnożony jest przez trójkąt bez odwoływania się do zer.
  *
- * @param m Macierz, której wartości chcemy przypisać.
- * @return Zwraca referencję do zmodyfikowanej macierzy.
+ * @param t Macierz trójkątna, przez którą chcemy pomnożyć.
+ * @return Zwraca referencję do macierzy zawierającej wynik mnożenia.
  */
 
-Matrix& Matrix::operator=(const Matrix& m) {
-    if (this == &m) {
+Matrix& Matrix::operator*(const TriangularMatrix<int>& t) {
+    if (size != t.rozmiar()) {
+        cerr << "Macierze mają różne rozmiary, nie można ich pomnożyć." << endl;
         return *this;
     }
 
-    if (data != nullptr) {
-        delete[] data;
-    }
-
-    size = m.size;
-    data = new int[size * size];
-    if (data == nullptr) {
-        cerr << "Nie udało się zaalokować pamięci." << endl;
-        exit(1);
-    }
-
-    for (int i = 0; i < size * size; ++i) {
-        data[i] = m.data[i];
-    }
+    odlacz();
+    zmieniono();
+    trmm_prawe(t, size, data);
 
     return *this;
 }
 
-
 /**
- * @brief Wypełnia macierz losowymi liczbami od 0 do 9.
- *
- * Każdy element macierzy zostaje wypełniony losową liczbą z przedziału [0, 9].
+ * @brief Wstawia wartość do macierzy w określonej pozycji.
  *
- * @return Referencja do bieżącego obiektu.
+ * @param x Indeks wiersza.
+ * @param y Indeks kolumny.
+ * @param wartosc Wartość do wstawienia.
+ */
+
+void Matrix::wstaw(int x, int y, int wartosc) {
+    if (x < 0 || x >= size || y < 0 || y >= size) {
+        cerr << "Indeksy poza zakresem. Indeksy muszą być w zakresie od 0 do " << size - 1 << "." << endl;
+        return;
+    }
+    odlacz();
+    zmieniono(x, y);
+    data[x * size + y] = wartosc;
+}
+
+/**
+ * @brief Alokuje pamięć dla macierzy o określonym rozmiarze.
+ *
+ * @param n Rozmiar macierzy (n x n).
+ */
+
+void Matrix::alokuj(int n) {
+    if (data != nullptr) {
+        cerr << "Pamięć dla macierzy już została zaalokowana." << endl;
+        return;
+    }
+    size = n;
+    mag = nowy_magazyn(size, true);
+    data = mag->dane;
+    zmieniono();
+}
+
+/**
+ * @brief Zmienia rozmiar macierzy.
+ *
+ * Przy wystarczającej pojemności wyłącznego bufora wiersze przesuwane są w miejscu:
+ * przy zmniejszaniu od pierwszego (cel leży przed źródłem), przy powiększaniu
+ * od ostatniego (cel leży za źródłem), a dopisane kolumny i wiersze są zerowane.
+ * W przeciwnym razie tworzony jest nowy, wyzerowany bufor i kopiowany jest wspólny blok.
+ *
+ * @param n Nowy rozmiar macierzy.
+ * @return Zwraca referencję do bieżącej macierzy.
+ */
+Matrix& Matrix::zmien_rozmiar(int n) {
+    if (n <= 0) {
+        cerr << "Rozmiar macierzy musi być większy od zera." << endl;
+        return *this;
+    }
+    if (!data) {
+        alokuj(n);
+        return *this;
+    }
+    if (n == size) {
+        return *this;
+    }
+
+    const long stary = size;
+    const long nowy = n;
+    const long wspolne = min(stary, nowy);
+    if (mag->licznik.load(memory_order_acquire) == 1 && !mag->wlasciciel && mag->pojemnosc >= nowy * nowy) {
+        if (nowy < stary) {
+            for (long i = 1; i < nowy; ++i) {
+                copy_n(data + i * stary, nowy, data + i * nowy);
+            }
+        } else {
+            for (long i = stary - 1; i >= 0; --i) {
+                if (i > 0) {
+                    copy_backward(data + i * stary, data + (i + 1) * stary, data + i * nowy + stary);
+                }
+                fill_n(data + i * nowy + stary, nowy - stary, 0);
+            }
+            fill_n(data + stary * nowy, (nowy - stary) * nowy, 0);
+        }
+        mag->skrot.store(0, memory_order_relaxed);
+    } else {
+        Magazyn* m = nowy_magazyn(n, true);
+        for (long i = 0; i < wspolne; ++i) {
+            copy_n(data + i * stary, wspolne, m->dane + i * nowy);
+        }
+        zwolnij();
+        mag = m;
+        data = m->dane;
+    }
+
+    size = n;
+    zmieniono();
+    return *this;
+}
+
+/**
+ * @brief Rezerwuje bufor na macierz n x n.
+ *
+ * Elementy pozostają na swoich miejscach (bufor przechowuje size * size elementów
+ * na początku), więc wystarczy je skopiować jednym ciągłym blokiem.
+ *
+ * @param n Rozmiar, dla którego rezerwowana jest pamięć.
+ * @return Zwraca referencję do bieżącej macierzy.
+ */
+Matrix& Matrix::rezerwuj(int n) {
+    if (n <= 0 || static_cast<long>(n) * n <= pojemnosc()) {
+        return *this;
+    }
+    if (!data) {
+        cerr << "Pamięć dla macierzy nie została zaalokowana. Najpierw zaalokuj pamięć." << endl;
+        return *this;
+    }
+
+    Magazyn* m = nowy_magazyn(n, false);
+    copy_n(data, static_cast<long>(size) * size, m->dane);
+    m->skrot.store(mag->skrot.load(memory_order_relaxed), memory_order_relaxed);
+    zwolnij();
+    mag = m;
+    data = m->dane;
+    return *this;
+}
+
+/**
+ * @brief Kopiuje wskazane wiersze macierzy do ciągłej tablicy.
+ *
+ * Numery wierszy sprawdzane są raz przed kopiowaniem, a same wiersze kopiowane
+ * są w całości, bez sprawdzania pojedynczych elementów.
+ *
+ * @param wiersze Numery kopiowanych wierszy.
+ * @param k Liczba wierszy.
+ * @param t Tablica na k * size elementów.
+ */
+
+void Matrix::gather_rows(const int* wiersze, int k, int* t) const {
+    for (int r = 0; r < k; ++r) {
+        if (wiersze[r] < 0 || wiersze[r] >= size) {
+            cerr << "Indeks wiersza poza zakresem. Wartość y powinna być w przedziale od 0 do " << size - 1 << "." << endl;
+            return;
+        }
+    }
+
+    for (int r = 0; r < k; ++r) {
+        copy_n(data + static_cast<long>(wiersze[r]) * size, size, t + static_cast<long>(r) * size);
+    }
+}
+
+/**
+ * @brief Wypełnia wskazane kolumny macierzy danymi z tablicy.
+ *
+ * Tablica przechodzona jest wierszami, więc każdy wiersz macierzy odwiedzany jest
+ * tylko raz, niezależnie od liczby wypełnianych kolumn.
+ *
+ * @param kolumny Numery wypełnianych kolumn.
+ * @param k Liczba kolumn.
+ * @param t Tablica size x k zapisana wierszami.
+ * @return Zwraca referencję do obiektu macierzy.
+ */
+
+Matrix& Matrix::scatter_cols(const int* kolumny, int k, const int* t) {
+    if (!data) {
+        cerr << "Pamięć dla macierzy nie została zaalokowana. Najpierw zaalokuj pamięć." << endl;
+        return *this;
+    }
+
+    for (int c = 0; c < k; ++c) {
+        if (kolumny[c] < 0 || kolumny[c] >= size) {
+            cerr << "Indeks kolumny poza zakresem. Wartość x powinna być w przedziale od 0 do " << size - 1 << "." << endl;
+            return *this;
+        }
+    }
+
+    odlacz();
+    for (int c = 0; c < k; ++c) {
+        zmieniono(WSZYSTKIE, kolumny[c]);
+    }
+
+    for (int i = 0; i < size; ++i) {
+        int* wi = data + static_cast<long>(i) * size;
+        const int* ti = t + static_cast<long>(i) * k;
+        for (int c = 0; c < k; ++c) {
+            wi[kolumny[c]] = ti[c];
+        }
+    }
+
+    return *this;
+}
+
+/**
+ * @brief Pobiera wartość z macierzy w określonej pozycji.
+ *
+ * @param x Indeks wiersza.
+ * @param y Indeks kolumny.
+ * @return Zwraca wartość w macierzy na pozycji (x, y). Zwraca -1 w przypadku błędu.
+ */
+
+int Matrix::pokaz(int x, int y) {
+    if (x < 0 || x >= size || y < 0 || y >= size) {
+        cerr << "Indeksy poza zakresem." << endl;
+        return -1;
+    }
+    return data[x * size + y];
+}
+
+/**
+ * @brief Operator dodawania skalaru do macierzy.
+ *
+ * Dodaje skalar do każdego elementu macierzy.
+ *
+ * @param a Wartość skalara.
+ * @return Zwraca referencję do zmodyfikowanej macierzy.
+ */
+
+Matrix& Matrix::operator+(int a) {
+    if (!data) {
+        cerr << "Pamięć dla macierzy nie została zaalokowana. Najpierw zaalokuj pamięć." << endl;
+        return *this;
+    }
+
+    odlacz();
+    zmieniono();
+
+    for (int i = 0; i < size; ++i) {
+        for (int j = 0; j < size; ++j) {
+            data[i * size + j] += a;
+        }
+    }
+
+    return *this;
+}
+
+/**
+ * @brief Operator mnożenia macierzy przez skalar.
+ *
+ * Mnoży każdy element macierzy przez skalar.
+ *
+ * @param a Wartość skalara.
+ * @return Zwraca referencję do zmodyfikowanej macierzy.
+ */
+
+Matrix& Matrix::operator*(int a) {
+    if (!data) {
+        cerr << "Pamięć dla macierzy nie została zaalokowana. Najpierw zaalokuj pamięć." << endl;
+        return *this;
+    }
+
+    odlacz();
+    zmieniono();
+
+    for (int i = 0; i < size; ++i) {
+        for (int j = 0; j < size; ++j) {
+            data[i * size + j] *= a;
+        }
+    }
+
+    return *this;
+}
+
+/**
+ * @brief Operator odejmowania skalara od macierzy.
+ *
+ * Odejmuje skalar od każdego elementu macierzy.
+ *
+ * @param a Wartość skalara.
+ * @return Zwraca referencję do zmodyfikowanej macierzy.
+ */
+
+Matrix& Matrix::operator-(int a) {
+    if (!data) {
+        cerr << "Pamięć dla macierzy nie została zaalokowana. Najpierw zaalokuj pamięć." << endl;
+        return *this;
+    }
+
+    odlacz();
+    zmieniono();
+
+    for (int i = 0; i < size; ++i) {
+        for (int j = 0; j < size; ++j) {
+            data[i * size + j] -= a;
+        }
+    }
+
+    return *this;
+}
+
+/**
+ * @brief Transponuje macierz.
+ *
+ * Zamienia wiersze z kolumnami macierzy.
+ *
+ * @return Zwraca nową macierz będącą transpozycją macierzy oryginalnej.
+ */
+
+Matrix& Matrix::dowroc(void) {
+    Matrix temp(size);
+
+    // Każdy wątek wypełnia swój blok wierszy wyniku kafelkami, aby odczyt kolumn nie wyrzucał pamięci podręcznej
+    const int t = blok_transpozycji();
+    rownolegle_wiersze(size, size, [&](int y0, int y1) {
+        for (int jj = y0; jj < y1; jj += t) {
+            int jk = min(jj + t, y1);
+            for (int ii = 0; ii < size; ii += t) {
+                int ik = min(ii + t, size);
+                for (int j = jj; j < jk; ++j) {
+                    for (int i = ii; i < ik; ++i) {
+                        temp.data[j * size + i] = data[i * size + j];
+                    }
+                }
+            }
+        }
+    });
+    przejmij(temp);
+
+    return *this;
+}
+
+/**
+ * @brief Operator odejmowania macierzy.
+ *
+ * Odejmuje dwie macierze element po elemencie.
+ *
+ * @param m Macierz, którą chcemy odjąć.
+ * @return Zwraca nową macierz będącą wynikiem odejmowania.
+ */
+
+Matrix& Matrix::operator-(Matrix& m) {
+    if (size != m.size) {
+        cerr << "Macierze mają różne rozmiary, nie można ich odjąć." << endl;
+        return *this;
+    }
+
+    Matrix result(size);
+
+    // Bloki wierszy przetwarzane są przez wątki przypięte do węzłów NUMA tych wierszy
+    rownolegle_wiersze(size, size, [&](int y0, int y1) {
+        for (int i = y0; i < y1; ++i) {
+            for (int j = 0; j < size; ++j) {
+                result.data[i * size + j] = data[i * size + j] - m.data[i * size + j];
+            }
+        }
+    });
+    przejmij(result);
+
+    return *this;
+}
+
+/**
+ * @brief Operator przypisania.
+ *
+ * Kopiuje wartości z jednej macierzy do drugiej. Elementy nie są kopiowane od razu,
+ * obie macierze współdzielą bufor do pierwszej modyfikacji.
+ *
+ * @param m Macierz, której wartości chcemy przypisać.
+ * @return Zwraca referencję do zmodyfikowanej macierzy.
+ */
+
+Matrix& Matrix::operator=(const Matrix& m) {
+    if (this == &m || mag == m.mag) {
+        return *this;
+    }
+
+    // Bufor m jest współdzielony, elementy skopiuje dopiero pierwszy zapis
+    if (m.mag != nullptr) {
+        m.mag->licznik.fetch_add(1, memory_order_relaxed);
+    }
+    zwolnij();
+
+    mag = m.mag;
+    data = m.data;
+    size = m.size;
+    zmieniono();
+
+    return *this;
+}
+
+/**
+ * @brief Przenoszący operator przypisania.
+ *
+ * Zwalnia dotychczasowy bufor i przejmuje bufor macierzy m.
+ *
+ * @param m Macierz, której dane zostają przejęte.
+ * @return Zwraca referencję do zmodyfikowanej macierzy.
+ */
+
+Matrix& Matrix::operator=(Matrix&& m) noexcept {
+    if (this == &m) {
+        return *this;
+    }
+
+    zwolnij();
+    swap(mag, m.mag);
+    swap(data, m.data);
+    swap(size, m.size);
+    zmieniono();
+
+    return *this;
+}
+
+
+/**
+ * @brief Wypełnia macierz losowymi liczbami od 0 do 9.
+ *
+ * Każdy element macierzy zostaje wypełniony losową liczbą z przedziału [0, 9].
+ *
+ * @return Referencja do bieżącego obiektu.
  */
 Matrix& Matrix::losuj(void) {
     // Inicjalizacja generatora liczb losowych
     srand(time(0));  // Ustawiamy ziarno na podstawie bieżącego czasu
+    odlacz();
+    zmieniono();
 
     // Wypełnianie macierzy losowymi liczbami od 0 do 9
     for (int i = 0; i < size; ++i) {
         for (int j = 0; j < size; ++j) {
             // Losowanie liczby z przedziału [0, 9]
-            wstaw(i, j, rand() % 10);  // rand() % 10 zwraca liczby od 0 do 9
+            data[i * size + j] = rand() % 10;  // rand() % 10 zwraca liczby od 0 do 9
         }
     }
 
@@ -611,6 +1391,8 @@ Matrix& Matrix::losuj(void) {
 Matrix& Matrix::losuj(int x) {
     // Inicjalizacja generatora liczb losowych
     srand(time(0));  // Ustawiamy ziarno na podstawie bieżącego czasu
+    odlacz();
+    zmieniono();
 
     // Liczba losowanych elementów
     int elementsToFill = x;
@@ -623,7 +1405,7 @@ Matrix& Matrix::losuj(int x) {
         // Sprawdzamy, czy na tej pozycji już jest liczba (żeby nie nadpisać istniejącego elementu)
         if (data[i * size + j] == 0) {
             // Losowanie liczby od 0 do 9 i wstawienie jej do odpowiedniej pozycji
-            wstaw(i, j, rand() % 10);
+            data[i * size + j] = rand() % 10;
             --elementsToFill;  // Zmniejszamy licznik pozostałych elementów do wypełnienia
         }
     }
@@ -646,6 +1428,9 @@ Matrix& Matrix::operator++(int) {
         return *this;
     }
 
+    odlacz();
+    zmieniono();
+
     for (int i = 0; i < size * size; ++i) {
         ++data[i];
     }
@@ -667,6 +1452,9 @@ Matrix& Matrix::operator--(int) {
         return *this;
     }
 
+    odlacz();
+    zmieniono();
+
     for (int i = 0; i < size * size; ++i) {
         --data[i];
     }
@@ -699,6 +1487,246 @@ ostream& operator<<(ostream& os, const Matrix& m) {
     return os;
 }
 
+namespace {
+
+/**
+ * @brief Liczba elementów porównywanych bez sprawdzania wyniku (granulacja wczesnego wyjścia).
+ */
+constexpr long BLOK_POROWNANIA = 1L << 12;
+
+/**
+ * @brief Liczba elementów w bloku skrótu; skrót nie zależy od liczby wątków.
+ */
+constexpr long BLOK_SKROTU = 1L << 16;
+
+constexpr uint64_t PIERWSZA_1 = 0x9E3779B185EBCA87ULL; /**< Stałe mieszające (jak w xxHash64). */
+constexpr uint64_t PIERWSZA_2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr uint64_t PIERWSZA_3 = 0x165667B19E3779F9ULL;
+
+/**
+ * @brief Dołącza 64-bitowe słowo do akumulatora skrótu.
+ */
+inline uint64_t runda(uint64_t akumulator, uint64_t slowo) {
+    return rotl(akumulator + slowo * PIERWSZA_2, 31) * PIERWSZA_1;
+}
+
+/**
+ * @brief Rozprasza bity skrótu.
+ */
+inline uint64_t wymieszaj(uint64_t h) {
+    h ^= h >> 33;
+    h *= PIERWSZA_2;
+    h ^= h >> 29;
+    h *= PIERWSZA_3;
+    h ^= h >> 32;
+    return h;
+}
+
+/**
+ * @brief Liczy skrót ciągłego bloku elementów.
+ *
+ * Cztery niezależne akumulatory pozwalają procesorowi (i kompilatorowi) przetwarzać
+ * po osiem elementów naraz.
+ *
+ * @param d Elementy bloku.
+ * @param n Liczba elementów.
+ * @return Skrót bloku.
+ */
+uint64_t skrot_bloku(const int* d, long n) {
+    uint64_t akumulatory[4] = {PIERWSZA_1, PIERWSZA_2, PIERWSZA_3, PIERWSZA_1 ^ PIERWSZA_2};
+    long i = 0;
+    for (; i + 8 <= n; i += 8) {
+        for (int k = 0; k < 4; ++k) {
+            uint64_t slowo = static_cast<uint32_t>(d[i + 2 * k]) |
+                             static_cast<uint64_t>(static_cast<uint32_t>(d[i + 2 * k + 1])) << 32;
+            akumulatory[k] = runda(akumulatory[k], slowo);
+        }
+    }
+
+    uint64_t h = rotl(akumulatory[0], 1) + rotl(akumulatory[1], 7) + rotl(akumulatory[2], 12) +
+                 rotl(akumulatory[3], 18);
+    for (; i < n; ++i) {
+        h = runda(h, static_cast<uint32_t>(d[i]));
+    }
+    return wymieszaj(h ^ static_cast<uint64_t>(n));
+}
+
+/**
+ * @brief Sprawdza, czy warunek zachodzi dla wszystkich par odpowiadających sobie elementów.
+ *
+ * Bloki po BLOK_POROWNANIA elementów porównywane są bez rozgałęzień (pętla się wektoryzuje),
+ * a wynik sprawdzany jest dopiero po bloku. Wątki przerywają pracę, gdy którykolwiek
+ * znajdzie parę niespełniającą warunku.
+ *
+ * @param a Elementy pierwszej macierzy.
+ * @param b Elementy drugiej macierzy.
+ * @param n Liczba elementów.
+ * @param warunek Predykat dla pary elementów.
+ * @return true, jeśli warunek zachodzi dla wszystkich par.
+ */
+template <typename P>
+bool wszystkie(const int* a, const int* b, long n, P warunek) {
+    if (n == 0) {
+        return true;
+    }
+
+    long bloki = (n + BLOK_POROWNANIA - 1) / BLOK_POROWNANIA;
+    atomic<bool> zgodne{true};
+    rownolegle_wiersze(static_cast<int>(bloki), BLOK_POROWNANIA, [&](int b0, int b1) {
+        for (long blok = b0; blok < b1 && zgodne.load(memory_order_relaxed); ++blok) {
+            long p = blok * BLOK_POROWNANIA;
+            long k = min(p + BLOK_POROWNANIA, n);
+            int ok = 1;
+            for (long i = p; i < k; ++i) {
+                ok &= warunek(a[i], b[i]);
+            }
+            if (!ok) {
+                zgodne.store(false, memory_order_relaxed);
+            }
+        }
+    });
+    return zgodne.load(memory_order_relaxed);
+}
+
+} // namespace
+
+/**
+ * @brief Zwraca skrót zawartości macierzy.
+ *
+ * Skróty bloków po BLOK_SKROTU elementów liczone są równolegle, a następnie łączone
+ * w ustalonej kolejności. Wynik zapamiętywany jest w buforze danych.
+ *
+ * @return 64-bitowy skrót (różny od 0).
+ */
+uint64_t Matrix::skrot(void) const {
+    if (mag == nullptr) {
+        return wymieszaj(static_cast<uint64_t>(size)) | 1;
+    }
+
+    uint64_t h = mag->skrot.load(memory_order_relaxed);
+    if (h != 0) {
+        return h;
+    }
+
+    long n = static_cast<long>(size) * size;
+    long bloki = (n + BLOK_SKROTU - 1) / BLOK_SKROTU;
+    vector<uint64_t> czesci(bloki);
+    rownolegle_wiersze(static_cast<int>(bloki), BLOK_SKROTU, [&](int b0, int b1) {
+        for (long b = b0; b < b1; ++b) {
+            czesci[b] = skrot_bloku(data + b * BLOK_SKROTU, min(BLOK_SKROTU, n - b * BLOK_SKROTU));
+        }
+    });
+
+    h = wymieszaj(static_cast<uint64_t>(size));
+    for (uint64_t c : czesci) {
+        h = runda(h, c);
+    }
+    h = wymieszaj(h);
+    if (h == 0) {
+        h = 1; // 0 oznacza brak zapamiętanego skrótu
+    }
+    mag->skrot.store(h, memory_order_relaxed);
+    return h;
+}
+
+/**
+ * @brief Włącza śledzenie zmienionych wierszy i kolumn.
+ */
+void Matrix::sledz_zmiany(void) {
+    if (zmiany == nullptr) {
+        zmiany = new Zmiany;
+        zmiany->wiersze.assign(size, 0);
+        zmiany->kolumny.assign(size, 0);
+    }
+}
+
+/**
+ * @brief Zwraca numer wersji ostatniej modyfikacji.
+ *
+ * @return Numer wersji albo 0 bez śledzenia.
+ */
+uint64_t Matrix::wersja(void) const {
+    return zmiany != nullptr ? zmiany->wersja : 0;
+}
+
+/**
+ * @brief Nadaje nową wersję zmienionym wierszom i kolumnom.
+ *
+ * Zmiana wiersza może dotyczyć każdej kolumny (i odwrotnie), dlatego wtedy
+ * podnoszona jest wersja wspólna dla wszystkich kolumn.
+ *
+ * @param x Zmieniony wiersz lub WSZYSTKIE.
+ * @param y Zmieniona kolumna lub WSZYSTKIE.
+ */
+void Matrix::oznacz(int x, int y) {
+    uint64_t v = ++zmiany->wersja;
+    if (x == WSZYSTKIE && y == WSZYSTKIE) {
+        // Rozmiar mógł się zmienić (przypisanie, alokacja)
+        zmiany->wiersze.assign(size, 0);
+        zmiany->kolumny.assign(size, 0);
+    }
+
+    if (x == WSZYSTKIE) {
+        zmiany->wszystkie_wiersze = v;
+    } else {
+        zmiany->wiersze[x] = v;
+    }
+    if (y == WSZYSTKIE) {
+        zmiany->wszystkie_kolumny = v;
+    } else {
+        zmiany->kolumny[y] = v;
+    }
+}
+
+namespace {
+
+/**
+ * @brief Wybiera indeksy, których wersja jest nowsza niż od.
+ *
+ * @param wersje Wersje poszczególnych indeksów.
+ * @param wszystkie Wersja zmiany dotyczącej wszystkich indeksów.
+ * @param n Liczba indeksów.
+ * @param od Wersja odniesienia.
+ * @return Rosnące indeksy zmienione po wersji od.
+ */
+vector<int> zmienione(const vector<uint64_t>& wersje, uint64_t wszystkie, int n, uint64_t od) {
+    vector<int> wynik;
+    for (int i = 0; i < n; ++i) {
+        if (wszystkie > od || wersje[i] > od) {
+            wynik.push_back(i);
+        }
+    }
+    return wynik;
+}
+
+} // namespace
+
+/**
+ * @brief Zwraca wiersze zmienione po podanej wersji.
+ *
+ * @param od Numer wersji odniesienia.
+ * @return Numery wierszy (wszystkie, gdy śledzenie jest wyłączone).
+ */
+vector<int> Matrix::zmienione_wiersze(uint64_t od) const {
+    if (zmiany == nullptr) {
+        return zmienione({}, 1, size, 0);
+    }
+    return zmienione(zmiany->wiersze, zmiany->wszystkie_wiersze, size, od);
+}
+
+/**
+ * @brief Zwraca kolumny zmienione po podanej wersji.
+ *
+ * @param od Numer wersji odniesienia.
+ * @return Numery kolumn (wszystkie, gdy śledzenie jest wyłączone).
+ */
+vector<int> Matrix::zmienione_kolumny(uint64_t od) const {
+    if (zmiany == nullptr) {
+        return zmienione({}, 1, size, 0);
+    }
+    return zmienione(zmiany->kolumny, zmiany->wszystkie_kolumny, size, od);
+}
+
 /**
  * @brief Operator porównania równości macierzy.
  *
@@ -712,14 +1740,11 @@ bool Matrix::operator==(const Matrix& m) const{
     if (size != m.size) {
         return false;
     }
-
-    for (int i = 0; i < size * size; ++i) {
-        if (data[i] != m.data[i]) {
-            return false;
-        }
+    if (data == m.data) {
+        return true; // Ten sam bufor (kopie współdzielące dane)
     }
 
-    return true;
+    return wszystkie(data, m.data, static_cast<long>(size) * size, [](int a, int b) { return a == b; });
 }
 
 /**
@@ -750,13 +1775,7 @@ bool Matrix::operator>(const Matrix& m) {
         return false;
     }
 
-    for (int i = 0; i < size * size; ++i) {
-        if (data[i] <= m.data[i]) {
-            return false;
-        }
-    }
-
-    return true;
+    return wszystkie(data, m.data, static_cast<long>(size) * size, [](int a, int b) { return a > b; });
 }
 
 /**
@@ -773,11 +1792,263 @@ bool Matrix::operator<(const Matrix& m) {
         return false;
     }
 
-    for (int i = 0; i < size * size; ++i) {
-        if (data[i] >= m.data[i]) {
-            return false;
+    return wszystkie(data, m.data, static_cast<long>(size) * size, [](int a, int b) { return a < b; });
+}
+namespace {
+
+/**
+ * @brief Redukcje wybierane w przejdz_wiersze().
+ */
+enum Redukcja : unsigned {
+    SUMA = 1,            /**< Sumy wierszy. */
+    SKRAJNE = 2,         /**< Minimum i maksimum wierszy. */
+    KWADRATY = 4,        /**< Sumy kwadratów wierszy. */
+    MODULY_WIERSZY = 8,  /**< Sumy modułów wierszy. */
+    KOLUMNY = 16,        /**< Sumy kolumn. */
+    MODULY_KOLUMN = 32   /**< Sumy modułów kolumn. */
+};
+
+/**
+ * @brief Częściowe wyniki redukcji jednego wiersza.
+ */
+struct WynikWiersza {
+    long long suma = 0;    /**< Suma elementów. */
+    long long moduly = 0;  /**< Suma modułów elementów. */
+    double kwadraty = 0;   /**< Suma kwadratów elementów. */
+    int minimum = 0;       /**< Najmniejszy element. */
+    int maksimum = 0;      /**< Największy element. */
+};
+
+/**
+ * @brief Liczy wybrane redukcje każdego wiersza jednym przejściem po danych.
+ *
+ * Bloki wierszy przetwarzane są równolegle. Wyniki wierszy trafiają na ustalone
+ * pozycje wektora, a sumy kolumn każdy wątek liczy we własnym wektorze i dodaje
+ * do wyniku pod blokadą (dodawanie liczb całkowitych jest łączne, więc kolejność
+ * nie ma znaczenia). Wyłączone redukcje znikają z pętli w czasie kompilacji,
+ * a pozostałe pętle bez rozgałęzień wektoryzują się.
+ *
+ * @param d Elementy macierzy przechowywane wierszami.
+ * @param n Rozmiar macierzy.
+ * @param kolumny Wektor na n sum kolumn (wymagany przy KOLUMNY lub MODULY_KOLUMN).
+ * @return Wyniki kolejnych wierszy.
+ */
+template <unsigned R>
+vector<WynikWiersza> przejdz_wiersze(const int* d, int n, vector<long long>* kolumny = nullptr) {
+    constexpr bool PO_KOLUMNACH = (R & (KOLUMNY | MODULY_KOLUMN)) != 0;
+    vector<WynikWiersza> wyniki(n);
+    if (PO_KOLUMNACH) {
+        kolumny->assign(n, 0);
+    }
+    mutex blokada;
+
+    rownolegle_wiersze(n, n, [&](int y0, int y1) {
+        vector<long long> lokalne(PO_KOLUMNACH ? n : 0, 0);
+        for (int i = y0; i < y1; ++i) {
+            const int* w = d + static_cast<long>(i) * n;
+            long long suma = 0;
+            long long moduly = 0;
+            double kwadraty = 0;
+            int minimum = numeric_limits<int>::max();
+            int maksimum = numeric_limits<int>::min();
+            for (int j = 0; j < n; ++j) {
+                const long long v = w[j];
+                if constexpr ((R & SUMA) != 0) {
+                    suma += v;
+                }
+                if constexpr ((R & MODULY_WIERSZY) != 0) {
+                    moduly += v < 0 ? -v : v;
+                }
+                if constexpr ((R & KWADRATY) != 0) {
+                    kwadraty += static_cast<double>(v) * static_cast<double>(v);
+                }
+                if constexpr ((R & SKRAJNE) != 0) {
+                    minimum = min(minimum, w[j]);
+                    maksimum = max(maksimum, w[j]);
+                }
+                if constexpr ((R & KOLUMNY) != 0) {
+                    lokalne[j] += v;
+                }
+                if constexpr ((R & MODULY_KOLUMN) != 0) {
+                    lokalne[j] += v < 0 ? -v : v;
+                }
+            }
+            wyniki[i] = {suma, moduly, kwadraty, minimum, maksimum};
+        }
+
+        if (PO_KOLUMNACH) {
+            lock_guard<mutex> l(blokada);
+            for (int j = 0; j < n; ++j) {
+                (*kolumny)[j] += lokalne[j];
+            }
+        }
+    });
+    return wyniki;
+}
+
+/**
+ * @brief Znajduje pierwsze (w kolejności wierszy) wystąpienie skrajnej wartości.
+ *
+ * @param d Elementy macierzy.
+ * @param n Rozmiar macierzy.
+ * @param wiersze Wyniki wierszy z przejdz_wiersze<SKRAJNE>().
+ * @param najmniejszy true dla minimum, false dla maksimum.
+ * @return Skrajny element z położeniem.
+ */
+PozycjaElementu skrajny(const int* d, int n, const vector<WynikWiersza>& wiersze, bool najmniejszy) {
+    PozycjaElementu p;
+    if (n == 0) {
+        return p;
+    }
+
+    int najlepszy = 0;
+    for (int i = 1; i < n; ++i) {
+        if (najmniejszy ? wiersze[i].minimum < wiersze[najlepszy].minimum
+                        : wiersze[i].maksimum > wiersze[najlepszy].maksimum) {
+            najlepszy = i;
         }
     }
 
-    return true;
-}
\ No newline at end of file
+    const int* w = d + static_cast<long>(najlepszy) * n;
+    p.wartosc = najmniejszy ? wiersze[najlepszy].minimum : wiersze[najlepszy].maksimum;
+    p.wiersz = najlepszy;
+    p.kolumna = static_cast<int>(find(w, w + n, p.wartosc) - w);
+    return p;
+}
+
+} // namespace
+
+/**
+ * @brief Zwraca sumę wszystkich elementów.
+ *
+ * @return Suma elementów (0 dla niezaalokowanej macierzy).
+ */
+long long Matrix::suma(void) const {
+    long long s = 0;
+    for (const WynikWiersza& w : przejdz_wiersze<SUMA>(data, size)) {
+        s += w.suma;
+    }
+    return s;
+}
+
+/**
+ * @brief Zwraca sumy elementów kolejnych wierszy.
+ *
+ * @return Wektor size sum.
+ */
+vector<long long> Matrix::sumy_wierszy(void) const {
+    vector<WynikWiersza> wiersze = przejdz_wiersze<SUMA>(data, size);
+    vector<long long> s(size);
+    for (int i = 0; i < size; ++i) {
+        s[i] = wiersze[i].suma;
+    }
+    return s;
+}
+
+/**
+ * @brief Zwraca sumy elementów kolejnych kolumn.
+ *
+ * Kolumny sumowane są przy przechodzeniu wierszami, bez skakania po pamięci.
+ *
+ * @return Wektor size sum.
+ */
+vector<long long> Matrix::sumy_kolumn(void) const {
+    vector<long long> s;
+    przejdz_wiersze<KOLUMNY>(data, size, &s);
+    return s;
+}
+
+/**
+ * @brief Zwraca najmniejszy element i jego położenie.
+ *
+ * @return Pierwszy najmniejszy element (pozycja -1 dla niezaalokowanej macierzy).
+ */
+PozycjaElementu Matrix::minimum(void) const {
+    return skrajny(data, size, przejdz_wiersze<SKRAJNE>(data, size), true);
+}
+
+/**
+ * @brief Zwraca największy element i jego położenie.
+ *
+ * @return Pierwszy największy element (pozycja -1 dla niezaalokowanej macierzy).
+ */
+PozycjaElementu Matrix::maksimum(void) const {
+    return skrajny(data, size, przejdz_wiersze<SKRAJNE>(data, size), false);
+}
+
+/**
+ * @brief Zwraca ślad macierzy.
+ *
+ * @return Suma elementów przekątnej.
+ */
+long long Matrix::slad(void) const {
+    long long s = 0;
+    for (long i = 0; i < size; ++i) {
+        s += data[i * size + i];
+    }
+    return s;
+}
+
+/**
+ * @brief Zwraca normę kolumnową.
+ *
+ * @return Największa suma modułów elementów kolumny.
+ */
+long long Matrix::norma_1(void) const {
+    vector<long long> kolumny;
+    przejdz_wiersze<MODULY_KOLUMN>(data, size, &kolumny);
+    return kolumny.empty() ? 0 : *max_element(kolumny.begin(), kolumny.end());
+}
+
+/**
+ * @brief Zwraca normę wierszową.
+ *
+ * @return Największa suma modułów elementów wiersza.
+ */
+long long Matrix::norma_nieskonczonosc(void) const {
+    long long norma = 0;
+    for (const WynikWiersza& w : przejdz_wiersze<MODULY_WIERSZY>(data, size)) {
+        norma = max(norma, w.moduly);
+    }
+    return norma;
+}
+
+/**
+ * @brief Zwraca normę Frobeniusa.
+ *
+ * @return Pierwiastek z sumy kwadratów elementów.
+ */
+double Matrix::norma_frobeniusa(void) const {
+    double kwadraty = 0;
+    for (const WynikWiersza& w : przejdz_wiersze<KWADRATY>(data, size)) {
+        kwadraty += w.kwadraty;
+    }
+    return sqrt(kwadraty);
+}
+
+/**
+ * @brief Liczy sumę, ślad, minimum, maksimum i normy jednym przejściem po danych.
+ *
+ * @return Wyniki wszystkich redukcji.
+ */
+Statystyki Matrix::statystyki(void) const {
+    Statystyki s;
+    vector<long long> kolumny;
+    vector<WynikWiersza> wiersze =
+        przejdz_wiersze<SUMA | SKRAJNE | KWADRATY | MODULY_WIERSZY | MODULY_KOLUMN>(data, size, &kolumny);
+
+    double kwadraty = 0;
+    for (const WynikWiersza& w : wiersze) {
+        s.suma += w.suma;
+        kwadraty += w.kwadraty;
+        s.norma_nieskonczonosc = max(s.norma_nieskonczonosc, w.moduly);
+    }
+    for (long long k : kolumny) {
+        s.norma_1 = max(s.norma_1, k);
+    }
+    s.slad = slad();
+    s.minimum = skrajny(data, size, wiersze, true);
+    s.maksimum = skrajny(data, size, wiersze, false);
+    s.norma_frobeniusa = sqrt(kwadraty);
+    return s;
+}
@@ -1,6 +1,104 @@
+#pragma once
+
 #include <iostream>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+#include "Rownolegle.hpp"
 using namespace std;
 
+class PatternMatrix;
+template <typename T> class TriangularMatrix;
+template <typename T> class SymmetricMatrix;
+template <int N> class FixedMatrix;
+class Permutation;
+enum class Polpierscien;
+
+/**
+ * @struct WidokMacierzy
+ * @brief Widok wszystkich elementów macierzy z dostępem (x, y) bez narzutu na każdy element.
+ */
+template <typename T>
+struct WidokMacierzy {
+  T* dane;      /**< Elementy macierzy przechowywane wierszami. */
+  int rozmiar;  /**< Liczba wierszy (i kolumn). */
+
+  /**
+   * @brief Zwraca element (x, y) (zakres sprawdzany tylko w wersji debugowej).
+   * @param x Wiersz.
+   * @param y Kolumna.
+   * @return Referencja do elementu.
+   */
+  T& operator()(int x, int y) const {
+    assert(x >= 0 && x < rozmiar && y >= 0 && y < rozmiar);
+    return dane[static_cast<long>(x) * rozmiar + y];
+  }
+};
+
+/**
+ * @struct WidokKolumny
+ * @brief Widok kolumny macierzy: elementy oddalone o stały krok w pamięci.
+ */
+template <typename T>
+struct WidokKolumny {
+  T* poczatek;  /**< Wskaźnik na element w pierwszym wierszu. */
+  int dlugosc;  /**< Liczba elementów kolumny. */
+  int krok;     /**< Odległość między kolejnymi elementami. */
+
+  /**
+   * @brief Zwraca element kolumny w wierszu i (bez sprawdzania zakresu).
+   * @param i Numer wiersza.
+   * @return Referencja do elementu.
+   */
+  T& operator[](int i) const { return poczatek[static_cast<long>(i) * krok]; }
+
+  /**
+   * @brief Zwraca liczbę elementów kolumny.
+   * @return Długość kolumny.
+   */
+  int size(void) const { return dlugosc; }
+};
+
+/**
+ * @struct PozycjaElementu
+ * @brief Wartość elementu wraz z jego położeniem w macierzy.
+ */
+struct PozycjaElementu {
+  int wartosc = 0;   /**< Wartość elementu. */
+  int wiersz = -1;   /**< Numer wiersza (-1 dla pustej macierzy). */
+  int kolumna = -1;  /**< Numer kolumny (-1 dla pustej macierzy). */
+};
+
+/**
+ * @struct Statystyki
+ * @brief Wyniki redukcji policzonych jednym przejściem po danych (Matrix::statystyki()).
+ */
+struct Statystyki {
+  long long suma = 0;                  /**< Suma elementów. */
+  long long slad = 0;                  /**< Suma elementów przekątnej. */
+  PozycjaElementu minimum;             /**< Najmniejszy element (pierwszy w kolejności wierszy). */
+  PozycjaElementu maksimum;            /**< Największy element (pierwszy w kolejności wierszy). */
+  long long norma_1 = 0;               /**< Największa suma modułów w kolumnie. */
+  long long norma_nieskonczonosc = 0;  /**< Największa suma modułów w wierszu. */
+  double norma_frobeniusa = 0;         /**< Pierwiastek z sumy kwadratów elementów. */
+};
+
+/**
+ * @struct BezZerowania
+ * @brief Znacznik konstruktora Matrix, który nie zeruje elementów.
+ */
+struct BezZerowania {
+  explicit BezZerowania(void) = default;
+};
+
+/**
+ * @brief Wartość znacznika BezZerowania, np. Matrix m(n, bez_zerowania).
+ */
+inline constexpr BezZerowania bez_zerowania{};
+
 /**
  * @class Matrix
  * @brief Klasa reprezentująca macierz kwadratową z różnymi operacjami matematycznymi.
@@ -18,6 +116,16 @@ public:
    */
   explicit Matrix(int n);
 
+  /**
+   * @brief Konstruktor alokujący macierz n x n bez zerowania elementów.
+   *
+   * Elementy mają nieokreślone wartości, więc macierz musi zostać w całości
+   * nadpisana przed odczytem. Pozwala to uniknąć jednego przejścia po pamięci.
+   *
+   * @param n Rozmiar macierzy.
+   */
+  Matrix(int n, BezZerowania);
+
   /**
    * @brief Konstruktor alokujący macierz i kopiujący dane z tabeli.
    * @param n Rozmiar macierzy.
@@ -26,10 +134,16 @@ public:
   Matrix(int n, int* t);
 
   /**
-   * @brief Konstruktor kopiujący.
+   * @brief Konstruktor kopiujący, współdzieli dane z m aż do pierwszej modyfikacji.
    * @param m Referencja do kopiowanej macierzy.
    */
-  Matrix(Matrix& m);
+  Matrix(const Matrix& m);
+
+  /**
+   * @brief Konstruktor przenoszący, przejmuje dane macierzy m.
+   * @param m Przenoszona macierz.
+   */
+  Matrix(Matrix&& m) noexcept;
 
   /**
    * @brief Destruktor zwalniający pamięć.
@@ -43,6 +157,32 @@ public:
    */
   void alokuj(int n);
 
+  /**
+   * @brief Zmienia rozmiar macierzy, zachowując wspólny lewy górny blok.
+   *
+   * Nowe elementy są zerami. Jeśli bufor nie jest współdzielony i ma wystarczającą
+   * pojemność, wiersze przesuwane są w miejscu, bez alokacji, więc pętle zmieniające
+   * rozmiar w granicach pojemności nie korzystają z alokatora.
+   * Niezaalokowana macierz jest po prostu alokowana.
+   *
+   * @param n Nowy rozmiar macierzy.
+   * @return Referencja do bieżącego obiektu.
+   */
+  Matrix& zmien_rozmiar(int n);
+
+  /**
+   * @brief Zapewnia pojemność bufora na macierz n x n bez zmiany rozmiaru i zawartości.
+   * @param n Rozmiar, dla którego rezerwowana jest pamięć.
+   * @return Referencja do bieżącego obiektu.
+   */
+  Matrix& rezerwuj(int n);
+
+  /**
+   * @brief Zwraca pojemność bufora danych.
+   * @return Liczba elementów, które bufor może przechowywać (0 bez alokacji).
+   */
+  long pojemnosc(void) const { return mag != nullptr ? mag->pojemnosc : 0; }
+
   /**
    * @brief Wstawia wartość do macierzy na określonej pozycji.
    * @param x Wiersz.
@@ -60,6 +200,376 @@ public:
    */
   int pokaz(int x, int y);
 
+  /**
+   * @brief Zwraca rozmiar macierzy.
+   * @return Liczba wierszy (i kolumn) macierzy.
+   */
+  int rozmiar(void) const { return size; }
+
+  /**
+   * @brief Zwraca 64-bitowy skrót zawartości macierzy.
+   *
+   * Skrót liczony jest raz i zapamiętywany we współdzielonym buforze, więc kopie
+   * macierzy nie liczą go ponownie. Każda modyfikacja przez metody klasy unieważnia go.
+   * Zapis przez referencję lub widok pobrany przed obliczeniem skrótu nie jest wykrywany.
+   *
+   * @return Skrót zawartości (nigdy 0).
+   */
+  uint64_t skrot(void) const;
+
+  /**
+   * @brief Włącza śledzenie zmienionych wierszy i kolumn.
+   *
+   * Od tej chwili każda modyfikacja otrzymuje kolejny numer wersji, a zmienione
+   * wiersze i kolumny zapamiętują numer swojej ostatniej zmiany. Kopie macierzy
+   * nie przejmują śledzenia.
+   */
+  void sledz_zmiany(void);
+
+  /**
+   * @brief Zwraca numer wersji ostatniej modyfikacji.
+   * @return Numer wersji (0, gdy śledzenie jest wyłączone lub nie było zmian).
+   */
+  uint64_t wersja(void) const;
+
+  /**
+   * @brief Zwraca wiersze zmienione po podanej wersji.
+   *
+   * Każdy element zmieniony po wersji od leży w jednym ze zwróconych wierszy.
+   * Bez śledzenia zwracane są wszystkie wiersze.
+   *
+   * @param od Numer wersji, od której liczone są zmiany.
+   * @return Rosnące numery wierszy.
+   */
+  std::vector<int> zmienione_wiersze(uint64_t od) const;
+
+  /**
+   * @brief Zwraca kolumny zmienione po podanej wersji.
+   *
+   * Każdy element zmieniony po wersji od leży w jednej ze zwróconych kolumn.
+   * Bez śledzenia zwracane są wszystkie kolumny.
+   *
+   * @param od Numer wersji, od której liczone są zmiany.
+   * @return Rosnące numery kolumn.
+   */
+  std::vector<int> zmienione_kolumny(uint64_t od) const;
+
+  /**
+   * @brief Zwraca wskaźnik na dane macierzy przechowywane wierszami.
+   * @return Wskaźnik tylko do odczytu na pierwszy element lub nullptr.
+   */
+  const int* dane(void) const { return data; }
+
+  /**
+   * @brief Zwraca element (x, y) bez sprawdzania zakresu w wersji produkcyjnej.
+   *
+   * Jedyna wersja operatora jest stała, więc odczyt z niestałej macierzy nie kopiuje
+   * współdzielonego bufora ani nie oznacza elementu jako zmienionego. Zapis odbywa
+   * się przez element(), wstaw() lub widoki do zapisu.
+   * Indeksy sprawdzane są tylko w kompilacji debugowej (bez NDEBUG).
+   *
+   * @param x Wiersz.
+   * @param y Kolumna.
+   * @return Wartość elementu.
+   */
+  int operator()(int x, int y) const {
+    assert(x >= 0 && x < size && y >= 0 && y < size);
+    return data[static_cast<long>(x) * size + y];
+  }
+
+  /**
+   * @brief Zwraca referencję do elementu (x, y) do zapisu bez sprawdzania zakresu w wersji produkcyjnej.
+   *
+   * Każde wywołanie sprawdza, czy bufor jest współdzielony, i zapisuje zmianę
+   * elementu, co uniemożliwia wektoryzację pętli. Pętle zapisujące wiele
+   * elementów powinny raz pobrać widok_zapisu() lub widok_wiersza_do_zapisu().
+   *
+   * @param x Wiersz.
+   * @param y Kolumna.
+   * @return Referencja do elementu.
+   */
+  int& element(int x, int y) {
+    assert(x >= 0 && x < size && y >= 0 && y < size);
+    odlacz();
+    zmieniono(x, y);
+    return data[static_cast<long>(x) * size + y];
+  }
+
+  /**
+   * @brief Zwraca widok całej macierzy do zapisu.
+   *
+   * Współdzielony bufor kopiowany jest, a zmiana wszystkich elementów zapisywana,
+   * raz przy pobraniu widoku, więc pętle po w(x, y) nie mają narzutu na element
+   * i mogą się wektoryzować. Widok traci ważność po zmianie rozmiaru macierzy
+   * lub jej skopiowaniu (kopia współdzieliłaby bufor).
+   *
+   * @return Widok elementów.
+   */
+  WidokMacierzy<int> widok_zapisu(void) {
+    odlacz();
+    zmieniono();
+    return {data, size};
+  }
+
+  /**
+   * @brief Zwraca ciągły widok wiersza y tylko do odczytu.
+   * @param y Numer wiersza.
+   * @return Widok size elementów wiersza.
+   */
+  std::span<const int> widok_wiersza(int y) const {
+    assert(y >= 0 && y < size);
+    return {data + static_cast<long>(y) * size, static_cast<size_t>(size)};
+  }
+
+  /**
+   * @brief Zwraca ciągły widok wiersza y do zapisu.
+   * @param y Numer wiersza.
+   * @return Widok size elementów wiersza.
+   */
+  std::span<int> widok_wiersza_do_zapisu(int y) {
+    assert(y >= 0 && y < size);
+    odlacz();
+    zmieniono(y, WSZYSTKIE);
+    return {data + static_cast<long>(y) * size, static_cast<size_t>(size)};
+  }
+
+  /**
+   * @brief Zwraca widok kolumny x (elementy co size pozycji) tylko do odczytu.
+   * @param x Numer kolumny.
+   * @return Widok kolumny.
+   */
+  WidokKolumny<const int> widok_kolumny(int x) const {
+    assert(x >= 0 && x < size);
+    return {data + x, size, size};
+  }
+
+  /**
+   * @brief Zwraca widok kolumny x (elementy co size pozycji) do zapisu.
+   * @param x Numer kolumny.
+   * @return Widok kolumny.
+   */
+  WidokKolumny<int> widok_kolumny_do_zapisu(int x) {
+    assert(x >= 0 && x < size);
+    odlacz();
+    zmieniono(WSZYSTKIE, x);
+    return {data + x, size, size};
+  }
+
+  /**
+   * @brief Zwraca sumę wszystkich elementów.
+   *
+   * Redukcje liczone są równolegle blokami wierszy. Sumy całkowite akumulowane są
+   * w typie 64-bitowym (bez przepełnienia dla rozmiarów do 65535), więc wynik jest
+   * dokładny i nie zależy od liczby wątków.
+   *
+   * @return Suma elementów.
+   */
+  long long suma(void) const;
+
+  /**
+   * @brief Zwraca sumy elementów kolejnych wierszy.
+   * @return Wektor size sum.
+   */
+  std::vector<long long> sumy_wierszy(void) const;
+
+  /**
+   * @brief Zwraca sumy elementów kolejnych kolumn.
+   * @return Wektor size sum.
+   */
+  std::vector<long long> sumy_kolumn(void) const;
+
+  /**
+   * @brief Zwraca najmniejszy element i jego położenie.
+   * @return Pierwszy (w kolejności wierszy) najmniejszy element.
+   */
+  PozycjaElementu minimum(void) const;
+
+  /**
+   * @brief Zwraca największy element i jego położenie.
+   * @return Pierwszy (w kolejności wierszy) największy element.
+   */
+  PozycjaElementu maksimum(void) const;
+
+  /**
+   * @brief Zwraca ślad macierzy.
+   * @return Suma elementów przekątnej.
+   */
+  long long slad(void) const;
+
+  /**
+   * @brief Zwraca normę kolumnową.
+   * @return Największa suma modułów elementów kolumny.
+   */
+  long long norma_1(void) const;
+
+  /**
+   * @brief Zwraca normę wierszową.
+   * @return Największa suma modułów elementów wiersza.
+   */
+  long long norma_nieskonczonosc(void) const;
+
+  /**
+   * @brief Zwraca normę Frobeniusa.
+   *
+   * Kwadraty sumowane są w ustalonej kolejności (najpierw w wierszach, potem wiersz
+   * po wierszu), więc wynik jest powtarzalny przy dowolnej liczbie wątków.
+   *
+   * @return Pierwiastek z sumy kwadratów elementów.
+   */
+  double norma_frobeniusa(void) const;
+
+  /**
+   * @brief Liczy wszystkie powyższe redukcje jednym przejściem po danych.
+   * @return Suma, ślad, minimum, maksimum i normy macierzy.
+   */
+  Statystyki statystyki(void) const;
+
+  /**
+   * @brief Zastępuje każdy element wynikiem złożenia przekształceń.
+   *
+   * Przekształcenia stosowane są po kolei do każdego elementu w jednym przejściu
+   * po danych, np. map_inplace(f, g) daje g(f(x)). Funkcje są rozwijane w miejscu
+   * wywołania, więc pętla wektoryzuje się, gdy przekształcenia nie mają rozgałęzień
+   * (np. min/max zamiast if). Duże macierze przetwarzane są blokami wierszy w wielu
+   * wątkach, dlatego przekształcenia nie powinny mieć efektów ubocznych.
+   *
+   * @param f Przekształcenia int -> int.
+   * @return Referencja do bieżącego obiektu.
+   */
+  template <typename... F>
+  Matrix& map_inplace(F... f) {
+    if (!data) {
+      cerr << "Pamięć dla macierzy nie została zaalokowana. Najpierw zaalokuj pamięć." << endl;
+      return *this;
+    }
+
+    odlacz();
+    zmieniono();
+    int* d = data;
+    const long n = size;
+    rownolegle_wiersze(size, size, [=](int y0, int y1) {
+      for (long i = y0 * n; i < y1 * n; ++i) {
+        int v = d[i];
+        ((v = static_cast<int>(f(v))), ...);
+        d[i] = v;
+      }
+    });
+    return *this;
+  }
+
+  /**
+   * @brief Tworzy macierz z przekształconych elementów bieżącej macierzy.
+   * @param f Przekształcenia int -> int stosowane po kolei (jak w map_inplace()).
+   * @return Nowa macierz.
+   */
+  template <typename... F>
+  Matrix map(F... f) const {
+    if (!data) {
+      cerr << "Pamięć dla macierzy nie została zaalokowana. Najpierw zaalokuj pamięć." << endl;
+      return Matrix();
+    }
+
+    Matrix wynik(size, bez_zerowania);
+    const int* a = data;
+    int* d = wynik.data;
+    const long n = size;
+    rownolegle_wiersze(size, size, [=](int y0, int y1) {
+      for (long i = y0 * n; i < y1 * n; ++i) {
+        int v = a[i];
+        ((v = static_cast<int>(f(v))), ...);
+        d[i] = v;
+      }
+    });
+    return wynik;
+  }
+
+  /**
+   * @brief Zastępuje każdy element wynikiem funkcji dwóch argumentów.
+   *
+   * Element (x, y) staje się g(...(f(A(x, y), B(x, y)))), gdzie A to bieżąca macierz.
+   *
+   * @param b Druga macierz tego samego rozmiaru.
+   * @param f Funkcja (int, int) -> int.
+   * @param g Kolejne przekształcenia int -> int wyniku f.
+   * @return Referencja do bieżącego obiektu.
+   */
+  template <typename F, typename... G>
+  Matrix& zip_inplace(const Matrix& b, F f, G... g) {
+    if (!data || !b.data) {
+      cerr << "Pamięć dla macierzy nie została zaalokowana. Najpierw zaalokuj pamięć." << endl;
+      return *this;
+    }
+    if (size != b.size) {
+      cerr << "Macierze mają różne rozmiary, nie można ich połączyć." << endl;
+      return *this;
+    }
+
+    odlacz();
+    zmieniono();
+    int* d = data;
+    const int* e = b.data;
+    const long n = size;
+    rownolegle_wiersze(size, size, [=](int y0, int y1) {
+      for (long i = y0 * n; i < y1 * n; ++i) {
+        int v = static_cast<int>(f(d[i], e[i]));
+        ((v = static_cast<int>(g(v))), ...);
+        d[i] = v;
+      }
+    });
+    return *this;
+  }
+
+  /**
+   * @brief Tworzy macierz z elementów f(A(x, y), B(x, y)).
+   * @param a Pierwsza macierz.
+   * @param b Druga macierz tego samego rozmiaru.
+   * @param f Funkcja (int, int) -> int.
+   * @param g Kolejne przekształcenia int -> int wyniku f.
+   * @return Nowa macierz (niezaalokowana przy błędzie).
+   */
+  template <typename F, typename... G>
+  friend Matrix zip(const Matrix& a, const Matrix& b, F f, G... g) {
+    if (!a.data || !b.data) {
+      cerr << "Pamięć dla macierzy nie została zaalokowana. Najpierw zaalokuj pamięć." << endl;
+      return Matrix();
+    }
+    if (a.size != b.size) {
+      cerr << "Macierze mają różne rozmiary, nie można ich połączyć." << endl;
+      return Matrix();
+    }
+
+    Matrix wynik(a.size, bez_zerowania);
+    const int* p = a.data;
+    const int* q = b.data;
+    int* d = wynik.data;
+    const long n = a.size;
+    rownolegle_wiersze(a.size, a.size, [=](int y0, int y1) {
+      for (long i = y0 * n; i < y1 * n; ++i) {
+        int v = static_cast<int>(f(p[i], q[i]));
+        ((v = static_cast<int>(g(v))), ...);
+        d[i] = v;
+      }
+    });
+    return wynik;
+  }
+
+  /**
+   * @brief Kopiuje wskazane wiersze jeden za drugim do tablicy.
+   * @param wiersze Numery kopiowanych wierszy.
+   * @param k Liczba wierszy.
+   * @param t Tablica na k * size elementów.
+   */
+  void gather_rows(const int* wiersze, int k, int* t) const;
+
+  /**
+   * @brief Wypełnia wskazane kolumny danymi z tablicy.
+   * @param kolumny Numery wypełnianych kolumn.
+   * @param k Liczba kolumn.
+   * @param t Tablica size x k zapisana wierszami (wiersz i zawiera elementy wiersza i kolejnych kolumn).
+   * @return Referencja do bieżącego obiektu.
+   */
+  Matrix& scatter_cols(const int* kolumny, int k, const int* t);
+
   /**
    * @brief Transponuje macierz (zamienia wiersze z kolumnami).
    * @return Referencja do bieżącego obiektu.
@@ -147,6 +657,93 @@ public:
    * @return Wynikowa macierz.
    */
   Matrix& operator*(Matrix& m);
+
+  /**
+   * @brief Mnoży dwie macierze nad wskazanym półpierścieniem (np. min-plus dla najkrótszych ścieżek).
+   * @param m Macierz do mnożenia.
+   * @param p Półpierścień (Polpierscien.hpp).
+   * @return Wynikowa macierz.
+   */
+  Matrix& iloczyn(Matrix& m, Polpierscien p);
+
+  /**
+   * @brief Podnosi macierz do potęgi k nad wskazanym półpierścieniem (szybkie potęgowanie).
+   * @param k Wykładnik (0 daje jedynkę półpierścienia na przekątnej i zero poza nią).
+   * @param p Półpierścień (Polpierscien.hpp).
+   * @return Wynikowa macierz.
+   */
+  Matrix& potega(int k, Polpierscien p);
+
+  /**
+   * @brief Mnoży macierz element po elemencie przez macierz m (iloczyn Hadamarda).
+   * @param m Macierz tego samego rozmiaru.
+   * @return Referencja do bieżącego obiektu.
+   */
+  Matrix& hadamard(const Matrix& m);
+
+  /**
+   * @brief Tworzy iloczyn Kroneckera bieżącej macierzy i macierzy b.
+   *
+   * Wiersz wyniku składa się z kolejnych wierszy b przemnożonych przez elementy
+   * jednego wiersza bieżącej macierzy, więc wynik zapisywany jest sekwencyjnie,
+   * wiersz po wierszu, bez wielokrotnego odwiedzania tych samych linii pamięci.
+   * Do samego mnożenia przez wektor wystarczy IloczynKroneckera, który nie tworzy wyniku.
+   *
+   * @param b Prawy czynnik.
+   * @return Macierz o rozmiarze rozmiar() * b.rozmiar() (niezaalokowana przy błędzie).
+   */
+  Matrix kronecker(const Matrix& b) const;
+
+  /**
+   * @brief Permutuje wiersze w miejscu: wiersz i otrzymuje dawny wiersz p[i] (P * A).
+   *
+   * Elementy przesuwane są wzdłuż cykli permutacji, więc poza macierzą potrzebny
+   * jest tylko bufor na jeden wiersz. Wątki przesuwają rozłączne zakresy kolumn.
+   *
+   * @param p Permutacja o rozmiarze macierzy.
+   * @return Referencja do bieżącego obiektu.
+   */
+  Matrix& permutuj_wiersze(const Permutation& p);
+
+  /**
+   * @brief Permutuje kolumny w miejscu: kolumna j otrzymuje dawną kolumnę p[j] (A * P^T).
+   *
+   * Wiersze kopiowane są paskami mieszczącymi się w pamięci podręcznej do bufora
+   * wątku i odczytywane z niego kafelkami kolumn, więc zapisy do macierzy są ciągłe.
+   * Wątki dostają rozłączne bloki wierszy.
+   *
+   * @param p Permutacja o rozmiarze macierzy.
+   * @return Referencja do bieżącego obiektu.
+   */
+  Matrix& permutuj_kolumny(const Permutation& p);
+
+  /**
+   * @brief Permutuje symetrycznie wiersze i kolumny (P * A * P^T), np. według Permutation::odwrotny_cuthill_mckee().
+   * @param p Permutacja o rozmiarze macierzy.
+   * @return Referencja do bieżącego obiektu.
+   */
+  Matrix& permutuj(const Permutation& p);
+
+  /**
+   * @brief Zwraca szerokość pasma macierzy.
+   * @return Największe |i - j| wśród niezerowych elementów (0 dla macierzy diagonalnej).
+   */
+  int pasmo(void) const;
+
+  /**
+   * @brief Mnoży macierz przez niejawną macierz wzorcową w czasie O(n^2).
+   * @param w Macierz wzorcowa (jednostkowa, trójkątna z jedynek lub szachownica).
+   * @return Wynikowa macierz.
+   */
+  Matrix& operator*(const PatternMatrix& w);
+
+  /**
+   * @brief Mnoży macierz przez spakowaną macierz trójkątną, pomijając jej zerową połowę.
+   * @param t Macierz trójkątna.
+   * @return Wynikowa macierz.
+   */
+  Matrix& operator*(const TriangularMatrix<int>& t);
+
   /**
    * @brief Dodaje do macierzy skalar.
    * @param a Skalar do dodania.
@@ -274,7 +871,8 @@ public:
   /**
    * @brief Operator przypisania dla macierzy.
    *
-   * Kopiuje wartości z jednej macierzy do drugiej, alokując odpowiednią pamięć.
+   * Kopiuje wartości z jednej macierzy do drugiej. Bufor danych jest współdzielony
+   * i kopiowany dopiero przy pierwszej modyfikacji którejkolwiek z macierzy.
    * W przypadku przypisania do samego siebie operator nie wykonuje żadnych operacji.
    *
    * @param m Macierz, której wartości mają zostać przypisane.
@@ -282,6 +880,13 @@ public:
    */
   Matrix& operator=(const Matrix &m);
 
+  /**
+   * @brief Przenoszący operator przypisania.
+   * @param m Macierz, której dane zostają przejęte.
+   * @return Referencja do bieżącego obiektu po przypisaniu.
+   */
+  Matrix& operator=(Matrix&& m) noexcept;
+
   /**
    * @brief Operator odejmowania dwóch macierzy.
    *
@@ -294,6 +899,120 @@ public:
   Matrix& operator-(Matrix &m);
 
 private:
-  int *data; /**< Wskaźnik na dane macierzy. */
-  int size;  /**< Rozmiar macierzy. */
+  friend class ConcurrentMatrix;
+  friend class IloczynPrzyrostowy;
+  template <int N> friend class FixedMatrix;
+  friend Matrix operator*(const PatternMatrix& w, const Matrix& m);
+  friend Matrix operator*(const TriangularMatrix<int>& t, const Matrix& m);
+  friend Matrix operator*(const SymmetricMatrix<int>& s, const Matrix& m);
+
+  /**
+   * @brief Tworzy macierz korzystającą z cudzego bufora bez kopiowania elementów.
+   *
+   * Bufor nie jest zwalniany przez macierz; wlasciciel utrzymuje go przy życiu, dopóki
+   * istnieje którakolwiek kopia. Pierwsza modyfikacja kopiuje elementy do własnego bufora.
+   *
+   * @param n Rozmiar macierzy.
+   * @param dane Elementy macierzy przechowywane wierszami.
+   * @param wlasciciel Obiekt odpowiedzialny za pamięć bufora.
+   */
+  Matrix(int n, const int* dane, std::shared_ptr<void> wlasciciel);
+
+  /**
+   * @brief Bufor danych współdzielony przez kopie macierzy (kopiowanie przy zapisie).
+   */
+  struct Magazyn {
+    std::atomic<long> licznik; /**< Liczba macierzy korzystających z bufora. */
+    long pojemnosc;            /**< Liczba elementów w buforze. */
+    int* dane;                 /**< Elementy macierzy. */
+    bool mapowany;             /**< Czy bufor zaalokowano przez mmap (duże macierze, NUMA). */
+    std::atomic<uint64_t> skrot; /**< Zapamiętany skrót zawartości, 0 oznacza brak. */
+    std::shared_ptr<void> wlasciciel; /**< Właściciel cudzego bufora (np. FixedMatrix) albo nullptr. */
+  };
+
+  /**
+   * @brief Tworzy nowy bufor na n x n elementów z licznikiem równym 1.
+   *
+   * Bufor rozmieszczany jest w węzłach NUMA zgodnie z polityka_numa().
+   *
+   * @param n Rozmiar macierzy.
+   * @param zeruj Czy elementy mają być zerami (false, gdy bufor zostanie w całości nadpisany).
+   * @return Wskaźnik na utworzony bufor.
+   */
+  static Magazyn* nowy_magazyn(int n, bool zeruj);
+
+  /**
+   * @brief Zmniejsza licznik odwołań i zwalnia bufor, gdy nikt z niego nie korzysta.
+   */
+  void zwolnij(void);
+
+  /**
+   * @brief Tworzy prywatną kopię danych, jeśli bufor jest współdzielony.
+   *
+   * Wywoływana przed każdą modyfikacją elementów macierzy, dlatego unieważnia też zapamiętany skrót.
+   * Cudzy bufor (widok pamięci wspólnej) jest zawsze kopiowany, bo nie wolno go zmieniać.
+   */
+  void odlacz(void) {
+    if (mag == nullptr) {
+      return;
+    }
+    if (mag->licznik.load(std::memory_order_acquire) > 1 || mag->wlasciciel) {
+      rozdziel();
+    } else if (mag->skrot.load(std::memory_order_relaxed) != 0) {
+      mag->skrot.store(0, std::memory_order_relaxed);
+    }
+  }
+
+  /**
+   * @brief Kopiuje dane współdzielonego bufora do nowego, prywatnego bufora.
+   */
+  void rozdziel(void);
+
+  /**
+   * @brief Zastępuje dane macierzy danymi macierzy m (bez kopiowania elementów).
+   * @param m Macierz tymczasowa o tym samym rozmiarze.
+   */
+  void przejmij(Matrix& m);
+
+  /**
+   * @brief Numery wersji ostatnich zmian wierszy i kolumn.
+   */
+  struct Zmiany {
+    uint64_t wersja = 0;              /**< Numer ostatnio nadanej wersji. */
+    uint64_t wszystkie_wiersze = 0;   /**< Wersja ostatniej zmiany dotyczącej każdego wiersza. */
+    uint64_t wszystkie_kolumny = 0;   /**< Wersja ostatniej zmiany dotyczącej każdej kolumny. */
+    std::vector<uint64_t> wiersze;    /**< Wersja ostatniej zmiany poszczególnych wierszy. */
+    std::vector<uint64_t> kolumny;    /**< Wersja ostatniej zmiany poszczególnych kolumn. */
+  };
+
+  /**
+   * @brief Oznacza wszystkie wiersze lub wszystkie kolumny w zmienione().
+   */
+  static constexpr int WSZYSTKIE = -1;
+
+  /**
+   * @brief Zapisuje zmianę wiersza x i kolumny y, jeśli śledzenie jest włączone.
+   *
+   * WSZYSTKIE w miejscu numeru oznacza, że zmiana mogła dotyczyć każdego wiersza (kolumny).
+   *
+   * @param x Zmieniony wiersz.
+   * @param y Zmieniona kolumna.
+   */
+  void zmieniono(int x = WSZYSTKIE, int y = WSZYSTKIE) {
+    if (zmiany != nullptr) {
+      oznacz(x, y);
+    }
+  }
+
+  /**
+   * @brief Nadaje nową wersję i zapisuje ją dla zmienionych wierszy i kolumn.
+   * @param x Zmieniony wiersz lub WSZYSTKIE.
+   * @param y Zmieniona kolumna lub WSZYSTKIE.
+   */
+  void oznacz(int x, int y);
+
+  Magazyn *mag;    /**< Bufor danych, współdzielony między kopiami. */
+  int *data;       /**< Wskaźnik na dane macierzy. */
+  int size;        /**< Rozmiar macierzy. */
+  Zmiany *zmiany;  /**< Śledzenie zmian albo nullptr, gdy jest wyłączone. */
 };
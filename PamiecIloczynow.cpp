@@ -0,0 +1,163 @@
+#include "PamiecIloczynow.hpp"
+#include <algorithm> // dla funkcji copy() i equal()
+using namespace std;
+
+namespace {
+
+atomic<PamiecIloczynow*> aktywna{nullptr}; /**< Pamięć używana przez operator*(Matrix&). */
+
+/**
+ * @brief Kopiuje elementy macierzy do nowego, niewspółdzielonego bufora.
+ *
+ * Kopia współdzieląca bufor czynnika widziałaby zapisy przez widoki pobrane wcześniej
+ * (np. widok_zapisu()), a zapamiętany czynnik musi zachować stan z chwili mnożenia.
+ *
+ * @param m Kopiowana macierz.
+ * @return Macierz z własnym buforem.
+ */
+Matrix kopia_elementow(const Matrix& m) {
+    Matrix k(m.rozmiar(), bez_zerowania);
+    const long n = static_cast<long>(m.rozmiar()) * m.rozmiar();
+    copy(m.dane(), m.dane() + n, k.widok_zapisu().dane);
+    return k;
+}
+
+/**
+ * @brief Porównuje elementy dwóch macierzy, nawet gdy dzielą bufor.
+ *
+ * @param a Pierwsza macierz.
+ * @param b Druga macierz.
+ * @return true, jeśli mają ten sam rozmiar i te same elementy.
+ */
+bool te_same_elementy(const Matrix& a, const Matrix& b) {
+    const long n = static_cast<long>(a.rozmiar()) * a.rozmiar();
+    return a.rozmiar() == b.rozmiar() && equal(a.dane(), a.dane() + n, b.dane());
+}
+
+} // namespace
+
+/**
+ * @brief Tworzy pustą pamięć iloczynów.
+ *
+ * @param budzet_bajtow Maksymalna łączna wielkość zapamiętanych macierzy.
+ */
+PamiecIloczynow::PamiecIloczynow(long budzet_bajtow) : budzet_bajtow(budzet_bajtow) {}
+
+/**
+ * @brief Szuka zapamiętanego iloczynu a * b.
+ *
+ * Przy trafieniu wpis przenoszony jest na początek listy LRU. Czynniki porównywane są
+ * z zapamiętanymi element po elemencie: skrót bieżącego czynnika może być nieaktualny
+ * po zapisie przez wcześniej pobrany widok, więc sam klucz nie wystarcza.
+ *
+ * @param a Lewy czynnik.
+ * @param b Prawy czynnik.
+ * @param wynik Ustawiany na zapamiętany iloczyn przy trafieniu.
+ * @return true przy trafieniu.
+ */
+bool PamiecIloczynow::znajdz(const Matrix& a, const Matrix& b, Matrix& wynik) {
+    pair<uint64_t, uint64_t> klucz(a.skrot(), b.skrot());
+
+    lock_guard<mutex> l(blokada);
+    auto it = indeks.find(klucz);
+    if (it == indeks.end() || !te_same_elementy(it->second->a, a) || !te_same_elementy(it->second->b, b)) {
+        chybien.fetch_add(1, memory_order_relaxed);
+        return false;
+    }
+
+    kolejnosc.splice(kolejnosc.begin(), kolejnosc, it->second);
+    wynik = it->second->wynik;
+    trafien.fetch_add(1, memory_order_relaxed);
+    return true;
+}
+
+/**
+ * @brief Zapamiętuje iloczyn a * b.
+ *
+ * Wpis o tym samym kluczu jest zastępowany. Wyniki większe niż cały budżet nie są zapamiętywane.
+ * Czynniki zapamiętywane są jako kopie elementów, więc pamięć nie współdzieli ich buforów
+ * i nie zmienia zachowania widoków, które wywołujący już posiada.
+ *
+ * @param a Lewy czynnik.
+ * @param b Prawy czynnik.
+ * @param wynik Iloczyn a * b.
+ */
+void PamiecIloczynow::zapamietaj(const Matrix& a, const Matrix& b, const Matrix& wynik) {
+    long bajty = 3 * static_cast<long>(wynik.rozmiar()) * wynik.rozmiar() * static_cast<long>(sizeof(int));
+    if (bajty > budzet_bajtow) {
+        return;
+    }
+    pair<uint64_t, uint64_t> klucz(a.skrot(), b.skrot());
+
+    lock_guard<mutex> l(blokada);
+    auto it = indeks.find(klucz);
+    if (it != indeks.end()) {
+        usun(it->second);
+    }
+    while (zajete + bajty > budzet_bajtow && !kolejnosc.empty()) {
+        usun(prev(kolejnosc.end()));
+    }
+
+    kolejnosc.push_front(Wpis{klucz, kopia_elementow(a), kopia_elementow(b), wynik, bajty});
+    indeks[klucz] = kolejnosc.begin();
+    zajete += bajty;
+}
+
+/**
+ * @brief Usuwa wszystkie wpisy.
+ */
+void PamiecIloczynow::wyczysc(void) {
+    lock_guard<mutex> l(blokada);
+    indeks.clear();
+    kolejnosc.clear();
+    zajete = 0;
+}
+
+/**
+ * @brief Zwraca liczbę zapamiętanych iloczynów.
+ *
+ * @return Liczba wpisów.
+ */
+int PamiecIloczynow::liczba_wpisow(void) const {
+    lock_guard<mutex> l(blokada);
+    return static_cast<int>(kolejnosc.size());
+}
+
+/**
+ * @brief Zwraca łączną wielkość zapamiętanych macierzy.
+ *
+ * @return Liczba bajtów.
+ */
+long PamiecIloczynow::zajete_bajty(void) const {
+    lock_guard<mutex> l(blokada);
+    return zajete;
+}
+
+/**
+ * @brief Usuwa wpis z listy i indeksu (wywoływana z założoną blokadą).
+ *
+ * @param it Usuwany wpis.
+ */
+void PamiecIloczynow::usun(list<Wpis>::iterator it) {
+    zajete -= it->bajty;
+    indeks.erase(it->klucz);
+    kolejnosc.erase(it);
+}
+
+/**
+ * @brief Włącza lub wyłącza zapamiętywanie wyników operator*(Matrix&).
+ *
+ * @param p Pamięć iloczynów albo nullptr.
+ */
+void ustaw_pamiec_iloczynow(PamiecIloczynow* p) {
+    aktywna.store(p, memory_order_release);
+}
+
+/**
+ * @brief Zwraca pamięć używaną przez operator*(Matrix&).
+ *
+ * @return Wskaźnik na pamięć albo nullptr.
+ */
+PamiecIloczynow* pamiec_iloczynow(void) {
+    return aktywna.load(memory_order_acquire);
+}
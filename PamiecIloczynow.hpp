@@ -0,0 +1,133 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include "Matrix.hpp"
+
+/**
+ * @class PamiecIloczynow
+ * @brief Ograniczona pamięć podręczna LRU wyników mnożenia macierzy.
+ *
+ * Kluczem jest para skrótów zawartości obu czynników (Matrix::skrot()). Przy trafieniu
+ * zapamiętane czynniki porównywane są z bieżącymi element po elemencie, więc ani kolizja
+ * skrótów, ani skrót nieaktualny po zapisie przez widok nie dają błędnego wyniku.
+ * Czynniki przechowywane są we własnych buforach, a wynik zwracany jest jako kopia
+ * współdzieląca bufor (kopiowanie przy zapisie).
+ *
+ * Pamięć jest opcjonalna: operator*(Matrix&) korzysta z niej tylko wtedy, gdy
+ * zostanie wskazana funkcją ustaw_pamiec_iloczynow().
+ */
+class PamiecIloczynow {
+public:
+  /**
+   * @brief Tworzy pustą pamięć o podanym budżecie.
+   * @param budzet_bajtow Maksymalna łączna wielkość zapamiętanych macierzy (czynników i wyników).
+   */
+  explicit PamiecIloczynow(long budzet_bajtow);
+
+  PamiecIloczynow(const PamiecIloczynow&) = delete;
+  PamiecIloczynow& operator=(const PamiecIloczynow&) = delete;
+
+  /**
+   * @brief Szuka zapamiętanego iloczynu a * b.
+   * @param a Lewy czynnik.
+   * @param b Prawy czynnik.
+   * @param wynik Ustawiany na zapamiętany iloczyn (bez kopiowania elementów), jeśli został znaleziony.
+   * @return true przy trafieniu.
+   */
+  bool znajdz(const Matrix& a, const Matrix& b, Matrix& wynik);
+
+  /**
+   * @brief Zapamiętuje iloczyn a * b, usuwając najdawniej używane wpisy ponad budżet.
+   * @param a Lewy czynnik.
+   * @param b Prawy czynnik.
+   * @param wynik Iloczyn a * b.
+   */
+  void zapamietaj(const Matrix& a, const Matrix& b, const Matrix& wynik);
+
+  /**
+   * @brief Usuwa wszystkie wpisy (liczniki trafień i chybień pozostają bez zmian).
+   */
+  void wyczysc(void);
+
+  /**
+   * @brief Zwraca liczbę trafień.
+   * @return Liczba wyszukiwań zakończonych znalezieniem wyniku.
+   */
+  long trafienia(void) const { return trafien.load(std::memory_order_relaxed); }
+
+  /**
+   * @brief Zwraca liczbę chybień.
+   * @return Liczba wyszukiwań zakończonych bez wyniku.
+   */
+  long chybienia(void) const { return chybien.load(std::memory_order_relaxed); }
+
+  /**
+   * @brief Zwraca liczbę zapamiętanych iloczynów.
+   * @return Liczba wpisów.
+   */
+  int liczba_wpisow(void) const;
+
+  /**
+   * @brief Zwraca łączną wielkość zapamiętanych macierzy.
+   * @return Liczba bajtów.
+   */
+  long zajete_bajty(void) const;
+
+  /**
+   * @brief Zwraca budżet pamięci.
+   * @return Maksymalna liczba bajtów.
+   */
+  long budzet(void) const { return budzet_bajtow; }
+
+private:
+  /**
+   * @brief Zapamiętany iloczyn wraz z czynnikami do weryfikacji trafienia.
+   */
+  struct Wpis {
+    std::pair<uint64_t, uint64_t> klucz; /**< Skróty czynników. */
+    Matrix a;                            /**< Kopia elementów lewego czynnika. */
+    Matrix b;                            /**< Kopia elementów prawego czynnika. */
+    Matrix wynik;                        /**< Iloczyn a * b. */
+    long bajty;                          /**< Wielkość trzech macierzy. */
+  };
+
+  /**
+   * @brief Funkcja skrótu dla pary skrótów czynników.
+   */
+  struct SkrotPary {
+    size_t operator()(const std::pair<uint64_t, uint64_t>& p) const {
+      return static_cast<size_t>(p.first ^ (p.second * 0x9E3779B97F4A7C15ULL));
+    }
+  };
+
+  /**
+   * @brief Usuwa wpis z listy i indeksu.
+   * @param it Usuwany wpis.
+   */
+  void usun(std::list<Wpis>::iterator it);
+
+  const long budzet_bajtow;                  /**< Maksymalna łączna wielkość wpisów. */
+  long zajete = 0;                           /**< Bieżąca łączna wielkość wpisów. */
+  std::list<Wpis> kolejnosc;                 /**< Wpisy od ostatnio do najdawniej używanego. */
+  std::unordered_map<std::pair<uint64_t, uint64_t>, std::list<Wpis>::iterator, SkrotPary> indeks; /**< Wpisy według klucza. */
+  mutable std::mutex blokada;                /**< Chroni listę, indeks i licznik zajętości. */
+  std::atomic<long> trafien{0};              /**< Licznik trafień. */
+  std::atomic<long> chybien{0};              /**< Licznik chybień. */
+};
+
+/**
+ * @brief Włącza zapamiętywanie wyników operator*(Matrix&) we wskazanej pamięci.
+ * @param p Pamięć iloczynów albo nullptr, aby wyłączyć zapamiętywanie.
+ */
+void ustaw_pamiec_iloczynow(PamiecIloczynow* p);
+
+/**
+ * @brief Zwraca pamięć używaną przez operator*(Matrix&).
+ * @return Wskaźnik na pamięć albo nullptr, jeśli zapamiętywanie jest wyłączone.
+ */
+PamiecIloczynow* pamiec_iloczynow(void);
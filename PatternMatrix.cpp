@@ -0,0 +1,187 @@
+#include "PatternMatrix.hpp"
+#include <iostream>
+#include <vector>
+#include <algorithm> // dla funkcji copy_n i fill_n
+using namespace std;
+
+/**
+ * @brief Wylicza element macierzy ze wzoru.
+ *
+ * @param x Indeks wiersza.
+ * @param y Indeks kolumny.
+ * @return Wartość elementu.
+ */
+int PatternMatrix::operator()(int x, int y) const {
+    switch (wzor) {
+    case Jednostkowa:
+        return x == y;
+    case PodPrzekatna:
+        return x > y;
+    case NadPrzekatna:
+        return x < y;
+    case Szachownica:
+        return (x + y) % 2;
+    }
+    return 0;
+}
+
+/**
+ * @brief Tworzy pełną macierz o wzorze bieżącego obiektu.
+ *
+ * @return Macierz wypełniona przez odpowiednią metodę klasy Matrix.
+ */
+Matrix PatternMatrix::materializuj(void) const {
+    Matrix m(size);
+
+    switch (wzor) {
+    case Jednostkowa:
+        m.przekatna();
+        break;
+    case PodPrzekatna:
+        m.pod_przekatna();
+        break;
+    case NadPrzekatna:
+        m.nad_przekatna();
+        break;
+    case Szachownica:
+        m.szachownica();
+        break;
+    }
+
+    return m;
+}
+
+/**
+ * @brief Oblicza C = W * B bez mnożenia przez zera wzoru.
+ *
+ * Wiersz i wyniku to suma wierszy B wybranych przez wiersz i wzoru:
+ * dla macierzy trójkątnych są to sumy prefiksowe (sufiksowe) wierszy B,
+ * a dla szachownicy suma wierszy nieparzystych albo parzystych.
+ *
+ * @param b Macierz B zapisana wierszami.
+ * @param c Tablica wynikowa.
+ */
+void PatternMatrix::mnoz_z_lewej(const int* b, int* c) const {
+    const long n = size;
+
+    switch (wzor) {
+    case Jednostkowa:
+        copy_n(b, n * n, c);
+        break;
+
+    case PodPrzekatna:
+        // c[i] = b[0] + ... + b[i - 1]
+        fill_n(c, n, 0);
+        for (long i = 1; i < n; ++i) {
+            for (long j = 0; j < n; ++j) {
+                c[i * n + j] = c[(i - 1) * n + j] + b[(i - 1) * n + j];
+            }
+        }
+        break;
+
+    case NadPrzekatna:
+        // c[i] = b[i + 1] + ... + b[n - 1]
+        fill_n(c + (n - 1) * n, n, 0);
+        for (long i = n - 2; i >= 0; --i) {
+            for (long j = 0; j < n; ++j) {
+                c[i * n + j] = c[(i + 1) * n + j] + b[(i + 1) * n + j];
+            }
+        }
+        break;
+
+    case Szachownica: {
+        // Wiersz parzysty to suma wierszy nieparzystych B i odwrotnie
+        vector<int> sumy(2 * n, 0);
+        for (long i = 0; i < n; ++i) {
+            int* s = &sumy[(i % 2) * n];
+            for (long j = 0; j < n; ++j) {
+                s[j] += b[i * n + j];
+            }
+        }
+        for (long i = 0; i < n; ++i) {
+            copy_n(&sumy[((i + 1) % 2) * n], n, c + i * n);
+        }
+        break;
+    }
+    }
+}
+
+/**
+ * @brief Oblicza C = B * W bez mnożenia przez zera wzoru.
+ *
+ * Każdy wiersz wyniku zależy tylko od tego samego wiersza B: dla macierzy
+ * trójkątnych są to jego sumy sufiksowe (prefiksowe), a dla szachownicy
+ * sumy elementów w kolumnach parzystych i nieparzystych.
+ *
+ * @param b Macierz B zapisana wierszami.
+ * @param c Tablica wynikowa.
+ */
+void PatternMatrix::mnoz_z_prawej(const int* b, int* c) const {
+    const long n = size;
+
+    if (wzor == Jednostkowa) {
+        copy_n(b, n * n, c);
+        return;
+    }
+
+    for (long i = 0; i < n; ++i) {
+        const int* bi = b + i * n;
+        int* ci = c + i * n;
+
+        switch (wzor) {
+        case PodPrzekatna:
+            // c[i][j] = b[i][j + 1] + ... + b[i][n - 1]
+            ci[n - 1] = 0;
+            for (long j = n - 2; j >= 0; --j) {
+                ci[j] = ci[j + 1] + bi[j + 1];
+            }
+            break;
+
+        case NadPrzekatna:
+            // c[i][j] = b[i][0] + ... + b[i][j - 1]
+            ci[0] = 0;
+            for (long j = 1; j < n; ++j) {
+                ci[j] = ci[j - 1] + bi[j - 1];
+            }
+            break;
+
+        case Szachownica: {
+            int parzyste = 0;
+            int nieparzyste = 0;
+            for (long j = 0; j < n; ++j) {
+                if (j % 2 == 0) {
+                    parzyste += bi[j];
+                } else {
+                    nieparzyste += bi[j];
+                }
+            }
+            for (long j = 0; j < n; ++j) {
+                ci[j] = j % 2 == 0 ? nieparzyste : parzyste;
+            }
+            break;
+        }
+
+        case Jednostkowa:
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Operator mnożenia macierzy wzorcowej przez zwykłą macierz.
+ *
+ * @param w Macierz wzorcowa.
+ * @param m Macierz mnożona.
+ * @return Nowa macierz W * m.
+ */
+Matrix operator*(const PatternMatrix& w, const Matrix& m) {
+    if (w.size != m.size) {
+        cerr << "Macierze mają różne rozmiary, nie można ich pomnożyć." << endl;
+        return Matrix(m);
+    }
+
+    Matrix result(m.size);
+    w.mnoz_z_lewej(m.data, result.data);
+
+    return result;
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "Matrix.hpp"
+
+/**
+ * @class PatternMatrix
+ * @brief Niejawna macierz o stałym wzorze, przechowująca jedynie rodzaj wzoru i rozmiar.
+ *
+ * Odpowiada wynikom Matrix::przekatna(), Matrix::pod_przekatna(), Matrix::nad_przekatna()
+ * i Matrix::szachownica(), ale nie zajmuje n * n elementów. Mnożenie przez taką macierz
+ * wykonywane jest specjalizowanymi jądrami o koszcie O(n^2) (np. sumy prefiksowe
+ * dla macierzy trójkątnej z jedynek), a pełna macierz powstaje tylko na żądanie.
+ */
+class PatternMatrix {
+public:
+  /**
+   * @brief Rodzaje obsługiwanych wzorów.
+   */
+  enum Wzor {
+    Jednostkowa,  /**< Jedynki na przekątnej. */
+    PodPrzekatna, /**< Jedynki poniżej przekątnej. */
+    NadPrzekatna, /**< Jedynki powyżej przekątnej. */
+    Szachownica   /**< 1 tam, gdzie suma indeksów jest nieparzysta. */
+  };
+
+  /**
+   * @brief Konstruktor niejawnej macierzy wzorcowej.
+   * @param wzor Rodzaj wzoru.
+   * @param n Rozmiar macierzy.
+   */
+  PatternMatrix(Wzor wzor, int n) : wzor(wzor), size(n) {}
+
+  /**
+   * @brief Zwraca rozmiar macierzy.
+   * @return Liczba wierszy (i kolumn) macierzy.
+   */
+  int rozmiar(void) const { return size; }
+
+  /**
+   * @brief Zwraca rodzaj wzoru.
+   * @return Wzór macierzy.
+   */
+  Wzor rodzaj(void) const { return wzor; }
+
+  /**
+   * @brief Wylicza element (x, y) ze wzoru.
+   * @param x Wiersz.
+   * @param y Kolumna.
+   * @return Wartość elementu (0 lub 1).
+   */
+  int operator()(int x, int y) const;
+
+  /**
+   * @brief Tworzy pełną macierz o tym samym wzorze.
+   * @return Zmaterializowana macierz.
+   */
+  Matrix materializuj(void) const;
+
+  /**
+   * @brief Oblicza C = W * B, gdzie W to bieżąca macierz wzorcowa.
+   * @param b Macierz B (size x size) zapisana wierszami.
+   * @param c Tablica wynikowa size x size.
+   */
+  void mnoz_z_lewej(const int* b, int* c) const;
+
+  /**
+   * @brief Oblicza C = B * W, gdzie W to bieżąca macierz wzorcowa.
+   * @param b Macierz B (size x size) zapisana wierszami.
+   * @param c Tablica wynikowa size x size.
+   */
+  void mnoz_z_prawej(const int* b, int* c) const;
+
+  /**
+   * @brief Mnoży macierz wzorcową przez zwykłą macierz (W * m).
+   * @param w Macierz wzorcowa.
+   * @param m Macierz mnożona.
+   * @return Nowa macierz z wynikiem.
+   */
+  friend Matrix operator*(const PatternMatrix& w, const Matrix& m);
+
+private:
+  Wzor wzor; /**< Rodzaj wzoru. */
+  int size;  /**< Rozmiar macierzy. */
+};
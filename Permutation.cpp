@@ -0,0 +1,275 @@
+#include "Permutation.hpp"
+#include "Matrix.hpp"
+#include <algorithm> // dla funkcji sort() i reverse()
+using namespace std;
+
+namespace {
+
+/**
+ * @brief Przechodzi wszerz spójną składową grafu.
+ *
+ * Sąsiedzi odwiedzani są w kolejności list sąsiedztwa (posortowanych według
+ * stopnia), więc kolejność odwiedzin jest uporządkowaniem Cuthilla-McKee.
+ *
+ * @param start Wierzchołek początkowy.
+ * @param sasiedzi Listy sąsiedztwa.
+ * @param znacznik Numer przejścia, w którym wierzchołek odwiedzono.
+ * @param numer Numer bieżącego przejścia.
+ * @param kolejka Odwiedzone wierzchołki w kolejności odwiedzin.
+ * @param poziom Odległość wierzchołka od startu.
+ * @return Mimośród startu (największy poziom).
+ */
+int przejdz_wszerz(int start, const vector<vector<int>>& sasiedzi, vector<int>& znacznik, int numer,
+                   vector<int>& kolejka, vector<int>& poziom) {
+    kolejka.clear();
+    kolejka.push_back(start);
+    znacznik[start] = numer;
+    poziom[start] = 0;
+    for (size_t i = 0; i < kolejka.size(); ++i) {
+        const int v = kolejka[i];
+        for (int u : sasiedzi[v]) {
+            if (znacznik[u] != numer) {
+                znacznik[u] = numer;
+                poziom[u] = poziom[v] + 1;
+                kolejka.push_back(u);
+            }
+        }
+    }
+    return poziom[kolejka.back()];
+}
+
+} // namespace
+
+/**
+ * @brief Tworzy permutację identycznościową.
+ *
+ * @param n Liczba elementów.
+ */
+Permutation::Permutation(int n) {
+    if (n < 0) {
+        cerr << "Rozmiar permutacji nie może być ujemny." << endl;
+        return;
+    }
+    p.resize(n);
+    for (int i = 0; i < n; ++i) {
+        p[i] = i;
+    }
+}
+
+/**
+ * @brief Tworzy permutację z tablicy indeksów źródłowych.
+ *
+ * @param indeksy Indeksy 0..n-1, każdy dokładnie raz.
+ */
+Permutation::Permutation(vector<int> indeksy) : p(move(indeksy)) {
+    const int n = rozmiar();
+    vector<char> uzyty(n, 0);
+    for (int v : p) {
+        if (v < 0 || v >= n || uzyty[v]) {
+            cerr << "Tablica nie jest permutacją liczb od 0 do " << n - 1 << "." << endl;
+            p.clear();
+            return;
+        }
+        uzyty[v] = 1;
+    }
+}
+
+/**
+ * @brief Zamienia pozycje i oraz j.
+ *
+ * @param i Pierwsza pozycja.
+ * @param j Druga pozycja.
+ * @return Referencja do bieżącej permutacji.
+ */
+Permutation& Permutation::zamien(int i, int j) {
+    if (i < 0 || i >= rozmiar() || j < 0 || j >= rozmiar()) {
+        cerr << "Indeksy poza zakresem. Indeksy muszą być w zakresie od 0 do " << rozmiar() - 1 << "." << endl;
+        return *this;
+    }
+    swap(p[i], p[j]);
+    return *this;
+}
+
+/**
+ * @brief Zwraca permutację odwrotną.
+ *
+ * @return Permutacja odwrotna.
+ */
+Permutation Permutation::odwrotna(void) const {
+    Permutation q;
+    q.p.resize(p.size());
+    for (int i = 0; i < rozmiar(); ++i) {
+        q.p[p[i]] = i;
+    }
+    return q;
+}
+
+/**
+ * @brief Składa permutacje.
+ *
+ * @param b Permutacja stosowana najpierw.
+ * @return Złożenie.
+ */
+Permutation Permutation::operator*(const Permutation& b) const {
+    if (b.rozmiar() != rozmiar()) {
+        cerr << "Permutacje mają różne rozmiary, nie można ich złożyć." << endl;
+        return Permutation();
+    }
+    Permutation r;
+    r.p.resize(p.size());
+    for (int i = 0; i < rozmiar(); ++i) {
+        r.p[i] = b.p[p[i]];
+    }
+    return r;
+}
+
+/**
+ * @brief Sprawdza, czy permutacja jest identycznością.
+ *
+ * @return true, jeśli p[i] = i dla każdego i.
+ */
+bool Permutation::jednostkowa(void) const {
+    for (int i = 0; i < rozmiar(); ++i) {
+        if (p[i] != i) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Zwraca znak permutacji.
+ *
+ * Permutacja złożona z c cykli (wliczając punkty stałe) jest iloczynem n - c transpozycji.
+ *
+ * @return 1 albo -1.
+ */
+int Permutation::znak(void) const {
+    const int n = rozmiar();
+    vector<char> odwiedzony(n, 0);
+    int cykle = 0;
+    for (int s = 0; s < n; ++s) {
+        if (odwiedzony[s]) {
+            continue;
+        }
+        ++cykle;
+        for (int i = s; !odwiedzony[i]; i = p[i]) {
+            odwiedzony[i] = 1;
+        }
+    }
+    return (n - cykle) % 2 == 0 ? 1 : -1;
+}
+
+/**
+ * @brief Tworzy gęstą macierz permutacji.
+ *
+ * @return Macierz P z jedynkami w (i, p[i]).
+ */
+Matrix Permutation::macierz(void) const {
+    if (p.empty()) {
+        return Matrix();
+    }
+    Matrix m(rozmiar());
+    for (int i = 0; i < rozmiar(); ++i) {
+        m.wstaw(i, p[i], 1);
+    }
+    return m;
+}
+
+/**
+ * @brief Wyznacza uporządkowanie odwrotne Cuthilla-McKee.
+ *
+ * Wierzchołek początkowy każdej składowej wybierany jest metodą George'a-Liu:
+ * zaczynając od wierzchołka o najmniejszym stopniu, przechodzi się do wierzchołka
+ * o najmniejszym stopniu z ostatniego poziomu przejścia wszerz, dopóki rośnie
+ * mimośród. Start na krańcu grafu daje wąskie poziomy, a więc wąskie pasmo.
+ *
+ * @param a Macierz kwadratowa.
+ * @return Permutacja.
+ */
+Permutation Permutation::odwrotny_cuthill_mckee(const Matrix& a) {
+    const int n = a.rozmiar();
+    const int* d = a.dane();
+    if (n == 0 || d == nullptr) {
+        cerr << "Pamięć dla macierzy nie została zaalokowana. Najpierw zaalokuj pamięć." << endl;
+        return Permutation();
+    }
+
+    vector<vector<int>> sasiedzi(n);
+    for (int i = 0; i < n; ++i) {
+        for (int j = i + 1; j < n; ++j) {
+            if (d[static_cast<long>(i) * n + j] != 0 || d[static_cast<long>(j) * n + i] != 0) {
+                sasiedzi[i].push_back(j);
+                sasiedzi[j].push_back(i);
+            }
+        }
+    }
+    auto stopien = [&](int v) { return sasiedzi[v].size(); };
+    for (auto& s : sasiedzi) {
+        sort(s.begin(), s.end(), [&](int u, int v) { return stopien(u) != stopien(v) ? stopien(u) < stopien(v) : u < v; });
+    }
+
+    vector<int> kolejnosc;
+    kolejnosc.reserve(n);
+    vector<char> odwiedzony(n, 0);
+    vector<int> znacznik(n, -1);
+    vector<int> poziom(n, 0);
+    vector<int> kolejka;
+    int numer = 0;
+
+    for (int s = 0; s < n; ++s) {
+        if (odwiedzony[s]) {
+            continue;
+        }
+
+        // Wierzchołek o najmniejszym stopniu w składowej zawierającej s
+        przejdz_wszerz(s, sasiedzi, znacznik, numer++, kolejka, poziom);
+        int start = s;
+        for (int v : kolejka) {
+            if (stopien(v) < stopien(start)) {
+                start = v;
+            }
+        }
+
+        int mimosrod = przejdz_wszerz(start, sasiedzi, znacznik, numer++, kolejka, poziom);
+        while (true) {
+            int kandydat = kolejka.back();
+            for (int v : kolejka) {
+                if (poziom[v] == mimosrod && stopien(v) < stopien(kandydat)) {
+                    kandydat = v;
+                }
+            }
+            int nowy = przejdz_wszerz(kandydat, sasiedzi, znacznik, numer++, kolejka, poziom);
+            if (nowy <= mimosrod) {
+                break;
+            }
+            start = kandydat;
+            mimosrod = nowy;
+        }
+
+        przejdz_wszerz(start, sasiedzi, znacznik, numer++, kolejka, poziom);
+        for (int v : kolejka) {
+            odwiedzony[v] = 1;
+            kolejnosc.push_back(v);
+        }
+    }
+
+    reverse(kolejnosc.begin(), kolejnosc.end());
+    return Permutation(move(kolejnosc));
+}
+
+/**
+ * @brief Wypisuje indeksy permutacji.
+ *
+ * @param os Strumień wyjściowy.
+ * @param p Permutacja.
+ * @return Strumień wyjściowy.
+ */
+ostream& operator<<(ostream& os, const Permutation& p) {
+    os << "[";
+    for (int i = 0; i < p.rozmiar(); ++i) {
+        os << (i > 0 ? " " : "") << p[i];
+    }
+    os << "]";
+    return os;
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <iostream>
+#include <vector>
+
+class Matrix;
+
+/**
+ * @class Permutation
+ * @brief Permutacja n elementów przechowywana w O(n) pamięci zamiast jako macierz n x n.
+ *
+ * Element i permutacji p to indeks źródłowy: zastosowana do wierszy macierzy
+ * (Matrix::permutuj_wiersze) umieszcza w wierszu i dawny wiersz p[i], czyli
+ * odpowiada mnożeniu z lewej przez macierz permutacji P z jedynkami w (i, p[i]).
+ * Złożenie a * b odpowiada iloczynowi macierzy P_a * P_b.
+ */
+class Permutation {
+public:
+  /**
+   * @brief Tworzy pustą permutację.
+   */
+  Permutation(void) = default;
+
+  /**
+   * @brief Tworzy permutację identycznościową.
+   * @param n Liczba elementów.
+   */
+  explicit Permutation(int n);
+
+  /**
+   * @brief Tworzy permutację z tablicy indeksów źródłowych.
+   * @param p Indeksy 0..n-1, każdy dokładnie raz (w przeciwnym razie powstaje pusta permutacja).
+   */
+  explicit Permutation(std::vector<int> p);
+
+  /**
+   * @brief Zwraca liczbę elementów.
+   * @return n.
+   */
+  int rozmiar(void) const { return static_cast<int>(p.size()); }
+
+  /**
+   * @brief Zwraca indeks źródłowy pozycji i (bez sprawdzania zakresu).
+   * @param i Pozycja.
+   * @return p[i].
+   */
+  int operator[](int i) const { return p[i]; }
+
+  /**
+   * @brief Zwraca indeksy źródłowe.
+   * @return Tablica p.
+   */
+  const std::vector<int>& indeksy(void) const { return p; }
+
+  /**
+   * @brief Zamienia pozycje i oraz j (np. przy wyborze elementu głównego).
+   * @param i Pierwsza pozycja.
+   * @param j Druga pozycja.
+   * @return Referencja do bieżącej permutacji.
+   */
+  Permutation& zamien(int i, int j);
+
+  /**
+   * @brief Zwraca permutację odwrotną.
+   * @return q, dla której q[p[i]] = i.
+   */
+  Permutation odwrotna(void) const;
+
+  /**
+   * @brief Składa permutacje.
+   * @param b Permutacja stosowana najpierw.
+   * @return Permutacja r[i] = b[p[i]], równoważna zastosowaniu b, a potem bieżącej.
+   */
+  Permutation operator*(const Permutation& b) const;
+
+  /**
+   * @brief Porównuje permutacje.
+   * @param b Druga permutacja.
+   * @return true, jeśli są identyczne.
+   */
+  bool operator==(const Permutation& b) const { return p == b.p; }
+
+  /**
+   * @brief Sprawdza, czy permutacja jest identycznością.
+   * @return true, jeśli p[i] = i dla każdego i.
+   */
+  bool jednostkowa(void) const;
+
+  /**
+   * @brief Zwraca znak permutacji.
+   * @return 1 dla permutacji parzystej, -1 dla nieparzystej.
+   */
+  int znak(void) const;
+
+  /**
+   * @brief Tworzy gęstą macierz permutacji.
+   * @return Macierz P z jedynkami w (i, p[i]).
+   */
+  Matrix macierz(void) const;
+
+  /**
+   * @brief Wyznacza uporządkowanie odwrotne Cuthilla-McKee zmniejszające szerokość pasma.
+   *
+   * Graf tworzą niezerowe elementy macierzy (symetryzowane). Każda spójna składowa
+   * przechodzona jest wszerz od wierzchołka pseudoperyferyjnego, z sąsiadami
+   * w kolejności rosnącego stopnia, a kolejność końcowa jest odwracana.
+   * Matrix::permutuj(p) daje wtedy macierz P A P^T o węższym paśmie.
+   *
+   * @param a Macierz kwadratowa.
+   * @return Permutacja (pusta dla niezaalokowanej macierzy).
+   */
+  static Permutation odwrotny_cuthill_mckee(const Matrix& a);
+
+  /**
+   * @brief Wypisuje indeksy permutacji.
+   * @param os Strumień wyjściowy.
+   * @param p Permutacja.
+   * @return Strumień wyjściowy.
+   */
+  friend std::ostream& operator<<(std::ostream& os, const Permutation& p);
+
+private:
+  std::vector<int> p; /**< Indeks źródłowy każdej pozycji. */
+};
@@ -0,0 +1,158 @@
+#pragma once
+
+#include <algorithm>
+#include <limits>
+#include "Gemm.hpp"
+
+/**
+ * @file Polpierscien.hpp
+ * @brief Mnożenie macierzy nad dowolnym półpierścieniem (min-plus, max-plus, logicznym, ...).
+ *
+ * Półpierścień opisany jest strukturą z funkcjami statycznymi zero(), jeden(), dodaj()
+ * i mnoz(). Zero jest elementem neutralnym dodawania i pochłaniającym mnożenia, więc
+ * jądro może pomijać zerowe elementy A tak samo jak zwykłe gemm. Wszystkie operacje
+ * są bez rozgałęzień (min, max, dodawanie i wybór wartości), dzięki czemu pętla
+ * najgłębsza wektoryzuje się do instrukcji wektorowych min/max.
+ */
+
+/**
+ * @brief Półpierścienie dostępne w Matrix::iloczyn() i Matrix::potega().
+ */
+enum class Polpierscien {
+  PlusRazy,    /**< Zwykłe (+, *). */
+  MinPlus,     /**< Tropikalny (min, +): najkrótsze ścieżki. */
+  MaxPlus,     /**< Tropikalny (max, +): najdłuższe ścieżki. */
+  MaxMin,      /**< (max, min): ścieżki o największej przepustowości. */
+  Logiczny,    /**< (OR, AND) na wartościach 0 i 1: osiągalność. */
+  Zliczajacy   /**< (+, *) na macierzy sąsiedztwa: liczba ścieżek. */
+};
+
+namespace polpierscienie {
+
+/**
+ * @brief Wartość oznaczająca brak krawędzi (nieskończoność) w półpierścieniach tropikalnych.
+ *
+ * Wagi przyjmowane są z przedziału [-NIESKONCZONOSC, NIESKONCZONOSC]: elementy spoza niego
+ * traktowane są jak jego końce (np. INT_MAX jako brak krawędzi w MinPlus), więc suma
+ * dwóch wag zawsze mieści się w int, a wyniki pozostają w tym samym przedziale.
+ */
+constexpr int NIESKONCZONOSC = std::numeric_limits<int>::max() / 2;
+
+/**
+ * @brief Przycina wagę do przedziału [-NIESKONCZONOSC, NIESKONCZONOSC].
+ * @param a Waga.
+ * @return Waga przycięta do przedziału, w którym suma dwóch wag mieści się w int.
+ */
+inline int przytnij(int a) { return std::clamp(a, -NIESKONCZONOSC, NIESKONCZONOSC); }
+
+/**
+ * @brief Zwykły półpierścień (+, *).
+ */
+struct PlusRazy {
+  static int zero(void) { return 0; }
+  static int jeden(void) { return 1; }
+  static int dodaj(int a, int b) { return a + b; }
+  static int mnoz(int a, int b) { return a * b; }
+};
+
+/**
+ * @brief Półpierścień (min, +) z nieskończonością NIESKONCZONOSC.
+ *
+ * Nieskończoność pochłania mnożenie także przy ujemnych wagach: brak krawędzi
+ * nie może stać się skończoną ścieżką.
+ */
+struct MinPlus {
+  static int zero(void) { return NIESKONCZONOSC; }
+  static int jeden(void) { return 0; }
+  static int dodaj(int a, int b) { return std::min(a, b); }
+  static int mnoz(int a, int b) {
+    int suma = std::clamp(przytnij(a) + przytnij(b), -NIESKONCZONOSC, NIESKONCZONOSC);
+    return a >= NIESKONCZONOSC || b >= NIESKONCZONOSC ? NIESKONCZONOSC : suma;
+  }
+};
+
+/**
+ * @brief Półpierścień (max, +) z minus nieskończonością -NIESKONCZONOSC.
+ *
+ * Minus nieskończoność pochłania mnożenie także przy dodatnich wagach.
+ */
+struct MaxPlus {
+  static int zero(void) { return -NIESKONCZONOSC; }
+  static int jeden(void) { return 0; }
+  static int dodaj(int a, int b) { return std::max(a, b); }
+  static int mnoz(int a, int b) {
+    int suma = std::clamp(przytnij(a) + przytnij(b), -NIESKONCZONOSC, NIESKONCZONOSC);
+    return a <= -NIESKONCZONOSC || b <= -NIESKONCZONOSC ? -NIESKONCZONOSC : suma;
+  }
+};
+
+/**
+ * @brief Półpierścień (max, min) dla przepustowości ścieżek.
+ */
+struct MaxMin {
+  static int zero(void) { return -NIESKONCZONOSC; }
+  static int jeden(void) { return NIESKONCZONOSC; }
+  static int dodaj(int a, int b) { return std::max(a, b); }
+  static int mnoz(int a, int b) { return std::min(a, b); }
+};
+
+/**
+ * @brief Półpierścień logiczny (OR, AND); każda wartość niezerowa oznacza prawdę.
+ */
+struct Logiczny {
+  static int zero(void) { return 0; }
+  static int jeden(void) { return 1; }
+  static int dodaj(int a, int b) { return a | b; }
+  static int mnoz(int a, int b) { return (a != 0) & (b != 0); }
+};
+
+/**
+ * @brief Półpierścień zliczający: iloczyn macierzy sąsiedztwa zlicza ścieżki.
+ */
+using Zliczajacy = PlusRazy;
+
+} // namespace polpierscienie
+
+/**
+ * @brief Wykonuje operację C = C (+) A (*) B nad półpierścieniem P na blokach jak gemm.
+ *
+ * @param m Liczba wierszy A i C.
+ * @param n Liczba kolumn B i C.
+ * @param k Liczba kolumn A i wierszy B.
+ * @param a Wskaźnik na macierz A.
+ * @param lda Odstęp między wierszami A.
+ * @param b Wskaźnik na macierz B.
+ * @param ldb Odstęp między wierszami B.
+ * @param c Wskaźnik na macierz wynikową C (zainicjowaną, np. wartością P::zero()).
+ * @param ldc Odstęp między wierszami C.
+ * @param bloki Rozmiary bloków (domyślnie bieżące ustawienia bloki_gemm()).
+ */
+template <typename P>
+void gemm_polpierscien(int m, int n, int k, const int* a, int lda, const int* b, int ldb, int* c, int ldc,
+                       BlokiGemm bloki = bloki_gemm()) {
+  const int zero = P::zero();
+
+  for (int ii = 0; ii < m; ii += bloki.i) {
+    int ik = ii + bloki.i < m ? ii + bloki.i : m;
+    for (int kk = 0; kk < k; kk += bloki.k) {
+      int kl = kk + bloki.k < k ? kk + bloki.k : k;
+      for (int jj = 0; jj < n; jj += bloki.j) {
+        int jk = jj + bloki.j < n ? jj + bloki.j : n;
+
+        for (int i = ii; i < ik; ++i) {
+          int* ci = c + static_cast<long>(i) * ldc;
+          for (int p = kk; p < kl; ++p) {
+            int aip = a[static_cast<long>(i) * lda + p];
+            if (aip == zero) {
+              continue; // Zero pochłania mnożenie i nie zmienia sumy
+            }
+            const int* bp = b + static_cast<long>(p) * ldb;
+            for (int j = jj; j < jk; ++j) {
+              ci[j] = P::dodaj(ci[j], P::mnoz(aip, bp[j]));
+            }
+          }
+        }
+      }
+    }
+  }
+}
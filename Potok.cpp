@@ -0,0 +1,181 @@
+#include "Potok.hpp"
+#include "Gemm.hpp"
+#include "Rownolegle.hpp"
+#include <algorithm> // dla funkcji copy() i min()
+#include <atomic>
+#include <memory>
+#include <thread>
+using namespace std;
+
+/**
+ * @brief Tworzy potok mnożący bloki przez macierz b.
+ *
+ * @param b Macierz przechowywana w pamięci.
+ * @param pojemnosc Pojemność kolejek między etapami.
+ */
+PotokMnozenia::PotokMnozenia(const Matrix& b, int pojemnosc) : b(b), pojemnosc(pojemnosc > 0 ? pojemnosc : 1) {}
+
+/**
+ * @brief Przepuszcza wszystkie bloki źródła przez potok.
+ *
+ * Błąd w bloku zamyka obie kolejki, co budzi źródło czekające na miejsce
+ * i kończy potok bez przetwarzania dalszych bloków.
+ *
+ * @param zrodlo Źródło bloków.
+ * @param ujscie Ujście bloków iloczynu.
+ * @return Liczba przetworzonych wierszy albo -1 przy błędzie.
+ */
+long PotokMnozenia::przetworz(const ZrodloBlokow& zrodlo, const UjscieBlokow& ujscie) {
+    KolejkaOgraniczona<BlokWierszy> wejscie(pojemnosc);
+    KolejkaOgraniczona<BlokWierszy> wyjscie(pojemnosc);
+    atomic<bool> blad{false};
+
+    thread czytanie([&] {
+        for (;;) {
+            BlokWierszy blok;
+            if (!zrodlo(blok) || !wejscie.wstaw(move(blok))) {
+                break;
+            }
+        }
+        wejscie.zamknij();
+    });
+
+    thread liczenie([&] {
+        const int n = b.rozmiar();
+        BlokWierszy a;
+        while (wejscie.pobierz(a)) {
+            if (a.kolumny != n || static_cast<long>(a.dane.size()) < static_cast<long>(a.wiersze) * n) {
+                cerr << "Blok wierszy ma niewłaściwą liczbę kolumn, nie można go pomnożyć." << endl;
+                blad.store(true, memory_order_relaxed);
+                wejscie.zamknij();
+                break;
+            }
+
+            BlokWierszy c;
+            c.pierwszy = a.pierwszy;
+            c.wiersze = a.wiersze;
+            c.kolumny = n;
+            c.dane.assign(static_cast<long>(a.wiersze) * n, 0);
+            rownolegle_wiersze(a.wiersze, static_cast<long>(n) * n, [&](int y0, int y1) {
+                gemm(y1 - y0, n, n, 1, a.dane.data() + static_cast<long>(y0) * n, n, b.dane(), n,
+                     c.dane.data() + static_cast<long>(y0) * n, n);
+            });
+            if (!wyjscie.wstaw(move(c))) {
+                break;
+            }
+        }
+        wyjscie.zamknij();
+    });
+
+    long wiersze = 0;
+    BlokWierszy c;
+    while (wyjscie.pobierz(c)) {
+        ujscie(c);
+        wiersze += c.wiersze;
+    }
+
+    czytanie.join();
+    liczenie.join();
+    return blad.load(memory_order_relaxed) ? -1 : wiersze;
+}
+
+/**
+ * @brief Tworzy źródło czytające liczby ze strumienia.
+ *
+ * @param we Strumień wejściowy.
+ * @param kolumny Liczba elementów w wierszu.
+ * @param wiersze_w_bloku Liczba wierszy w bloku.
+ * @return Źródło bloków.
+ */
+ZrodloBlokow zrodlo_ze_strumienia(istream& we, int kolumny, int wiersze_w_bloku) {
+    if (wiersze_w_bloku <= 0) {
+        wiersze_w_bloku = 64;
+    }
+    auto nastepny = make_shared<int>(0);
+    return [&we, kolumny, wiersze_w_bloku, nastepny](BlokWierszy& blok) {
+        blok.pierwszy = *nastepny;
+        blok.kolumny = kolumny;
+        blok.wiersze = 0;
+        blok.dane.resize(static_cast<long>(wiersze_w_bloku) * kolumny);
+
+        while (blok.wiersze < wiersze_w_bloku) {
+            int* w = blok.dane.data() + static_cast<long>(blok.wiersze) * kolumny;
+            int j = 0;
+            while (j < kolumny && we >> w[j]) {
+                ++j;
+            }
+            if (j < kolumny) {
+                break;
+            }
+            ++blok.wiersze;
+        }
+
+        blok.dane.resize(static_cast<long>(blok.wiersze) * kolumny);
+        *nastepny += blok.wiersze;
+        return blok.wiersze > 0;
+    };
+}
+
+/**
+ * @brief Tworzy źródło odczytujące bloki wierszy z macierzy.
+ *
+ * @param m Macierz źródłowa.
+ * @param wiersze_w_bloku Liczba wierszy w bloku.
+ * @return Źródło bloków.
+ */
+ZrodloBlokow zrodlo_z_macierzy(const Matrix& m, int wiersze_w_bloku) {
+    if (wiersze_w_bloku <= 0) {
+        wiersze_w_bloku = 64;
+    }
+    auto nastepny = make_shared<int>(0);
+    return [m, wiersze_w_bloku, nastepny](BlokWierszy& blok) {
+        const int n = m.rozmiar();
+        if (*nastepny >= n) {
+            return false;
+        }
+        blok.pierwszy = *nastepny;
+        blok.wiersze = min(wiersze_w_bloku, n - *nastepny);
+        blok.kolumny = n;
+        const int* p = m.dane() + static_cast<long>(blok.pierwszy) * n;
+        blok.dane.assign(p, p + static_cast<long>(blok.wiersze) * n);
+        *nastepny += blok.wiersze;
+        return true;
+    };
+}
+
+/**
+ * @brief Tworzy ujście zapisujące wiersze do strumienia.
+ *
+ * @param wy Strumień wyjściowy.
+ * @return Ujście bloków.
+ */
+UjscieBlokow ujscie_do_strumienia(ostream& wy) {
+    return [&wy](const BlokWierszy& blok) {
+        for (int i = 0; i < blok.wiersze; ++i) {
+            const int* w = blok.dane.data() + static_cast<long>(i) * blok.kolumny;
+            for (int j = 0; j < blok.kolumny; ++j) {
+                wy << w[j] << " ";
+            }
+            wy << '\n';
+        }
+    };
+}
+
+/**
+ * @brief Tworzy ujście zapisujące wiersze do macierzy.
+ *
+ * @param m Macierz docelowa.
+ * @return Ujście bloków.
+ */
+UjscieBlokow ujscie_do_macierzy(Matrix& m) {
+    return [&m](const BlokWierszy& blok) {
+        if (blok.kolumny != m.rozmiar() || blok.pierwszy + blok.wiersze > m.rozmiar()) {
+            cerr << "Blok wierszy nie mieści się w macierzy docelowej." << endl;
+            return;
+        }
+        for (int i = 0; i < blok.wiersze; ++i) {
+            const int* w = blok.dane.data() + static_cast<long>(i) * blok.kolumny;
+            copy(w, w + blok.kolumny, m.widok_wiersza_do_zapisu(blok.pierwszy + i).begin());
+        }
+    };
+}
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <istream>
+#include <mutex>
+#include <ostream>
+#include <vector>
+#include "Matrix.hpp"
+
+/**
+ * @file Potok.hpp
+ * @brief Strumieniowe mnożenie macierzy blokami wierszy.
+ *
+ * Bloki wierszy płyną ze źródła przez mnożenie przez macierz przechowywaną w pamięci
+ * do ujścia (np. zapisu do strumienia). Etapy działają w osobnych wątkach i są
+ * połączone kolejkami o ograniczonej pojemności: szybkie źródło czeka, aż obliczenia
+ * nadążą, więc w pamięci znajduje się najwyżej kilka bloków, a nie cała macierz.
+ */
+
+/**
+ * @struct BlokWierszy
+ * @brief Kolejne wiersze macierzy przesyłane przez potok.
+ */
+struct BlokWierszy {
+  int pierwszy = 0;        /**< Numer pierwszego wiersza bloku w całej macierzy. */
+  int wiersze = 0;         /**< Liczba wierszy w bloku. */
+  int kolumny = 0;         /**< Liczba elementów w wierszu. */
+  std::vector<int> dane;   /**< Elementy bloku przechowywane wierszami. */
+};
+
+/**
+ * @class KolejkaOgraniczona
+ * @brief Kolejka między etapami potoku, która blokuje dodawanie, gdy jest pełna.
+ */
+template <typename T>
+class KolejkaOgraniczona {
+public:
+  /**
+   * @brief Tworzy pustą kolejkę.
+   * @param pojemnosc Maksymalna liczba elementów.
+   */
+  explicit KolejkaOgraniczona(int pojemnosc) : pojemnosc(pojemnosc > 0 ? pojemnosc : 1) {}
+
+  /**
+   * @brief Dodaje element, czekając na wolne miejsce.
+   * @param x Dodawany element.
+   * @return false, jeśli kolejka została zamknięta.
+   */
+  bool wstaw(T x) {
+    std::unique_lock<std::mutex> l(blokada);
+    miejsce.wait(l, [this] { return zamknieta || static_cast<int>(elementy.size()) < pojemnosc; });
+    if (zamknieta) {
+      return false;
+    }
+    elementy.push_back(std::move(x));
+    dane.notify_one();
+    return true;
+  }
+
+  /**
+   * @brief Pobiera element, czekając na jego pojawienie się.
+   * @param x Pobrany element.
+   * @return false, jeśli kolejka jest zamknięta i pusta.
+   */
+  bool pobierz(T& x) {
+    std::unique_lock<std::mutex> l(blokada);
+    dane.wait(l, [this] { return zamknieta || !elementy.empty(); });
+    if (elementy.empty()) {
+      return false;
+    }
+    x = std::move(elementy.front());
+    elementy.pop_front();
+    miejsce.notify_one();
+    return true;
+  }
+
+  /**
+   * @brief Zamyka kolejkę: pozostałe elementy można pobrać, nowych nie można dodać.
+   */
+  void zamknij(void) {
+    std::lock_guard<std::mutex> l(blokada);
+    zamknieta = true;
+    dane.notify_all();
+    miejsce.notify_all();
+  }
+
+private:
+  const int pojemnosc;              /**< Maksymalna liczba elementów. */
+  std::deque<T> elementy;           /**< Elementy oczekujące na pobranie. */
+  std::mutex blokada;               /**< Chroni kolejkę. */
+  std::condition_variable dane;     /**< Sygnalizuje pojawienie się elementu. */
+  std::condition_variable miejsce;  /**< Sygnalizuje zwolnienie miejsca. */
+  bool zamknieta = false;           /**< Czy kolejka została zamknięta. */
+};
+
+/**
+ * @brief Źródło bloków: wypełnia kolejny blok i zwraca false, gdy danych już nie ma.
+ */
+using ZrodloBlokow = std::function<bool(BlokWierszy&)>;
+
+/**
+ * @brief Ujście bloków: otrzymuje bloki w kolejności wierszy.
+ */
+using UjscieBlokow = std::function<void(const BlokWierszy&)>;
+
+/**
+ * @class PotokMnozenia
+ * @brief Potok źródło -> mnożenie przez macierz B -> ujście.
+ *
+ * Źródło działa w osobnym wątku, mnożenie w kolejnym (korzystając z rownolegle_wiersze()),
+ * a ujście w wątku wywołującym przetworz(), więc wczytywanie, obliczenia i zapis
+ * nakładają się w czasie.
+ */
+class PotokMnozenia {
+public:
+  /**
+   * @brief Tworzy potok mnożący bloki przez macierz b.
+   * @param b Macierz przechowywana w pamięci (kopiowana bez kopiowania elementów).
+   * @param pojemnosc Liczba bloków, które mogą czekać między dwoma etapami.
+   */
+  explicit PotokMnozenia(const Matrix& b, int pojemnosc = 4);
+
+  /**
+   * @brief Przepuszcza wszystkie bloki źródła przez potok.
+   * @param zrodlo Źródło bloków wierszy macierzy A.
+   * @param ujscie Ujście bloków wierszy iloczynu A * B.
+   * @return Liczba przetworzonych wierszy albo -1, jeśli blok miał niewłaściwą liczbę kolumn.
+   */
+  long przetworz(const ZrodloBlokow& zrodlo, const UjscieBlokow& ujscie);
+
+private:
+  Matrix b;        /**< Prawy czynnik każdego bloku. */
+  int pojemnosc;   /**< Pojemność kolejek między etapami. */
+};
+
+/**
+ * @brief Tworzy źródło czytające ze strumienia liczby całkowite rozdzielone białymi znakami.
+ * @param we Strumień wejściowy (musi istnieć przez cały czas przetwarzania).
+ * @param kolumny Liczba elementów w wierszu.
+ * @param wiersze_w_bloku Liczba wierszy w bloku.
+ * @return Źródło kończące się na końcu strumienia (niepełny ostatni wiersz jest pomijany).
+ */
+ZrodloBlokow zrodlo_ze_strumienia(std::istream& we, int kolumny, int wiersze_w_bloku = 64);
+
+/**
+ * @brief Tworzy źródło odczytujące bloki wierszy z macierzy.
+ * @param m Macierz źródłowa (kopiowana bez kopiowania elementów).
+ * @param wiersze_w_bloku Liczba wierszy w bloku.
+ * @return Źródło bloków.
+ */
+ZrodloBlokow zrodlo_z_macierzy(const Matrix& m, int wiersze_w_bloku = 64);
+
+/**
+ * @brief Tworzy ujście zapisujące wiersze w formacie operatora <<.
+ * @param wy Strumień wyjściowy (musi istnieć przez cały czas przetwarzania).
+ * @return Ujście bloków.
+ */
+UjscieBlokow ujscie_do_strumienia(std::ostream& wy);
+
+/**
+ * @brief Tworzy ujście zapisujące wiersze do macierzy.
+ * @param m Macierz docelowa o rozmiarze równym liczbie wierszy całego strumienia.
+ * @return Ujście bloków.
+ */
+UjscieBlokow ujscie_do_macierzy(Matrix& m);
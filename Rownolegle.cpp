@@ -0,0 +1,253 @@
+#include "Rownolegle.hpp"
+#include <atomic>
+#include <fstream>
+#include <string>
+#include <algorithm> // dla funkcji fill()
+#include <cstdlib>   // dla funkcji calloc(), malloc() i free()
+#include <new>       // dla wyjątku bad_alloc
+
+#ifdef __linux__
+#include <sched.h>          // dla funkcji sched_setaffinity()
+#include <sys/mman.h>       // dla funkcji mmap() i munmap()
+#include <sys/syscall.h>    // dla wywołania SYS_mbind
+#include <unistd.h>
+#include <linux/mempolicy.h>
+#endif
+
+using namespace std;
+
+namespace {
+
+/**
+ * @brief Minimalny rozmiar bufora (w bajtach) alokowanego przez mmap zamiast sterty.
+ */
+constexpr long PROG_MAPOWANIA = 1L << 21;
+
+atomic<PolitykaNuma> polityka{PolitykaNuma::Domyslna}; /**< Bieżąca polityka NUMA. */
+atomic<int> watki{0};                                  /**< Limit wątków, 0 oznacza liczbę rdzeni. */
+atomic<long> prog{PROG_ROWNOLEGLOSCI};                 /**< Minimalna liczba elementów na wątek. */
+
+/**
+ * @brief Odczytuje listę procesorów w formacie jądra Linux (np. "0-3,8-11").
+ *
+ * @param tekst Lista zakresów.
+ * @return Numery procesorów.
+ */
+vector<int> parsuj_liste(const string& tekst) {
+    vector<int> wynik;
+    size_t i = 0;
+    while (i < tekst.size()) {
+        size_t koniec = tekst.find(',', i);
+        if (koniec == string::npos) {
+            koniec = tekst.size();
+        }
+        string zakres = tekst.substr(i, koniec - i);
+        size_t myslnik = zakres.find('-');
+        try {
+            int od = stoi(zakres.substr(0, myslnik));
+            int dod = myslnik == string::npos ? od : stoi(zakres.substr(myslnik + 1));
+            for (int c = od; c <= dod; ++c) {
+                wynik.push_back(c);
+            }
+        } catch (...) {
+            // Pusty lub niepoprawny fragment listy jest pomijany
+        }
+        i = koniec + 1;
+    }
+    return wynik;
+}
+
+/**
+ * @brief Zwraca procesory kolejnych węzłów NUMA (odczytane raz, przy pierwszym użyciu).
+ *
+ * @return Dla każdego węzła lista jego procesorów.
+ */
+const vector<vector<int>>& procesory_wezlow(void) {
+    static const vector<vector<int>> wezly = [] {
+        vector<vector<int>> w;
+#ifdef __linux__
+        for (int n = 0;; ++n) {
+            ifstream plik("/sys/devices/system/node/node" + to_string(n) + "/cpulist");
+            if (!plik) {
+                break;
+            }
+            string lista;
+            getline(plik, lista);
+            w.push_back(parsuj_liste(lista));
+        }
+#endif
+        if (w.empty()) {
+            w.emplace_back();
+        }
+        return w;
+    }();
+    return wezly;
+}
+
+} // namespace
+
+/**
+ * @brief Ustawia politykę rozmieszczania nowo alokowanych macierzy.
+ *
+ * @param p Nowa polityka.
+ */
+void ustaw_polityke_numa(PolitykaNuma p) {
+    polityka.store(p, memory_order_relaxed);
+}
+
+/**
+ * @brief Zwraca bieżącą politykę rozmieszczania macierzy.
+ *
+ * @return Polityka NUMA.
+ */
+PolitykaNuma polityka_numa(void) {
+    return polityka.load(memory_order_relaxed);
+}
+
+/**
+ * @brief Zwraca liczbę węzłów NUMA.
+ *
+ * @return Liczba węzłów odczytana z /sys/devices/system/node.
+ */
+int liczba_wezlow(void) {
+    return static_cast<int>(procesory_wezlow().size());
+}
+
+/**
+ * @brief Przypina bieżący wątek do procesorów węzła.
+ *
+ * Poza Linuksem oraz dla nieznanego węzła funkcja nic nie robi.
+ *
+ * @param wezel Numer węzła.
+ */
+void przypnij_do_wezla(int wezel) {
+#ifdef __linux__
+    const vector<vector<int>>& wezly = procesory_wezlow();
+    if (wezel < 0 || wezel >= static_cast<int>(wezly.size()) || wezly[wezel].empty()) {
+        return;
+    }
+
+    cpu_set_t zbior;
+    CPU_ZERO(&zbior);
+    for (int c : wezly[wezel]) {
+        if (c < CPU_SETSIZE) {
+            CPU_SET(c, &zbior);
+        }
+    }
+    sched_setaffinity(0, sizeof(zbior), &zbior);
+#else
+    (void)wezel;
+#endif
+}
+
+/**
+ * @brief Ustawia limit wątków operacji równoległych.
+ *
+ * @param n Liczba wątków, 0 przywraca liczbę rdzeni.
+ */
+void ustaw_liczbe_watkow(int n) {
+    watki.store(n > 0 ? n : 0, memory_order_relaxed);
+}
+
+/**
+ * @brief Zwraca limit wątków operacji równoległych.
+ *
+ * @return Ustawiony limit albo liczba rdzeni.
+ */
+int liczba_watkow(void) {
+    int n = watki.load(memory_order_relaxed);
+    if (n > 0) {
+        return n;
+    }
+    int rdzenie = static_cast<int>(thread::hardware_concurrency());
+    return rdzenie > 0 ? rdzenie : 1;
+}
+
+/**
+ * @brief Ustawia minimalną liczbę elementów przypadającą na wątek.
+ *
+ * @param p Nowy próg, wartość niedodatnia przywraca PROG_ROWNOLEGLOSCI.
+ */
+void ustaw_prog_rownoleglosci(long p) {
+    prog.store(p > 0 ? p : PROG_ROWNOLEGLOSCI, memory_order_relaxed);
+}
+
+/**
+ * @brief Zwraca minimalną liczbę elementów przypadającą na wątek.
+ *
+ * @return Bieżący próg.
+ */
+long prog_rownoleglosci(void) {
+    return prog.load(memory_order_relaxed);
+}
+
+/**
+ * @brief Alokuje bufor na macierz zgodnie z polityką NUMA.
+ *
+ * @param wiersze Liczba wierszy.
+ * @param kolumny Liczba kolumn.
+ * @param mapowany Czy bufor pochodzi z mmap.
+ * @param wyzerowany Czy bufor jest już wyzerowany.
+ * @param zeruj Czy bufor ma być wyzerowany.
+ * @return Wskaźnik na bufor.
+ */
+int* alokuj_bufor(long wiersze, long kolumny, bool& mapowany, bool& wyzerowany, bool zeruj) {
+    long elementy = wiersze * kolumny;
+    long bajty = elementy * static_cast<long>(sizeof(int));
+    mapowany = false;
+    wyzerowany = false;
+
+#ifdef __linux__
+    if (bajty >= PROG_MAPOWANIA) {
+        void* p = mmap(nullptr, bajty, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p != MAP_FAILED) {
+            int* bufor = static_cast<int*>(p);
+            mapowany = true;
+            wyzerowany = true;
+
+            PolitykaNuma pol = polityka_numa();
+            int wezly = liczba_wezlow();
+            if (pol == PolitykaNuma::Przeplatana && wezly > 1) {
+                unsigned long maska[16] = {0};
+                for (int w = 0; w < wezly && w < 16 * 64; ++w) {
+                    maska[w / 64] |= 1UL << (w % 64);
+                }
+                syscall(SYS_mbind, p, bajty, MPOL_INTERLEAVE, maska, 16 * 64, 0);
+            } else if (pol == PolitykaNuma::PierwszyDotyk && wezly > 1) {
+                // Pierwszy zapis do każdej strony wykonuje wątek przypięty do węzła bloku
+                rownolegle_wiersze(static_cast<int>(wiersze), kolumny, [=](int y0, int y1) {
+                    fill(bufor + y0 * kolumny, bufor + y1 * kolumny, 0);
+                });
+            }
+            return bufor;
+        }
+    }
+#endif
+
+    void* p = zeruj ? calloc(elementy, sizeof(int)) : malloc(elementy * sizeof(int));
+    if (p == nullptr) {
+        throw bad_alloc();
+    }
+    wyzerowany = zeruj;
+    return static_cast<int*>(p);
+}
+
+/**
+ * @brief Zwalnia bufor zaalokowany przez alokuj_bufor().
+ *
+ * @param bufor Wskaźnik na bufor.
+ * @param elementy Liczba elementów.
+ * @param mapowany Czy bufor pochodzi z mmap.
+ */
+void zwolnij_bufor(int* bufor, long elementy, bool mapowany) {
+#ifdef __linux__
+    if (mapowany) {
+        munmap(bufor, elementy * static_cast<long>(sizeof(int)));
+        return;
+    }
+#else
+    (void)elementy;
+    (void)mapowany;
+#endif
+    free(bufor);
+}
@@ -0,0 +1,174 @@
+#pragma once
+
+#include <cstddef>
+#include <exception>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+/**
+ * @file Rownolegle.hpp
+ * @brief Wykonywanie operacji na blokach wierszy w wielu wątkach i rozmieszczanie pamięci w węzłach NUMA.
+ *
+ * Wiersze macierzy dzielone są zawsze w ten sam sposób: wątek t z T otrzymuje ciągły blok
+ * wierszy i jest przypinany do węzła t * liczba_wezlow() / T, więc wiersz y trafia mniej więcej
+ * do węzła y * liczba_wezlow() / n niezależnie od liczby wątków. Dzięki temu przy polityce
+ * PierwszyDotyk strony bloku leżą w węźle, którego rdzenie później go przetwarzają.
+ */
+
+/**
+ * @brief Sposób rozmieszczania dużych macierzy w pamięci węzłów NUMA.
+ */
+enum class PolitykaNuma {
+  Domyslna,     /**< Zachowanie systemu: strony w węźle wątku, który pierwszy ich dotknie. */
+  Przeplatana,  /**< Strony rozkładane po kolei na wszystkie węzły (mbind MPOL_INTERLEAVE). */
+  PierwszyDotyk /**< Bloki wierszy zerowane przez wątki przypięte do węzłów, jak w jądrach obliczeniowych. */
+};
+
+/**
+ * @brief Ustawia politykę rozmieszczania nowo alokowanych macierzy.
+ * @param p Nowa polityka.
+ */
+void ustaw_polityke_numa(PolitykaNuma p);
+
+/**
+ * @brief Zwraca bieżącą politykę rozmieszczania macierzy.
+ * @return Polityka NUMA.
+ */
+PolitykaNuma polityka_numa(void);
+
+/**
+ * @brief Zwraca liczbę węzłów NUMA (1 poza Linuksem lub na maszynach jednowęzłowych).
+ * @return Liczba węzłów.
+ */
+int liczba_wezlow(void);
+
+/**
+ * @brief Przypina bieżący wątek do procesorów wskazanego węzła NUMA.
+ * @param wezel Numer węzła.
+ */
+void przypnij_do_wezla(int wezel);
+
+/**
+ * @brief Ustawia maksymalną liczbę wątków używanych przez operacje równoległe.
+ * @param n Liczba wątków (0 przywraca liczbę rdzeni).
+ */
+void ustaw_liczbe_watkow(int n);
+
+/**
+ * @brief Zwraca maksymalną liczbę wątków używanych przez operacje równoległe.
+ * @return Liczba wątków.
+ */
+int liczba_watkow(void);
+
+/**
+ * @brief Domyślna minimalna liczba elementów przypadająca na wątek, poniżej której operacja wykonywana jest sekwencyjnie.
+ */
+constexpr long PROG_ROWNOLEGLOSCI = 1L << 16;
+
+/**
+ * @brief Ustawia minimalną liczbę elementów przypadającą na wątek.
+ * @param prog Nowy próg (wartość niedodatnia przywraca PROG_ROWNOLEGLOSCI).
+ */
+void ustaw_prog_rownoleglosci(long prog);
+
+/**
+ * @brief Zwraca minimalną liczbę elementów przypadającą na wątek.
+ * @return Bieżący próg.
+ */
+long prog_rownoleglosci(void);
+
+/**
+ * @brief Alokuje bufor na macierz zgodnie z bieżącą polityką NUMA.
+ *
+ * Małe bufory pochodzą ze zwykłej sterty: calloc(), gdy potrzebne są zera (biblioteka
+ * pomija zerowanie pamięci świeżo pobranej od systemu), albo malloc(), gdy bufor i tak
+ * zostanie nadpisany. Duże bufory są mapowane przez mmap (strony zerowe systemu,
+ * przydzielane dopiero przy pierwszym zapisie), a przy polityce Przeplatana dodatkowo
+ * przeplatane między węzłami. Przy polityce PierwszyDotyk bufor zerowany jest blokami
+ * wierszy przez przypięte wątki.
+ *
+ * @param wiersze Liczba wierszy macierzy.
+ * @param kolumny Liczba kolumn macierzy.
+ * @param mapowany Ustawiane na true, jeśli bufor należy zwolnić funkcją zwolnij_bufor().
+ * @param wyzerowany Ustawiane na true, jeśli bufor jest już wypełniony zerami.
+ * @param zeruj Czy bufor ma być wyzerowany (false pozostawia małe bufory niezainicjowane).
+ * @return Wskaźnik na bufor wiersze * kolumny liczb całkowitych.
+ */
+int* alokuj_bufor(long wiersze, long kolumny, bool& mapowany, bool& wyzerowany, bool zeruj = true);
+
+/**
+ * @brief Zwalnia bufor zaalokowany przez alokuj_bufor().
+ * @param bufor Wskaźnik na bufor.
+ * @param elementy Liczba elementów bufora.
+ * @param mapowany Wartość zwrócona przez alokuj_bufor().
+ */
+void zwolnij_bufor(int* bufor, long elementy, bool mapowany);
+
+/**
+ * @brief Wykonuje f(y0, y1) dla rozłącznych bloków wierszy [0, n) w wielu wątkach.
+ *
+ * Liczba wątków dobierana jest tak, by każdy przetwarzał co najmniej prog_rownoleglosci()
+ * elementów. Przy polityce innej niż domyślna wątki przypinane są do węzłów NUMA,
+ * do których trafiły ich bloki przy alokacji. Wątki tworzone są przy każdym wywołaniu
+ * i kończą się przed powrotem, więc proces można bezpiecznie rozwidlić między
+ * operacjami (TransportLokalny). Wyjątek zgłoszony przez f w dowolnym bloku jest
+ * przekazywany do wątku wywołującego po zakończeniu wszystkich bloków; gdy nie
+ * można utworzyć wątku, jego blok wykonywany jest w wątku wywołującym.
+ *
+ * @param n Liczba wierszy.
+ * @param elementy_w_wierszu Przybliżony koszt jednego wiersza (np. liczba kolumn).
+ * @param f Funkcja wywoływana dla każdego bloku wierszy.
+ */
+template <typename F>
+void rownolegle_wiersze(int n, long elementy_w_wierszu, F f) {
+  long praca = static_cast<long>(n) * (elementy_w_wierszu > 0 ? elementy_w_wierszu : 1);
+  long watki = praca / prog_rownoleglosci();
+  if (watki > liczba_watkow()) {
+    watki = liczba_watkow();
+  }
+  if (watki > n) {
+    watki = n;
+  }
+
+  if (watki <= 1) {
+    f(0, n);
+    return;
+  }
+
+  const bool przypinaj = polityka_numa() != PolitykaNuma::Domyslna && liczba_wezlow() > 1;
+  const int wezly = liczba_wezlow();
+
+  std::vector<std::exception_ptr> bledy(watki);
+  auto blok = [&](long t) {
+    try {
+      f(static_cast<int>(n * t / watki), static_cast<int>(n * (t + 1) / watki));
+    } catch (...) {
+      bledy[t] = std::current_exception();
+    }
+  };
+
+  std::vector<std::thread> pula;
+  pula.reserve(watki);
+  for (long t = 0; t < watki; ++t) {
+    int wezel = static_cast<int>(t * wezly / watki);
+    try {
+      pula.emplace_back([=, &blok] {
+        if (przypinaj) {
+          przypnij_do_wezla(wezel);
+        }
+        blok(t);
+      });
+    } catch (const std::system_error&) {
+      blok(t); // Brak zasobów na nowy wątek
+    }
+  }
+  for (std::thread& w : pula) {
+    w.join();
+  }
+  for (const std::exception_ptr& e : bledy) {
+    if (e) {
+      std::rethrow_exception(e);
+    }
+  }
+}
@@ -0,0 +1,578 @@
+#include "Rozklady.hpp"
+#include "Gemm.hpp"
+#include <iostream>
+#include <cmath>     // dla funkcji sqrt(), fabs() i copysign()
+#include <algorithm> // dla funkcji min() i swap_ranges()
+using namespace std;
+
+namespace {
+
+/**
+ * @brief Szerokość panelu w rozkładach blokowych.
+ */
+constexpr int PANEL = 32;
+
+/**
+ * @brief Kopiuje macierz całkowitoliczbową do tablicy liczb zmiennoprzecinkowych.
+ *
+ * @param m Macierz źródłowa.
+ * @return Elementy macierzy zapisane wierszami.
+ */
+vector<double> na_double(const Matrix& m) {
+    const int* d = m.dane();
+    long n = static_cast<long>(m.rozmiar()) * m.rozmiar();
+    return vector<double>(d, d + n);
+}
+
+/**
+ * @brief Rozwiązuje układ TX = B z macierzą dolnotrójkątną T.
+ *
+ * Bloki poza przekątną odejmowane są przez jądro gemm, a wewnątrz bloku
+ * stosowane jest zwykłe podstawianie w przód.
+ *
+ * @param n Rozmiar T.
+ * @param t Wskaźnik na macierz T (odstęp między wierszami n).
+ * @param jednostkowa Czy przekątna T składa się z jedynek (i nie jest odczytywana).
+ * @param r Liczba prawych stron.
+ * @param b Macierz n x r nadpisywana rozwiązaniem.
+ */
+void trsm_dolna(int n, const double* t, bool jednostkowa, int r, double* b) {
+    for (int ib = 0; ib < n; ib += PANEL) {
+        int ie = min(ib + PANEL, n);
+
+        gemm(ie - ib, r, ib, -1.0, t + static_cast<long>(ib) * n, n, b, r, b + static_cast<long>(ib) * r, r);
+
+        for (int i = ib; i < ie; ++i) {
+            double* bi = b + static_cast<long>(i) * r;
+            for (int k = ib; k < i; ++k) {
+                double tik = t[static_cast<long>(i) * n + k];
+                const double* bk = b + static_cast<long>(k) * r;
+                for (int j = 0; j < r; ++j) {
+                    bi[j] -= tik * bk[j];
+                }
+            }
+            if (!jednostkowa) {
+                double d = t[static_cast<long>(i) * n + i];
+                for (int j = 0; j < r; ++j) {
+                    bi[j] /= d;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Rozwiązuje układ TX = B z macierzą górnotrójkątną T o niezerowej przekątnej.
+ *
+ * @param n Rozmiar T.
+ * @param t Wskaźnik na macierz T (odstęp między wierszami n).
+ * @param r Liczba prawych stron.
+ * @param b Macierz n x r nadpisywana rozwiązaniem.
+ */
+void trsm_gorna(int n, const double* t, int r, double* b) {
+    for (int ie = n; ie > 0; ie -= PANEL) {
+        int ib = max(ie - PANEL, 0);
+
+        gemm(ie - ib, r, n - ie, -1.0, t + static_cast<long>(ib) * n + ie, n,
+             b + static_cast<long>(ie) * r, r, b + static_cast<long>(ib) * r, r);
+
+        for (int i = ie - 1; i >= ib; --i) {
+            double* bi = b + static_cast<long>(i) * r;
+            for (int k = i + 1; k < ie; ++k) {
+                double tik = t[static_cast<long>(i) * n + k];
+                const double* bk = b + static_cast<long>(k) * r;
+                for (int j = 0; j < r; ++j) {
+                    bi[j] -= tik * bk[j];
+                }
+            }
+            double d = t[static_cast<long>(i) * n + i];
+            for (int j = 0; j < r; ++j) {
+                bi[j] /= d;
+            }
+        }
+    }
+}
+
+} // namespace
+
+/**
+ * @brief Konstruktor rozkładu LU macierzy całkowitoliczbowej.
+ *
+ * @param m Macierz do rozłożenia.
+ */
+LU::LU(const Matrix& m) : n(m.rozmiar()), a(na_double(m)), osobliwa(false) {
+    rozloz();
+}
+
+/**
+ * @brief Konstruktor rozkładu LU macierzy podanej w tablicy.
+ *
+ * @param n Rozmiar macierzy.
+ * @param t Wskaźnik na n * n elementów zapisanych wierszami.
+ */
+LU::LU(int n, const double* t) : n(n), a(t, t + static_cast<long>(n) * n), osobliwa(false) {
+    rozloz();
+}
+
+/**
+ * @brief Blokowy rozkład LU z częściowym wyborem elementu głównego.
+ *
+ * Panel o szerokości PANEL rozkładany jest kolumna po kolumnie, następnie liczony jest
+ * blok U12, a pozostała część macierzy aktualizowana jest przez gemm: A22 -= L21 * U12.
+ */
+void LU::rozloz(void) {
+    piv.assign(n, 0);
+
+    for (int jb = 0; jb < n; jb += PANEL) {
+        int b = min(PANEL, n - jb);
+
+        // Rozkład panelu kolumn jb .. jb + b - 1
+        for (int j = jb; j < jb + b; ++j) {
+            int p = j;
+            for (int i = j + 1; i < n; ++i) {
+                if (fabs(a[static_cast<long>(i) * n + j]) > fabs(a[static_cast<long>(p) * n + j])) {
+                    p = i;
+                }
+            }
+            piv[j] = p;
+
+            if (a[static_cast<long>(p) * n + j] == 0.0) {
+                osobliwa = true;
+                continue;
+            }
+            if (p != j) {
+                swap_ranges(a.begin() + static_cast<long>(j) * n, a.begin() + static_cast<long>(j + 1) * n,
+                            a.begin() + static_cast<long>(p) * n);
+            }
+
+            double* aj = &a[static_cast<long>(j) * n];
+            for (int i = j + 1; i < n; ++i) {
+                double* ai = &a[static_cast<long>(i) * n];
+                ai[j] /= aj[j];
+                for (int c = j + 1; c < jb + b; ++c) {
+                    ai[c] -= ai[j] * aj[c];
+                }
+            }
+        }
+
+        int reszta = n - jb - b;
+        if (reszta == 0) {
+            continue;
+        }
+
+        // U12 = L11^-1 * A12
+        for (int i = jb + 1; i < jb + b; ++i) {
+            double* ai = &a[static_cast<long>(i) * n];
+            for (int k = jb; k < i; ++k) {
+                const double* ak = &a[static_cast<long>(k) * n];
+                for (int c = jb + b; c < n; ++c) {
+                    ai[c] -= ai[k] * ak[c];
+                }
+            }
+        }
+
+        // A22 -= L21 * U12
+        gemm(reszta, reszta, b, -1.0,
+             &a[static_cast<long>(jb + b) * n + jb], n,
+             &a[static_cast<long>(jb) * n + jb + b], n,
+             &a[static_cast<long>(jb + b) * n + jb + b], n);
+    }
+
+    if (osobliwa) {
+        cerr << "Macierz jest osobliwa, rozkład LU nie pozwala rozwiązywać układów." << endl;
+    }
+}
+
+/**
+ * @brief Rozwiązuje układ Ax = b na podstawie rozkładu LU.
+ *
+ * @param b Prawa strona układu.
+ * @return Wektor rozwiązania (pusty w przypadku błędu).
+ */
+vector<double> LU::rozwiaz(const vector<double>& b) const {
+    if (static_cast<int>(b.size()) != n) {
+        cerr << "Długość prawej strony różni się od rozmiaru macierzy." << endl;
+        return {};
+    }
+
+    vector<double> x(b);
+    rozwiaz(1, x.data());
+    return x;
+}
+
+/**
+ * @brief Rozwiązuje układ AX = B dla wielu prawych stron.
+ *
+ * @param nrhs Liczba prawych stron.
+ * @param b Macierz n x nrhs zapisana wierszami, nadpisywana rozwiązaniem.
+ */
+void LU::rozwiaz(int nrhs, double* b) const {
+    if (osobliwa) {
+        cerr << "Macierz jest osobliwa, nie można rozwiązać układu." << endl;
+        return;
+    }
+
+    for (int i = 0; i < n; ++i) {
+        if (piv[i] != i) {
+            swap_ranges(b + static_cast<long>(i) * nrhs, b + static_cast<long>(i + 1) * nrhs,
+                        b + static_cast<long>(piv[i]) * nrhs);
+        }
+    }
+
+    trsm_dolna(n, a.data(), true, nrhs, b);
+    trsm_gorna(n, a.data(), nrhs, b);
+}
+
+/**
+ * @brief Oblicza wyznacznik jako iloczyn przekątnej U ze znakiem permutacji.
+ *
+ * @return Wartość wyznacznika.
+ */
+double LU::wyznacznik(void) const {
+    double w = 1.0;
+    for (int i = 0; i < n; ++i) {
+        w *= a[static_cast<long>(i) * n + i];
+        if (piv[i] != i) {
+            w = -w;
+        }
+    }
+    return w;
+}
+
+/**
+ * @brief Pakuje czynnik L, uzupełniając przekątną jedynkami.
+ *
+ * @return Dolnotrójkątna macierz L.
+ */
+TriangularMatrix<double> LU::czynnik_L(void) const {
+    TriangularMatrix<double> l(TriangularMatrix<double>::Dolna, n, a.data());
+    for (int i = 0; i < n; ++i) {
+        l.element(i, i) = 1.0;
+    }
+    return l;
+}
+
+/**
+ * @brief Pakuje czynnik U.
+ *
+ * @return Górnotrójkątna macierz U.
+ */
+TriangularMatrix<double> LU::czynnik_U(void) const {
+    return TriangularMatrix<double>(TriangularMatrix<double>::Gorna, n, a.data());
+}
+
+/**
+ * @brief Konstruktor rozkładu Cholesky'ego macierzy całkowitoliczbowej.
+ *
+ * @param m Macierz symetryczna do rozłożenia.
+ */
+Cholesky::Cholesky(const Matrix& m) : n(m.rozmiar()), a(na_double(m)), dodatnio_okreslona(true) {
+    rozloz();
+}
+
+/**
+ * @brief Konstruktor rozkładu Cholesky'ego macierzy podanej w tablicy.
+ *
+ * @param n Rozmiar macierzy.
+ * @param t Wskaźnik na n * n elementów zapisanych wierszami.
+ */
+Cholesky::Cholesky(int n, const double* t) : n(n), a(t, t + static_cast<long>(n) * n), dodatnio_okreslona(true) {
+    rozloz();
+}
+
+/**
+ * @brief Blokowy rozkład Cholesky'ego.
+ *
+ * Odczytywany jest wyłącznie dolny trójkąt. Po rozłożeniu bloku przekątnego i wyznaczeniu L21
+ * dolna część A22 aktualizowana jest pasami wierszy przez gemm: A22 -= L21 * L21^T.
+ * Na koniec górny trójkąt wypełniany jest przez L^T, co upraszcza podstawianie wstecz.
+ */
+void Cholesky::rozloz(void) {
+    vector<double> lt;
+
+    for (int jb = 0; jb < n; jb += PANEL) {
+        int b = min(PANEL, n - jb);
+
+        // Blok przekątny oraz L21, kolumna po kolumnie
+        for (int j = jb; j < jb + b; ++j) {
+            double* aj = &a[static_cast<long>(j) * n];
+            double d = aj[j];
+            for (int k = jb; k < j; ++k) {
+                d -= aj[k] * aj[k];
+            }
+            if (d <= 0.0) {
+                cerr << "Macierz nie jest dodatnio określona, rozkład Cholesky'ego jest niemożliwy." << endl;
+                dodatnio_okreslona = false;
+                return;
+            }
+            d = sqrt(d);
+            aj[j] = d;
+
+            for (int i = j + 1; i < n; ++i) {
+                double* ai = &a[static_cast<long>(i) * n];
+                double s = ai[j];
+                for (int k = jb; k < j; ++k) {
+                    s -= ai[k] * aj[k];
+                }
+                ai[j] = s / d;
+            }
+        }
+
+        int reszta = n - jb - b;
+        if (reszta == 0) {
+            continue;
+        }
+
+        lt.assign(static_cast<long>(b) * reszta, 0.0);
+        for (int i = 0; i < reszta; ++i) {
+            for (int p = 0; p < b; ++p) {
+                lt[static_cast<long>(p) * reszta + i] = a[static_cast<long>(jb + b + i) * n + jb + p];
+            }
+        }
+
+        // Tylko pasy wierszy do przekątnej, górny trójkąt A22 nie jest liczony
+        for (int ib = 0; ib < reszta; ib += PANEL) {
+            int ie = min(ib + PANEL, reszta);
+            gemm(ie - ib, ie, b, -1.0,
+                 &a[static_cast<long>(jb + b + ib) * n + jb], n,
+                 lt.data(), reszta,
+                 &a[static_cast<long>(jb + b + ib) * n + jb + b], n);
+        }
+    }
+
+    for (int i = 0; i < n; ++i) {
+        for (int j = i + 1; j < n; ++j) {
+            a[static_cast<long>(i) * n + j] = a[static_cast<long>(j) * n + i];
+        }
+    }
+}
+
+/**
+ * @brief Rozwiązuje układ Ax = b na podstawie rozkładu Cholesky'ego.
+ *
+ * @param b Prawa strona układu.
+ * @return Wektor rozwiązania (pusty w przypadku błędu).
+ */
+vector<double> Cholesky::rozwiaz(const vector<double>& b) const {
+    if (static_cast<int>(b.size()) != n) {
+        cerr << "Długość prawej strony różni się od rozmiaru macierzy." << endl;
+        return {};
+    }
+
+    vector<double> x(b);
+    rozwiaz(1, x.data());
+    return x;
+}
+
+/**
+ * @brief Rozwiązuje układ AX = B dla wielu prawych stron: najpierw LY = B, potem L^T X = Y.
+ *
+ * @param nrhs Liczba prawych stron.
+ * @param b Macierz n x nrhs zapisana wierszami, nadpisywana rozwiązaniem.
+ */
+void Cholesky::rozwiaz(int nrhs, double* b) const {
+    if (!dodatnio_okreslona) {
+        cerr << "Rozkład Cholesky'ego się nie powiódł, nie można rozwiązać układu." << endl;
+        return;
+    }
+
+    trsm_dolna(n, a.data(), false, nrhs, b);
+    trsm_gorna(n, a.data(), nrhs, b);
+}
+
+/**
+ * @brief Pakuje czynnik L.
+ *
+ * @return Dolnotrójkątna macierz L.
+ */
+TriangularMatrix<double> Cholesky::czynnik_L(void) const {
+    return TriangularMatrix<double>(TriangularMatrix<double>::Dolna, n, a.data());
+}
+
+/**
+ * @brief Konstruktor rozkładu QR macierzy całkowitoliczbowej.
+ *
+ * @param m Macierz do rozłożenia.
+ */
+QR::QR(const Matrix& m) : n(m.rozmiar()), a(na_double(m)) {
+    rozloz();
+}
+
+/**
+ * @brief Konstruktor rozkładu QR macierzy podanej w tablicy.
+ *
+ * @param n Rozmiar macierzy.
+ * @param t Wskaźnik na n * n elementów zapisanych wierszami.
+ */
+QR::QR(int n, const double* t) : n(n), a(t, t + static_cast<long>(n) * n) {
+    rozloz();
+}
+
+/**
+ * @brief Blokowy rozkład QR w reprezentacji WY.
+ *
+ * Odbicia panelu zbierane są w postaci I - V T V^T, a pozostałe kolumny aktualizowane są
+ * trzema wywołaniami gemm: W = V^T A2, W = T^T W, A2 -= V W.
+ */
+void QR::rozloz(void) {
+    tau.assign(n, 0.0);
+    vector<double> v, vt, tt, w, w2;
+
+    for (int kb = 0; kb < n; kb += PANEL) {
+        int b = min(PANEL, n - kb);
+        int mp = n - kb;
+
+        // Odbicia Householdera dla kolumn panelu
+        for (int j = kb; j < kb + b; ++j) {
+            double alfa = a[static_cast<long>(j) * n + j];
+            double norma2 = 0.0;
+            for (int i = j + 1; i < n; ++i) {
+                double x = a[static_cast<long>(i) * n + j];
+                norma2 += x * x;
+            }
+            if (norma2 == 0.0) {
+                tau[j] = 0.0;
+                continue;
+            }
+
+            double beta = -copysign(sqrt(alfa * alfa + norma2), alfa);
+            tau[j] = (beta - alfa) / beta;
+            double s = 1.0 / (alfa - beta);
+            for (int i = j + 1; i < n; ++i) {
+                a[static_cast<long>(i) * n + j] *= s;
+            }
+            a[static_cast<long>(j) * n + j] = beta;
+
+            for (int c = j + 1; c < kb + b; ++c) {
+                double iloczyn = a[static_cast<long>(j) * n + c];
+                for (int i = j + 1; i < n; ++i) {
+                    iloczyn += a[static_cast<long>(i) * n + j] * a[static_cast<long>(i) * n + c];
+                }
+                iloczyn *= tau[j];
+                a[static_cast<long>(j) * n + c] -= iloczyn;
+                for (int i = j + 1; i < n; ++i) {
+                    a[static_cast<long>(i) * n + c] -= iloczyn * a[static_cast<long>(i) * n + j];
+                }
+            }
+        }
+
+        int nc = n - kb - b;
+        if (nc == 0) {
+            continue;
+        }
+
+        // V (mp x b) z jedynkami na przekątnej oraz V^T
+        v.assign(static_cast<long>(mp) * b, 0.0);
+        vt.assign(static_cast<long>(b) * mp, 0.0);
+        for (int r = 0; r < mp; ++r) {
+            for (int p = 0; p < b && p <= r; ++p) {
+                double x = r == p ? 1.0 : a[static_cast<long>(kb + r) * n + kb + p];
+                v[static_cast<long>(r) * b + p] = x;
+                vt[static_cast<long>(p) * mp + r] = x;
+            }
+        }
+
+        // Górnotrójkątna T, przechowywana od razu jako T^T
+        tt.assign(static_cast<long>(b) * b, 0.0);
+        vector<double> z(b);
+        for (int i = 0; i < b; ++i) {
+            double ti = tau[kb + i];
+            tt[static_cast<long>(i) * b + i] = ti;
+            for (int p = 0; p < i; ++p) {
+                double s = 0.0;
+                for (int r = i; r < mp; ++r) {
+                    s += vt[static_cast<long>(p) * mp + r] * vt[static_cast<long>(i) * mp + r];
+                }
+                z[p] = s;
+            }
+            for (int p = 0; p < i; ++p) {
+                double s = 0.0;
+                for (int q = p; q < i; ++q) {
+                    s += tt[static_cast<long>(q) * b + p] * z[q];
+                }
+                tt[static_cast<long>(i) * b + p] = -ti * s;
+            }
+        }
+
+        double* a2 = &a[static_cast<long>(kb) * n + kb + b];
+        w.assign(static_cast<long>(b) * nc, 0.0);
+        w2.assign(static_cast<long>(b) * nc, 0.0);
+        gemm(b, nc, mp, 1.0, vt.data(), mp, a2, n, w.data(), nc);
+        gemm(b, nc, b, 1.0, tt.data(), b, w.data(), nc, w2.data(), nc);
+        gemm(mp, nc, b, -1.0, v.data(), b, w2.data(), nc, a2, n);
+    }
+}
+
+/**
+ * @brief Sprawdza, czy przekątna R nie zawiera zer.
+ *
+ * @return true, jeśli macierz R jest odwracalna.
+ */
+bool QR::poprawny(void) const {
+    for (int i = 0; i < n; ++i) {
+        if (a[static_cast<long>(i) * n + i] == 0.0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Rozwiązuje układ Ax = b na podstawie rozkładu QR.
+ *
+ * @param b Prawa strona układu.
+ * @return Wektor rozwiązania (pusty w przypadku błędu).
+ */
+vector<double> QR::rozwiaz(const vector<double>& b) const {
+    if (static_cast<int>(b.size()) != n) {
+        cerr << "Długość prawej strony różni się od rozmiaru macierzy." << endl;
+        return {};
+    }
+
+    vector<double> x(b);
+    rozwiaz(1, x.data());
+    return x;
+}
+
+/**
+ * @brief Rozwiązuje układ AX = B dla wielu prawych stron: Y = Q^T B, a następnie RX = Y.
+ *
+ * @param nrhs Liczba prawych stron.
+ * @param b Macierz n x nrhs zapisana wierszami, nadpisywana rozwiązaniem.
+ */
+void QR::rozwiaz(int nrhs, double* b) const {
+    if (!poprawny()) {
+        cerr << "Macierz R jest osobliwa, nie można rozwiązać układu." << endl;
+        return;
+    }
+
+    vector<double> w(nrhs);
+    for (int j = 0; j < n; ++j) {
+        if (tau[j] == 0.0) {
+            continue;
+        }
+
+        double* bj = b + static_cast<long>(j) * nrhs;
+        copy_n(bj, nrhs, w.begin());
+        for (int i = j + 1; i < n; ++i) {
+            double vi = a[static_cast<long>(i) * n + j];
+            const double* bi = b + static_cast<long>(i) * nrhs;
+            for (int c = 0; c < nrhs; ++c) {
+                w[c] += vi * bi[c];
+            }
+        }
+        for (int c = 0; c < nrhs; ++c) {
+            w[c] *= tau[j];
+            bj[c] -= w[c];
+        }
+        for (int i = j + 1; i < n; ++i) {
+            double vi = a[static_cast<long>(i) * n + j];
+            double* bi = b + static_cast<long>(i) * nrhs;
+            for (int c = 0; c < nrhs; ++c) {
+                bi[c] -= vi * w[c];
+            }
+        }
+    }
+
+    trsm_gorna(n, a.data(), nrhs, b);
+}
@@ -0,0 +1,184 @@
+#pragma once
+
+#include <vector>
+#include "Matrix.hpp"
+#include "TriangularMatrix.hpp"
+
+/**
+ * @file Rozklady.hpp
+ * @brief Rozkłady LU, Cholesky'ego i QR macierzy zmiennoprzecinkowych.
+ *
+ * Wszystkie rozkłady działają na kopii danych typu double przechowywanej wierszami
+ * i są liczone algorytmami blokowymi (right-looking), w których aktualizacja
+ * pozostałej części macierzy odbywa się przez to samo jądro gemm co Matrix::operator*.
+ * Raz policzony rozkład można wielokrotnie wykorzystywać do rozwiązywania układów
+ * z różnymi prawymi stronami.
+ */
+
+/**
+ * @class LU
+ * @brief Rozkład PA = LU z częściowym wyborem elementu głównego.
+ */
+class LU {
+public:
+  /**
+   * @brief Rozkłada macierz całkowitoliczbową.
+   * @param m Macierz do rozłożenia.
+   */
+  explicit LU(const Matrix& m);
+
+  /**
+   * @brief Rozkłada macierz zapisaną wierszami w tablicy.
+   * @param n Rozmiar macierzy.
+   * @param a Wskaźnik na n * n elementów macierzy.
+   */
+  LU(int n, const double* a);
+
+  /**
+   * @brief Sprawdza, czy rozkład się powiódł (macierz nie jest osobliwa).
+   * @return true, jeśli rozkład można wykorzystać do rozwiązywania układów.
+   */
+  bool poprawny(void) const { return !osobliwa; }
+
+  /**
+   * @brief Rozwiązuje układ Ax = b.
+   * @param b Prawa strona układu.
+   * @return Wektor rozwiązania.
+   */
+  std::vector<double> rozwiaz(const std::vector<double>& b) const;
+
+  /**
+   * @brief Rozwiązuje układ AX = B dla wielu prawych stron jednocześnie.
+   * @param nrhs Liczba prawych stron (kolumn B).
+   * @param b Macierz n x nrhs zapisana wierszami, nadpisywana rozwiązaniem.
+   */
+  void rozwiaz(int nrhs, double* b) const;
+
+  /**
+   * @brief Oblicza wyznacznik rozłożonej macierzy.
+   * @return Wartość wyznacznika.
+   */
+  double wyznacznik(void) const;
+
+  /**
+   * @brief Zwraca czynnik L (z jedynkami na przekątnej) w postaci spakowanej.
+   * @return Dolnotrójkątna macierz L.
+   */
+  TriangularMatrix<double> czynnik_L(void) const;
+
+  /**
+   * @brief Zwraca czynnik U w postaci spakowanej.
+   * @return Górnotrójkątna macierz U.
+   */
+  TriangularMatrix<double> czynnik_U(void) const;
+
+private:
+  void rozloz(void);
+
+  int n;                   /**< Rozmiar macierzy. */
+  std::vector<double> a;   /**< Czynniki L (bez jedynek na przekątnej) i U. */
+  std::vector<int> piv;    /**< Wiersze zamieniane w kolejnych krokach. */
+  bool osobliwa;           /**< Czy napotkano zerowy element główny. */
+};
+
+/**
+ * @class Cholesky
+ * @brief Rozkład A = L * L^T macierzy symetrycznej dodatnio określonej.
+ */
+class Cholesky {
+public:
+  /**
+   * @brief Rozkłada macierz całkowitoliczbową.
+   * @param m Macierz symetryczna do rozłożenia.
+   */
+  explicit Cholesky(const Matrix& m);
+
+  /**
+   * @brief Rozkłada macierz zapisaną wierszami w tablicy.
+   * @param n Rozmiar macierzy.
+   * @param a Wskaźnik na n * n elementów macierzy.
+   */
+  Cholesky(int n, const double* a);
+
+  /**
+   * @brief Sprawdza, czy macierz okazała się dodatnio określona.
+   * @return true, jeśli rozkład można wykorzystać do rozwiązywania układów.
+   */
+  bool poprawny(void) const { return dodatnio_okreslona; }
+
+  /**
+   * @brief Rozwiązuje układ Ax = b.
+   * @param b Prawa strona układu.
+   * @return Wektor rozwiązania.
+   */
+  std::vector<double> rozwiaz(const std::vector<double>& b) const;
+
+  /**
+   * @brief Rozwiązuje układ AX = B dla wielu prawych stron jednocześnie.
+   * @param nrhs Liczba prawych stron (kolumn B).
+   * @param b Macierz n x nrhs zapisana wierszami, nadpisywana rozwiązaniem.
+   */
+  void rozwiaz(int nrhs, double* b) const;
+
+  /**
+   * @brief Zwraca czynnik L w postaci spakowanej.
+   * @return Dolnotrójkątna macierz L.
+   */
+  TriangularMatrix<double> czynnik_L(void) const;
+
+private:
+  void rozloz(void);
+
+  int n;                    /**< Rozmiar macierzy. */
+  std::vector<double> a;    /**< Czynnik L w dolnym trójkącie. */
+  bool dodatnio_okreslona;  /**< Czy wszystkie elementy główne były dodatnie. */
+};
+
+/**
+ * @class QR
+ * @brief Rozkład A = QR metodą odbić Householdera.
+ *
+ * Q przechowywana jest niejawnie jako ciąg wektorów Householdera pod przekątną.
+ */
+class QR {
+public:
+  /**
+   * @brief Rozkłada macierz całkowitoliczbową.
+   * @param m Macierz do rozłożenia.
+   */
+  explicit QR(const Matrix& m);
+
+  /**
+   * @brief Rozkłada macierz zapisaną wierszami w tablicy.
+   * @param n Rozmiar macierzy.
+   * @param a Wskaźnik na n * n elementów macierzy.
+   */
+  QR(int n, const double* a);
+
+  /**
+   * @brief Sprawdza, czy R ma niezerową przekątną.
+   * @return true, jeśli rozkład można wykorzystać do rozwiązywania układów.
+   */
+  bool poprawny(void) const;
+
+  /**
+   * @brief Rozwiązuje układ Ax = b.
+   * @param b Prawa strona układu.
+   * @return Wektor rozwiązania.
+   */
+  std::vector<double> rozwiaz(const std::vector<double>& b) const;
+
+  /**
+   * @brief Rozwiązuje układ AX = B dla wielu prawych stron jednocześnie.
+   * @param nrhs Liczba prawych stron (kolumn B).
+   * @param b Macierz n x nrhs zapisana wierszami, nadpisywana rozwiązaniem.
+   */
+  void rozwiaz(int nrhs, double* b) const;
+
+private:
+  void rozloz(void);
+
+  int n;                   /**< Rozmiar macierzy. */
+  std::vector<double> a;   /**< R w górnym trójkącie, wektory Householdera pod przekątną. */
+  std::vector<double> tau; /**< Współczynniki kolejnych odbić. */
+};
@@ -0,0 +1,265 @@
+#include "SharedMatrix.hpp"
+#include "Rownolegle.hpp"
+#include <algorithm> // dla funkcji copy()
+#include <new>       // dla umieszczającego operatora new
+#ifdef __linux__
+#include <fcntl.h>        // dla stałych O_CREAT, O_EXCL i O_RDWR
+#include <sys/mman.h>     // dla funkcji shm_open(), mmap() i munmap()
+#include <sys/stat.h>     // dla funkcji fstat()
+#include <unistd.h>       // dla funkcji ftruncate() i close()
+#endif
+using namespace std;
+
+namespace {
+
+/**
+ * @brief Uzupełnia nazwę segmentu o początkowy ukośnik wymagany przez shm_open().
+ *
+ * @param nazwa Nazwa podana przez użytkownika.
+ * @return Nazwa zaczynająca się od '/'.
+ */
+string nazwa_segmentu(const string& nazwa) {
+    return !nazwa.empty() && nazwa[0] == '/' ? nazwa : "/" + nazwa;
+}
+
+} // namespace
+
+/**
+ * @brief Odmapowuje segment.
+ */
+SharedMatrix::Mapowanie::~Mapowanie(void) {
+#ifdef __linux__
+    if (adres != nullptr) {
+        munmap(adres, bajty);
+    }
+#endif
+}
+
+/**
+ * @brief Tworzy nowy segment z macierzą n x n wypełnioną zerami.
+ *
+ * @param nazwa Nazwa segmentu.
+ * @param n Rozmiar macierzy.
+ */
+SharedMatrix::SharedMatrix(const string& nazwa, int n) {
+    if (n <= 0) {
+        cerr << "Rozmiar macierzy musi być większy od zera." << endl;
+        return;
+    }
+    otworz(nazwa, n);
+}
+
+/**
+ * @brief Tworzy nowy segment i publikuje w nim kopię macierzy.
+ *
+ * @param nazwa Nazwa segmentu.
+ * @param m Macierz źródłowa.
+ */
+SharedMatrix::SharedMatrix(const string& nazwa, const Matrix& m) : SharedMatrix(nazwa, m.rozmiar()) {
+    if (poprawna()) {
+        zapisz(m);
+    }
+}
+
+/**
+ * @brief Dołącza istniejący segment tylko do odczytu.
+ *
+ * @param nazwa Nazwa segmentu.
+ */
+SharedMatrix::SharedMatrix(const string& nazwa) {
+    otworz(nazwa, 0);
+}
+
+/**
+ * @brief Otwiera i mapuje segment.
+ *
+ * Tworzony segment ma wyłączną nazwę (O_EXCL), więc proces nie nadpisze segmentu,
+ * z którego korzystają inni. Nowe strony są zerami, a nagłówek inicjowany jest
+ * przed zwróceniem obiektu. Przy dołączaniu sprawdzane są stała, typ i długość segmentu.
+ *
+ * @param nazwa Nazwa segmentu.
+ * @param n Rozmiar tworzonej macierzy albo 0 przy dołączaniu.
+ */
+void SharedMatrix::otworz(const string& nazwa, int n) {
+#ifdef __linux__
+    const string pelna = nazwa_segmentu(nazwa);
+    const bool tworzenie = n > 0;
+    int fd = tworzenie ? shm_open(pelna.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644) : shm_open(pelna.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        cerr << (tworzenie ? "Nie można utworzyć segmentu pamięci wspólnej " : "Nie można otworzyć segmentu pamięci wspólnej ")
+             << pelna << "." << endl;
+        return;
+    }
+
+    long bajty = 0;
+    if (tworzenie) {
+        bajty = PRZESUNIECIE_DANYCH + static_cast<long>(n) * n * static_cast<long>(sizeof(int));
+        if (ftruncate(fd, bajty) != 0) {
+            cerr << "Nie można ustawić długości segmentu pamięci wspólnej " << pelna << "." << endl;
+            close(fd);
+            shm_unlink(pelna.c_str());
+            return;
+        }
+    } else {
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size < PRZESUNIECIE_DANYCH) {
+            cerr << "Segment pamięci wspólnej " << pelna << " jest uszkodzony." << endl;
+            close(fd);
+            return;
+        }
+        bajty = st.st_size;
+    }
+
+    void* p = mmap(nullptr, bajty, tworzenie ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+    close(fd); // Mapowanie pozostaje ważne po zamknięciu deskryptora
+    if (p == MAP_FAILED) {
+        cerr << "Nie można zmapować segmentu pamięci wspólnej " << pelna << "." << endl;
+        if (tworzenie) {
+            shm_unlink(pelna.c_str());
+        }
+        return;
+    }
+
+    auto m = make_shared<Mapowanie>();
+    m->adres = p;
+    m->bajty = bajty;
+
+    NaglowekPamieciWspolnej* h = static_cast<NaglowekPamieciWspolnej*>(p);
+    if (tworzenie) {
+        h = new (p) NaglowekPamieciWspolnej{MAGIA_PAMIECI_WSPOLNEJ, n, TYP_INT32, {0}};
+    } else if (h->magia != MAGIA_PAMIECI_WSPOLNEJ || h->typ != TYP_INT32 || h->rozmiar <= 0 ||
+               PRZESUNIECIE_DANYCH + static_cast<long>(h->rozmiar) * h->rozmiar * static_cast<long>(sizeof(int)) > bajty) {
+        cerr << "Segment " << pelna << " nie zawiera macierzy." << endl;
+        return;
+    }
+
+    mapowanie = move(m);
+    naglowek = h;
+    zapis = tworzenie;
+#else
+    (void)nazwa;
+    (void)n;
+    cerr << "Pamięć wspólna POSIX nie jest dostępna na tej platformie." << endl;
+#endif
+}
+
+/**
+ * @brief Zwraca wskaźnik na elementy w segmencie.
+ *
+ * @return Wskaźnik tylko do odczytu albo nullptr.
+ */
+const int* SharedMatrix::dane(void) const {
+    if (naglowek == nullptr) {
+        return nullptr;
+    }
+    return reinterpret_cast<const int*>(reinterpret_cast<const char*>(naglowek) + PRZESUNIECIE_DANYCH);
+}
+
+/**
+ * @brief Zwraca bieżącą wersję danych.
+ *
+ * Odczyt z semantyką acquire: po zobaczeniu wersji widoczne są wszystkie
+ * elementy zapisane przed jej publikacją.
+ *
+ * @return Numer wersji (0 dla niepoprawnego segmentu).
+ */
+uint64_t SharedMatrix::wersja(void) const {
+    return naglowek != nullptr ? naglowek->wersja.load(memory_order_acquire) : 0;
+}
+
+/**
+ * @brief Zaczyna zapis.
+ *
+ * @return Wskaźnik na elementy albo nullptr dla segmentu tylko do odczytu.
+ */
+int* SharedMatrix::rozpocznij_zapis(void) {
+    if (naglowek == nullptr || !zapis) {
+        cerr << "Segment pamięci wspólnej jest dostępny tylko do odczytu." << endl;
+        return nullptr;
+    }
+    if (naglowek->wersja.load(memory_order_relaxed) % 2 == 0) {
+        naglowek->wersja.fetch_add(1, memory_order_relaxed);
+        atomic_thread_fence(memory_order_release); // Nieparzysta wersja przed zmianą elementów
+    }
+    return const_cast<int*>(dane());
+}
+
+/**
+ * @brief Kończy zapis i publikuje nową, parzystą wersję (z semantyką release).
+ */
+void SharedMatrix::opublikuj(void) {
+    if (naglowek == nullptr || !zapis) {
+        return;
+    }
+    if (naglowek->wersja.load(memory_order_relaxed) % 2 != 0) {
+        naglowek->wersja.fetch_add(1, memory_order_release);
+    }
+}
+
+/**
+ * @brief Kopiuje macierz do segmentu blokami wierszy i publikuje nową wersję.
+ *
+ * @param m Macierz tego samego rozmiaru.
+ * @return true, jeśli zapis się powiódł.
+ */
+bool SharedMatrix::zapisz(const Matrix& m) {
+    if (m.rozmiar() != rozmiar() || m.dane() == nullptr) {
+        cerr << "Macierz ma inny rozmiar niż segment pamięci wspólnej." << endl;
+        return false;
+    }
+    int* d = rozpocznij_zapis();
+    if (d == nullptr) {
+        return false;
+    }
+
+    const int n = rozmiar();
+    const int* zrodlo = m.dane();
+    rownolegle_wiersze(n, n, [=](int y0, int y1) {
+        copy(zrodlo + static_cast<long>(y0) * n, zrodlo + static_cast<long>(y1) * n, d + static_cast<long>(y0) * n);
+    });
+    opublikuj();
+    return true;
+}
+
+/**
+ * @brief Kopiuje spójną wersję segmentu do zwykłej macierzy.
+ *
+ * Kopiowanie blokami wierszy odbywa się wewnątrz czytaj(), więc zapis innego
+ * procesu w trakcie kopiowania powoduje ponowienie całej kopii.
+ *
+ * @return Kopia albo niezaalokowana macierz.
+ */
+Matrix SharedMatrix::migawka(void) const {
+    if (naglowek == nullptr) {
+        return Matrix();
+    }
+
+    const int n = rozmiar();
+    Matrix m(n, bez_zerowania);
+    int* d = m.widok_zapisu().dane;
+    bool ok = czytaj([=](const int* zrodlo, int) {
+        rownolegle_wiersze(n, n, [=](int y0, int y1) {
+            copy(zrodlo + static_cast<long>(y0) * n, zrodlo + static_cast<long>(y1) * n, d + static_cast<long>(y0) * n);
+        });
+    });
+    if (!ok) {
+        cerr << "Nie udało się odczytać spójnej wersji segmentu pamięci wspólnej." << endl;
+        return Matrix();
+    }
+    return m;
+}
+
+/**
+ * @brief Usuwa nazwę segmentu.
+ *
+ * @param nazwa Nazwa segmentu.
+ * @return true, jeśli nazwa została usunięta.
+ */
+bool SharedMatrix::usun(const string& nazwa) {
+#ifdef __linux__
+    return shm_unlink(nazwa_segmentu(nazwa).c_str()) == 0;
+#else
+    (void)nazwa;
+    return false;
+#endif
+}
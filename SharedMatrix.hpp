@@ -0,0 +1,199 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include "Matrix.hpp"
+
+/**
+ * @struct NaglowekPamieciWspolnej
+ * @brief Nagłówek segmentu pamięci wspólnej poprzedzający elementy macierzy.
+ *
+ * Elementy zaczynają się PRZESUNIECIE_DANYCH bajtów od początku segmentu,
+ * więc są wyrównane do linii pamięci podręcznej.
+ */
+struct NaglowekPamieciWspolnej {
+  uint64_t magia;               /**< Stała MAGIA_PAMIECI_WSPOLNEJ identyfikująca format. */
+  int32_t rozmiar;              /**< Rozmiar macierzy n (segment zawiera n * n elementów). */
+  int32_t typ;                  /**< Typ elementów (TYP_INT32). */
+  std::atomic<uint64_t> wersja; /**< Numer wersji: nieparzysty w trakcie zapisu, parzysty po publikacji. */
+};
+
+/**
+ * @brief Stała na początku każdego segmentu ("MTRXSHM1").
+ */
+constexpr uint64_t MAGIA_PAMIECI_WSPOLNEJ = 0x314D48535852544DULL;
+
+/**
+ * @brief Oznaczenie elementów typu int32_t w nagłówku.
+ */
+constexpr int32_t TYP_INT32 = 1;
+
+/**
+ * @brief Przesunięcie elementów względem początku segmentu w bajtach.
+ */
+constexpr long PRZESUNIECIE_DANYCH = 64;
+
+/**
+ * @brief Liczba prób spójnego odczytu, zanim SharedMatrix::czytaj() się podda.
+ */
+constexpr int PROBY_ODCZYTU = 1000;
+
+static_assert(sizeof(NaglowekPamieciWspolnej) <= PRZESUNIECIE_DANYCH, "Nagłówek musi mieścić się przed danymi");
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "Wersja musi być atomowa między procesami");
+
+/**
+ * @class SharedMatrix
+ * @brief Macierz w nazwanym segmencie pamięci wspólnej POSIX, dostępna dla wielu procesów bez kopiowania.
+ *
+ * Jeden proces tworzy segment i zapisuje w nim macierz, pozostałe dołączają go tylko
+ * do odczytu: strony segmentu są wspólne, więc kolejne procesy nie zwiększają zużycia
+ * pamięci.
+ *
+ * Zmiany publikowane są jak w sekwencyjnej blokadzie: zapis zaczyna się od zmiany
+ * wersji na nieparzystą, a kończy zmianą na parzystą. Czytelnik, który przed i po
+ * odczycie zobaczy tę samą parzystą wersję, odczytał spójną macierz. czytaj()
+ * realizuje tę stronę protokołu bez kopiowania elementów, a migawka() zwraca
+ * spójną kopię jako zwykłą Matrix. Segment nie jest udostępniany jako Matrix
+ * bez kopiowania, bo zapis innego procesu zmieniałby ją pod spodem.
+ */
+class SharedMatrix {
+public:
+  /**
+   * @brief Tworzy nowy segment z macierzą n x n wypełnioną zerami.
+   * @param nazwa Nazwa segmentu (np. "/macierz"; ukośnik zostanie dodany, jeśli go brak).
+   * @param n Rozmiar macierzy.
+   */
+  SharedMatrix(const std::string& nazwa, int n);
+
+  /**
+   * @brief Tworzy nowy segment i publikuje w nim kopię macierzy.
+   * @param nazwa Nazwa segmentu.
+   * @param m Macierz źródłowa.
+   */
+  SharedMatrix(const std::string& nazwa, const Matrix& m);
+
+  /**
+   * @brief Dołącza istniejący segment tylko do odczytu.
+   * @param nazwa Nazwa segmentu.
+   */
+  explicit SharedMatrix(const std::string& nazwa);
+
+  /**
+   * @brief Sprawdza, czy segment został utworzony lub dołączony.
+   * @return true, jeśli macierz jest gotowa do użycia.
+   */
+  bool poprawna(void) const { return naglowek != nullptr; }
+
+  /**
+   * @brief Sprawdza, czy segment jest dołączony tylko do odczytu.
+   * @return true dla procesów, które nie utworzyły segmentu.
+   */
+  bool tylko_do_odczytu(void) const { return !zapis; }
+
+  /**
+   * @brief Zwraca rozmiar macierzy.
+   * @return Liczba wierszy (i kolumn) albo 0, gdy segment nie jest poprawny.
+   */
+  int rozmiar(void) const { return naglowek != nullptr ? naglowek->rozmiar : 0; }
+
+  /**
+   * @brief Zwraca wskaźnik na elementy w segmencie.
+   *
+   * Elementy mogą zmieniać się w trakcie odczytu; spójny odczyt zapewnia czytaj().
+   *
+   * @return Wskaźnik tylko do odczytu albo nullptr.
+   */
+  const int* dane(void) const;
+
+  /**
+   * @brief Zwraca bieżącą wersję danych.
+   * @return Numer wersji (nieparzysty, gdy trwa zapis).
+   */
+  uint64_t wersja(void) const;
+
+  /**
+   * @brief Zaczyna zapis: zmienia wersję na nieparzystą.
+   * @return Wskaźnik na elementy do zapisu albo nullptr dla segmentu tylko do odczytu.
+   */
+  int* rozpocznij_zapis(void);
+
+  /**
+   * @brief Kończy zapis: zmienia wersję na parzystą, udostępniając zmiany czytelnikom.
+   */
+  void opublikuj(void);
+
+  /**
+   * @brief Kopiuje macierz do segmentu i publikuje nową wersję.
+   * @param m Macierz tego samego rozmiaru.
+   * @return true, jeśli zapis się powiódł.
+   */
+  bool zapisz(const Matrix& m);
+
+  /**
+   * @brief Wywołuje f na elementach segmentu w spójnej wersji, bez ich kopiowania.
+   *
+   * Jeśli w trakcie wywołania segment został zmieniony, f wywoływana jest ponownie,
+   * więc nie powinna mieć skutków ubocznych poza wyznaczaniem wyniku. Wskaźnik
+   * przekazany do f nie może być używany po jej powrocie.
+   *
+   * @param f Funkcja (const int* dane, int n).
+   * @return true, jeśli ostatnie wywołanie f widziało spójną wersję; false, gdy
+   *         segment nie jest poprawny lub zapis nie zakończył się w PROBY_ODCZYTU próbach.
+   */
+  template <typename F>
+  bool czytaj(F f) const {
+    if (naglowek == nullptr) {
+      return false;
+    }
+    for (int proba = 0; proba < PROBY_ODCZYTU; ++proba) {
+      const uint64_t v = wersja();
+      if (v % 2 != 0) {
+        std::this_thread::yield(); // Trwa zapis
+        continue;
+      }
+      f(dane(), rozmiar());
+      std::atomic_thread_fence(std::memory_order_acquire); // Odczyt elementów przed ponownym odczytem wersji
+      if (naglowek->wersja.load(std::memory_order_relaxed) == v) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /**
+   * @brief Kopiuje spójną wersję segmentu do zwykłej macierzy.
+   * @return Kopia (niezaalokowana, gdy segment nie jest poprawny lub odczyt się nie powiódł).
+   */
+  Matrix migawka(void) const;
+
+  /**
+   * @brief Usuwa nazwę segmentu; procesy, które go dołączyły, nadal mogą z niego korzystać.
+   * @param nazwa Nazwa segmentu.
+   * @return true, jeśli nazwa została usunięta.
+   */
+  static bool usun(const std::string& nazwa);
+
+private:
+  /**
+   * @brief Zmapowany segment, odmapowywany przy zniszczeniu ostatniej kopii obiektu.
+   */
+  struct Mapowanie {
+    void* adres = nullptr;  /**< Początek segmentu w przestrzeni adresowej procesu. */
+    long bajty = 0;         /**< Długość mapowania. */
+    ~Mapowanie(void);
+  };
+
+  /**
+   * @brief Otwiera i mapuje segment.
+   * @param nazwa Nazwa segmentu.
+   * @param n Rozmiar tworzonej macierzy albo 0 przy dołączaniu.
+   */
+  void otworz(const std::string& nazwa, int n);
+
+  std::shared_ptr<Mapowanie> mapowanie;         /**< Mapowanie współdzielone przez kopie obiektu. */
+  NaglowekPamieciWspolnej* naglowek = nullptr;  /**< Nagłówek na początku segmentu. */
+  bool zapis = false;                           /**< Czy proces może zapisywać segment. */
+};
@@ -0,0 +1,1173 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <climits>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Matrix.hpp"
+#include "Asynchroniczne.hpp"
+#include "BitMatrix.hpp"
+#include "CompactMatrix.hpp"
+#include "ConcurrentMatrix.hpp"
+#include "DistributedMatrix.hpp"
+#include "FixedMatrix.hpp"
+#include "IloczynKroneckera.hpp"
+#include "IloczynPrzyrostowy.hpp"
+#include "PamiecIloczynow.hpp"
+#include "PatternMatrix.hpp"
+#include "Permutation.hpp"
+#include "Polpierscien.hpp"
+#include "Potok.hpp"
+#include "Rozklady.hpp"
+#include "SharedMatrix.hpp"
+#include "Strojenie.hpp"
+#include "SymmetricMatrix.hpp"
+#include "Transport.hpp"
+#include "TriangularMatrix.hpp"
+#ifdef __linux__
+#include <unistd.h> // dla funkcji getpid()
+#endif
+using namespace std;
+
+/**
+ * @file Sprawdzenia.cpp
+ * @brief Samosprawdzające porównania szybkich jąder z naiwnymi odpowiednikami.
+ *
+ * Każde sprawdzenie liczy ten sam wynik szybką ścieżką biblioteki i najprostszą
+ * pętlą po elementach, a następnie porównuje wyniki. Program kończy się kodem
+ * różnym od zera, jeśli którekolwiek porównanie się nie powiodło (ctest).
+ */
+
+namespace {
+
+int bledy = 0;          /**< Liczba nieudanych sprawdzeń. */
+mt19937 losowe(2024);   /**< Generator danych (stałe ziarno: powtarzalne, różne kolejne macierze). */
+
+/**
+ * @brief Wypisuje wynik sprawdzenia i zlicza niepowodzenia.
+ * @param warunek Wynik porównania.
+ * @param opis Opis sprawdzenia.
+ */
+void sprawdz(bool warunek, const string& opis) {
+    cout << (warunek ? "[ OK ] " : "[BŁĄD] ") << opis << endl;
+    if (!warunek) {
+        ++bledy;
+    }
+}
+
+/**
+ * @brief Mnoży macierze potrójną pętlą po elementach.
+ * @param a Lewy czynnik.
+ * @param b Prawy czynnik.
+ * @return Iloczyn A * B.
+ */
+Matrix naiwny_iloczyn(const Matrix& a, const Matrix& b) {
+    const int n = a.rozmiar();
+    Matrix c(n);
+    WidokMacierzy<int> w = c.widok_zapisu();
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            int s = 0;
+            for (int k = 0; k < n; ++k) {
+                s += a(i, k) * b(k, j);
+            }
+            w(i, j) = s;
+        }
+    }
+    return c;
+}
+
+/**
+ * @brief Transponuje macierz pętlą po elementach.
+ * @param a Macierz.
+ * @return Macierz A^T.
+ */
+Matrix naiwna_transpozycja(const Matrix& a) {
+    const int n = a.rozmiar();
+    Matrix t(n);
+    WidokMacierzy<int> w = t.widok_zapisu();
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            w(j, i) = a(i, j);
+        }
+    }
+    return t;
+}
+
+/**
+ * @brief Porównuje macierze element po elemencie.
+ * @param a Pierwsza macierz.
+ * @param b Druga macierz.
+ * @return true, jeśli mają ten sam rozmiar i te same elementy.
+ */
+bool rowne(const Matrix& a, const Matrix& b) {
+    if (a.rozmiar() != b.rozmiar()) {
+        return false;
+    }
+    for (int i = 0; i < a.rozmiar(); ++i) {
+        for (int j = 0; j < a.rozmiar(); ++j) {
+            if (a(i, j) != b(i, j)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Tworzy macierz o losowych elementach z przedziału [od, dod].
+ *
+ * Matrix::losuj() ustawia ziarno według zegara przy każdym wywołaniu, więc dwie
+ * macierze wylosowane w tej samej sekundzie byłyby identyczne i nie ujawniłyby
+ * zamiany czynników.
+ *
+ * @param n Rozmiar macierzy.
+ * @param od Najmniejsza wartość.
+ * @param dod Największa wartość.
+ * @return Nowa macierz.
+ */
+Matrix losowa(int n, int od = 0, int dod = 9) {
+    Matrix m(n);
+    uniform_int_distribution<int> rozklad(od, dod);
+    WidokMacierzy<int> w = m.widok_zapisu();
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            w(i, j) = rozklad(losowe);
+        }
+    }
+    return m;
+}
+
+/**
+ * @brief Porównuje rozwiązania LU, Cholesky'ego i QR z ich znanym rozwiązaniem.
+ */
+void sprawdz_rozklady(void) {
+    const int n = 40;
+    Matrix a = losowa(n);
+    Matrix s = naiwny_iloczyn(a, naiwna_transpozycja(a));
+    WidokMacierzy<int> wa = a.widok_zapisu();
+    WidokMacierzy<int> ws = s.widok_zapisu();
+    for (int i = 0; i < n; ++i) {
+        wa(i, i) += 10 * n; // Przewaga przekątnej: macierz dobrze uwarunkowana
+        ws(i, i) += n;      // A * A^T + n * I jest dodatnio określona
+    }
+
+    vector<double> x(n);
+    iota(x.begin(), x.end(), 1.0);
+    auto prawa_strona = [&](const Matrix& m) {
+        vector<double> b(n, 0.0);
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) {
+                b[i] += m(i, j) * x[j];
+            }
+        }
+        return b;
+    };
+    auto blad = [&](const vector<double>& y) {
+        double e = 0;
+        for (int i = 0; i < n; ++i) {
+            e = max(e, fabs(y[i] - x[i]));
+        }
+        return e;
+    };
+
+    LU lu(a);
+    sprawdz(lu.poprawny() && blad(lu.rozwiaz(prawa_strona(a))) < 1e-8, "LU::rozwiaz == rozwiązanie wzorcowe");
+    Cholesky ch(s);
+    sprawdz(ch.poprawny() && blad(ch.rozwiaz(prawa_strona(s))) < 1e-8, "Cholesky::rozwiaz == rozwiązanie wzorcowe");
+    QR qr(a);
+    sprawdz(qr.poprawny() && blad(qr.rozwiaz(prawa_strona(a))) < 1e-8, "QR::rozwiaz == rozwiązanie wzorcowe");
+
+    Matrix m3 = losowa(3);
+    double det = static_cast<double>(m3(0, 0)) * (m3(1, 1) * m3(2, 2) - m3(1, 2) * m3(2, 1))
+               - static_cast<double>(m3(0, 1)) * (m3(1, 0) * m3(2, 2) - m3(1, 2) * m3(2, 0))
+               + static_cast<double>(m3(0, 2)) * (m3(1, 0) * m3(2, 1) - m3(1, 1) * m3(2, 0));
+    LU lu3(m3);
+    sprawdz(!lu3.poprawny() ? det == 0 : fabs(lu3.wyznacznik() - det) < 1e-9, "LU::wyznacznik == rozwinięcie Laplace'a");
+}
+
+/**
+ * @brief Sprawdza, że zmiana kopii nie zmienia macierzy, z którą współdzieliła dane.
+ */
+void sprawdz_kopiowanie(void) {
+    const int n = 30;
+    Matrix a = losowa(n);
+    vector<int> przed(a.dane(), a.dane() + n * n);
+
+    Matrix b(a);
+    Matrix c;
+    c = a;
+    b.wstaw(2, 5, a(2, 5) + 1);
+    c.widok_zapisu()(7, 1) = -1;
+    sprawdz(equal(przed.begin(), przed.end(), a.dane()), "zapis do kopii nie zmienia oryginału");
+
+    bool zgodne = b(2, 5) == a(2, 5) + 1 && c(7, 1) == -1;
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            zgodne = zgodne && ((i == 2 && j == 5) || b(i, j) == a(i, j)) && ((i == 7 && j == 1) || c(i, j) == a(i, j));
+        }
+    }
+    sprawdz(zgodne, "kopie zawierają zapisane elementy i pozostałe elementy oryginału");
+}
+
+/**
+ * @brief Porównuje odczyty ConcurrentMatrix z macierzą, z której powstała, także podczas zapisu.
+ */
+void sprawdz_wspolbiezna(void) {
+    const int n = 37;
+    Matrix a = losowa(n);
+    ConcurrentMatrix c(a, 5);
+    c.wstaw(4, 9, 123);
+    a.wstaw(4, 9, 123);
+    vector<int> wiersz(n);
+    c.pokaz_wiersz(4, wiersz.data());
+    sprawdz(rowne(c.migawka(), a) && c.pokaz(4, 9) == 123 && equal(wiersz.begin(), wiersz.end(), a.widok_wiersza(4).begin()),
+            "ConcurrentMatrix::migawka i pokaz_wiersz == Matrix");
+
+    // Każdy zapis ustawia cały wiersz na jedną wartość, więc spójny odczyt nie może zawierać dwóch różnych
+    vector<int> zera(n, 0);
+    for (int y = 0; y < n; ++y) {
+        c.wiersz(y, zera.data());
+    }
+    atomic<bool> koniec{false};
+    thread pisarz([&] {
+        vector<int> t(n);
+        for (int k = 0; !koniec.load(); ++k) {
+            fill(t.begin(), t.end(), k);
+            c.wiersz(k % n, t.data());
+        }
+    });
+    bool spojne = true;
+    for (int proba = 0; proba < 200 && spojne; ++proba) {
+        c.pokaz_wiersz(proba % n, wiersz.data());
+        spojne = all_of(wiersz.begin(), wiersz.end(), [&](int x) { return x == wiersz[0]; });
+    }
+    koniec = true;
+    pisarz.join();
+    sprawdz(spojne, "ConcurrentMatrix::pokaz_wiersz nie widzi częściowego zapisu");
+}
+
+/**
+ * @brief Porównuje szybkie akcesory oraz gather_rows() i scatter_cols() z pętlami.
+ */
+void sprawdz_akcesory(void) {
+    const int n = 29;
+    Matrix a = losowa(n);
+    Matrix kopia(a);
+    long suma = 0;
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            suma += kopia(i, j) + kopia.widok_wiersza(i)[j] + kopia.widok_kolumny(j)[i];
+        }
+    }
+    sprawdz(suma == 3 * a.suma() && kopia.dane() == a.dane(), "odczyt z niestałej kopii nie kopiuje bufora");
+
+    kopia.element(3, 4) = 77;
+    kopia.widok_wiersza_do_zapisu(5)[6] = 78;
+    kopia.widok_kolumny_do_zapisu(7)[8] = 79;
+    sprawdz(kopia(3, 4) == 77 && kopia(5, 6) == 78 && kopia(8, 7) == 79 && kopia.dane() != a.dane(), "element() i widoki do zapisu odłączają kopię");
+
+    const int wiersze[] = {4, 0, 28, 4};
+    vector<int> t(4 * n);
+    a.gather_rows(wiersze, 4, t.data());
+    bool zgodne = true;
+    for (int k = 0; k < 4; ++k) {
+        for (int j = 0; j < n; ++j) {
+            zgodne = zgodne && t[k * n + j] == a(wiersze[k], j);
+        }
+    }
+    sprawdz(zgodne, "gather_rows == pętla");
+
+    const int kolumny[] = {1, 17, 28};
+    vector<int> u(n * 3);
+    for (int i = 0; i < n * 3; ++i) {
+        u[i] = -i;
+    }
+    Matrix b(a);
+    b.scatter_cols(kolumny, 3, u.data());
+    zgodne = true;
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            int k = j == 1 ? 0 : j == 17 ? 1 : j == 28 ? 2 : -1;
+            zgodne = zgodne && b(i, j) == (k < 0 ? a(i, j) : u[i * 3 + k]);
+        }
+    }
+    sprawdz(zgodne, "scatter_cols == pętla");
+}
+
+/**
+ * @brief Porównuje mnożenie przez PatternMatrix z materializowanymi czynnikami.
+ */
+void sprawdz_wzorcowe(void) {
+    const int n = 33;
+    Matrix m = losowa(n);
+
+    const pair<PatternMatrix::Wzor, const char*> wzory[] = {
+        {PatternMatrix::Jednostkowa, "jednostkowa"},
+        {PatternMatrix::PodPrzekatna, "pod przekątną"},
+        {PatternMatrix::NadPrzekatna, "nad przekątną"},
+        {PatternMatrix::Szachownica, "szachownica"},
+    };
+    for (const auto& [wzor, nazwa] : wzory) {
+        PatternMatrix w(wzor, n);
+        Matrix pelna = w.materializuj();
+        sprawdz(rowne(w * m, naiwny_iloczyn(pelna, m)), string("PatternMatrix * Matrix (") + nazwa + ") == pętla");
+        Matrix p(m);
+        p * w;
+        sprawdz(rowne(p, naiwny_iloczyn(m, pelna)), string("Matrix * PatternMatrix (") + nazwa + ") == pętla");
+    }
+}
+
+/**
+ * @brief Porównuje trmm, trsm i mnożenie przez TriangularMatrix z pełnymi macierzami.
+ */
+void sprawdz_trojkatne(void) {
+    const int n = 70; // Więcej niż TRMM_BLOK kolumn i niepełny ostatni pas
+    Matrix a = losowa(n);
+    Matrix m = losowa(n);
+
+    for (auto rodzaj : {TriangularMatrix<int>::Dolna, TriangularMatrix<int>::Gorna}) {
+        const string nazwa = rodzaj == TriangularMatrix<int>::Dolna ? "dolna" : "górna";
+        TriangularMatrix<int> t(rodzaj, a);
+        Matrix pelna(n);
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) {
+                pelna.element(i, j) = t(i, j);
+            }
+        }
+
+        sprawdz(rowne(t * m, naiwny_iloczyn(pelna, m)), "TriangularMatrix * Matrix (" + nazwa + ") == pętla");
+        Matrix p(m);
+        p * t;
+        sprawdz(rowne(p, naiwny_iloczyn(m, pelna)), "Matrix * TriangularMatrix (" + nazwa + ") == pętla");
+
+        // Równanie T * X = B o znanym X: B z trmm, X z powrotem z trsm
+        const bool dolna = rodzaj == TriangularMatrix<int>::Dolna;
+        TriangularMatrix<double> td(dolna ? TriangularMatrix<double>::Dolna : TriangularMatrix<double>::Gorna, n);
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) {
+                if (dolna ? j <= i : j >= i) {
+                    td.element(i, j) = i == j ? n + 1.0 : t(i, j);
+                }
+            }
+        }
+        vector<double> x(static_cast<long>(n) * n);
+        for (long i = 0; i < static_cast<long>(n) * n; ++i) {
+            x[i] = m.dane()[i];
+        }
+        vector<double> b = x;
+        trmm(td, n, b.data());
+        bool zgodne = trsm(td, n, b.data());
+        for (long i = 0; i < static_cast<long>(n) * n && zgodne; ++i) {
+            zgodne = fabs(b[i] - x[i]) < 1e-8;
+        }
+        sprawdz(zgodne, "trsm(trmm(X)) == X (" + nazwa + ")");
+    }
+}
+
+/**
+ * @brief Porównuje gram() i mnożenie przez SymmetricMatrix z pętlami.
+ */
+void sprawdz_symetryczne(void) {
+    const int n = 33;
+    Matrix m = losowa(n);
+
+    SymmetricMatrix<int> s = gram(m);
+    Matrix pelna(n);
+    s.rozpakuj(pelna.widok_zapisu().dane);
+    sprawdz(rowne(pelna, naiwny_iloczyn(m, naiwna_transpozycja(m))), "gram(A) == A * A^T");
+    Matrix b = losowa(n);
+    sprawdz(rowne(s * b, naiwny_iloczyn(pelna, b)), "SymmetricMatrix * Matrix == pętla");
+}
+
+/**
+ * @brief Porównuje operacje wielowątkowe przy każdej polityce NUMA z pętlą i sprawdza przekazywanie wyjątków.
+ */
+void sprawdz_rownolegle(void) {
+    const long prog = prog_rownoleglosci();
+    const int n = 64;
+    Matrix a = losowa(n);
+    Matrix b = losowa(n);
+    Matrix wzorzec = naiwny_iloczyn(a, b);
+
+    ustaw_liczbe_watkow(4);       // Także na maszynie z jednym rdzeniem
+    ustaw_prog_rownoleglosci(1); // Każda operacja w wielu wątkach
+    const pair<PolitykaNuma, const char*> polityki[] = {
+        {PolitykaNuma::Domyslna, "domyślna"},
+        {PolitykaNuma::Przeplatana, "przeplatana"},
+        {PolitykaNuma::PierwszyDotyk, "pierwszy dotyk"},
+    };
+    for (const auto& [p, nazwa] : polityki) {
+        ustaw_polityke_numa(p);
+        Matrix duza(1024); // Bufor mapowany przez mmap
+        Matrix c(a);
+        c * b;
+        sprawdz(duza.suma() == 0 && rowne(c, wzorzec), string("iloczyn i zerowanie w wielu wątkach (") + nazwa + ") == pętla");
+    }
+    ustaw_polityke_numa(PolitykaNuma::Domyslna);
+
+    atomic<int> wiersze{0};
+    bool przekazany = false;
+    try {
+        rownolegle_wiersze(n, 1, [&](int y0, int y1) {
+            if (y0 == 0) {
+                throw runtime_error("blok zerowy");
+            }
+            wiersze += y1 - y0;
+        });
+    } catch (const runtime_error& e) {
+        przekazany = string(e.what()) == "blok zerowy";
+    }
+    ustaw_prog_rownoleglosci(prog);
+    ustaw_liczbe_watkow(0);
+    sprawdz(przekazany && wiersze.load() > 0, "wyjątek z wątku roboczego trafia do wywołującego");
+}
+
+/**
+ * @brief Porównuje wyniki operacji asynchronicznych z pętlami.
+ */
+void sprawdz_asynchroniczne(void) {
+    const int n = 40;
+    Matrix a = losowa(n);
+    Matrix b = losowa(n);
+    Matrix f = losowa(n);
+    Zadanie za(a);
+    Zadanie zb(b);
+    Zadanie zf(f);
+
+    Zadanie suma = async_add(za, zb);
+    Zadanie roznica = async_sub(za, zb);
+    Zadanie razy = async_scale(async_transpose(za), 3);
+    bool zgodne = true;
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            zgodne = zgodne && suma.wynik()(i, j) == a(i, j) + b(i, j) && roznica.wynik()(i, j) == a(i, j) - b(i, j)
+                     && razy.wynik()(i, j) == 3 * a(j, i);
+        }
+    }
+    sprawdz(zgodne, "async_add, async_sub, async_transpose i async_scale == pętla");
+    sprawdz(rowne(async_mul(za, zb).wynik(), naiwny_iloczyn(a, b)), "async_mul == pętla");
+    sprawdz(rowne(async_chain_mul({za, zb, zf}, 16).wynik(), naiwny_iloczyn(naiwny_iloczyn(a, b), f)),
+            "async_chain_mul == pętla");
+}
+
+/**
+ * @brief Porównuje iloczyn i transpozycję przy nietypowych parametrach strojenia z pętlami.
+ */
+void sprawdz_strojenie(void) {
+    const int n = 45;
+    Matrix a = losowa(n);
+    Matrix b = losowa(n);
+    const ProfilStrojenia domyslny = biezacy_profil();
+
+    ProfilStrojenia p = domyslny;
+    p.gemm = {5, 7, 3}; // Bloki, które nie dzielą rozmiaru macierzy
+    p.blok_transpozycji = 6;
+    zastosuj_profil(p);
+    Matrix c(a);
+    c * b;
+    Matrix t(a);
+    t.dowroc();
+    sprawdz(rowne(c, naiwny_iloczyn(a, b)) && rowne(t, naiwna_transpozycja(a)), "iloczyn i dowroc() przy nietypowych blokach == pętla");
+
+    const string plik = "Sprawdzenia.profil";
+    bool odczytany = zapisz_profil(p, plik);
+    zastosuj_profil(domyslny);
+    odczytany = odczytany && wczytaj_profil(plik);
+    ProfilStrojenia w = biezacy_profil();
+    remove(plik.c_str());
+    zastosuj_profil(domyslny);
+    sprawdz(odczytany && w.gemm.i == 5 && w.gemm.k == 7 && w.gemm.j == 3 && w.blok_transpozycji == 6,
+            "wczytaj_profil(zapisz_profil(p)) == p");
+}
+
+/**
+ * @brief Porównuje operatory porównania i skrót z pętlami.
+ */
+void sprawdz_porownania(void) {
+    const int n = 300; // Kilka bloków porównania i skrótu
+    Matrix a = losowa(n);
+    Matrix b(n);
+    WidokMacierzy<int> wb = b.widok_zapisu();
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            wb(i, j) = a(i, j);
+        }
+    }
+    sprawdz(a == b && !(a != b) && a.skrot() == b.skrot(), "równe macierze w osobnych buforach: ==, != i skrot()");
+
+    b.element(n - 1, n - 1) += 1;
+    sprawdz(!(a == b) && a != b && a.skrot() != b.skrot(), "różnica w ostatnim elemencie: ==, != i skrot()");
+
+    Matrix c = a.map([](int x) { return x + 1; });
+    bool wieksze = c > a;
+    bool mniejsze = a < c;
+    c.element(n / 2, 7) = a(n / 2, 7);
+    sprawdz(wieksze && mniejsze && !(c > a) && !(a < c), "operatory > i < == pętla");
+
+    Matrix e(a);
+    a.skrot();
+    e.skrot();
+    e.element(1, 1) += 1;
+    sprawdz(!(e == a) && e != a, "operator== po zapisie przez referencję");
+}
+
+/**
+ * @brief Porównuje iloczyny zwracane przez PamiecIloczynow z pętlą, także po zapisie przez widok.
+ */
+void sprawdz_pamiec_iloczynow(void) {
+    const int n = 40;
+    Matrix a = losowa(n);
+    Matrix b = losowa(n);
+    PamiecIloczynow pamiec(1 << 20);
+    ustaw_pamiec_iloczynow(&pamiec);
+
+    Matrix c(a);
+    c * b;
+    Matrix d(a);
+    d * b;
+    sprawdz(pamiec.trafienia() == 1 && rowne(c, naiwny_iloczyn(a, b)) && rowne(d, c), "powtórzony iloczyn z pamięci == pętla");
+
+    // Widok pobrany przed pierwszym mnożeniem: jego zapis nie zmienia zapamiętanego skrótu h,
+    // a kopia h w pamięci nie może dzielić z nim bufora
+    Matrix h = losowa(n);
+    WidokMacierzy<int> v = h.widok_zapisu();
+    Matrix e(a);
+    e * h;
+    v(1, 0) = 100;
+    Matrix f(a);
+    f * h;
+    sprawdz(h(1, 0) == 100 && rowne(f, naiwny_iloczyn(a, h)), "iloczyn z pamięci po zapisie przez wcześniej pobrany widok == pętla");
+
+    a.widok_zapisu()(1, 1) += 1;
+    Matrix g(a);
+    g * b;
+    sprawdz(rowne(g, naiwny_iloczyn(a, b)), "iloczyn z pamięci po zmianie czynnika == pętla");
+    ustaw_pamiec_iloczynow(nullptr);
+}
+
+/**
+ * @brief Porównuje IloczynPrzyrostowy z pętlą i sprawdza, że sam odczyt nie wymusza przeliczenia.
+ */
+void sprawdz_przyrostowy(void) {
+    const int n = 60;
+    Matrix a = losowa(n);
+    Matrix b = losowa(n);
+    IloczynPrzyrostowy p(a, b);
+
+    long suma = 0;
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            suma += a(i, j) + b.widok_wiersza(i)[j] + b.widok_kolumny(j)[i];
+        }
+    }
+    p.aktualizuj();
+    sprawdz(suma == a.suma() + 2 * b.suma() && p.ostatnia_poprawka() == 0, "odczyt z niestałych czynników: aktualizuj() bez pracy");
+
+    a.element(3, 7) = 11;
+    b.wstaw(5, 2, -4);
+    sprawdz(rowne(p.aktualizuj(), naiwny_iloczyn(a, b)) && p.ostatnia_poprawka() == 2, "IloczynPrzyrostowy po zmianie dwóch elementów == pętla");
+    b.widok_kolumny_do_zapisu(9)[0] = 3;
+    sprawdz(rowne(p.aktualizuj(), naiwny_iloczyn(a, b)) && p.ostatnia_poprawka() == 1, "IloczynPrzyrostowy po zmianie kolumny B == pętla");
+    TriangularMatrix<int> t(TriangularMatrix<int>::Gorna, losowa(n));
+    a * t;
+    sprawdz(rowne(p.aktualizuj(), naiwny_iloczyn(a, b)), "IloczynPrzyrostowy po a * TriangularMatrix == pętla");
+}
+
+/**
+ * @brief Porównuje iloczyn liczony przez PotokMnozenia z pętlą dla źródła z macierzy i ze strumienia.
+ */
+void sprawdz_potok(void) {
+    const int n = 50; // Ostatni blok wierszy jest niepełny
+    Matrix a = losowa(n);
+    Matrix b = losowa(n);
+    Matrix wzorzec = naiwny_iloczyn(a, b);
+    PotokMnozenia potok(b, 2);
+
+    Matrix w(n);
+    sprawdz(potok.przetworz(zrodlo_z_macierzy(a, 7), ujscie_do_macierzy(w)) == n && rowne(w, wzorzec),
+            "PotokMnozenia (źródło z macierzy) == pętla");
+
+    stringstream we;
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            we << a(i, j) << ' ';
+        }
+        we << '\n';
+    }
+    Matrix v(n);
+    sprawdz(potok.przetworz(zrodlo_ze_strumienia(we, n, 9), ujscie_do_macierzy(v)) == n && rowne(v, wzorzec),
+            "PotokMnozenia (źródło ze strumienia) == pętla");
+}
+
+/**
+ * @brief Porównuje iloczyny BitMatrix (metoda czterech Rosjan) i domknięcie przechodnie z pętlami.
+ */
+void sprawdz_bitowe(void) {
+    const int n = 100; // Wiersze nie są wielokrotnością 64 bitów
+    Matrix a = losowa(n).map([](int x) { return x < 2 ? 1 : 0; });
+    Matrix b = losowa(n, 0, 1);
+    BitMatrix ba(a);
+    BitMatrix bb(b);
+
+    Matrix c = naiwny_iloczyn(a, b);
+    sprawdz(rowne(ba.materializuj(), a) && ba.liczba_jedynek() == a.suma(), "BitMatrix::materializuj i liczba_jedynek == Matrix");
+    sprawdz(rowne(ba.iloczyn_zliczajacy(bb), c), "BitMatrix::iloczyn_zliczajacy == pętla");
+    sprawdz(rowne(ba.iloczyn_logiczny(bb).materializuj(), c.map([](int x) { return x > 0 ? 1 : 0; })),
+            "BitMatrix::iloczyn_logiczny == pętla");
+    sprawdz(rowne(ba.transponuj().materializuj(), naiwna_transpozycja(a)), "BitMatrix::transponuj == pętla");
+
+    // Rzadki graf (średnio ok. jednej krawędzi na wierzchołek), więc domknięcie nie jest pełne
+    Matrix g = losowa(n, 0, 99).map([](int x) { return x == 0 ? 1 : 0; });
+    Matrix r(g);
+    WidokMacierzy<int> w = r.widok_zapisu();
+    for (int i = 0; i < n; ++i) {
+        w(i, i) = 1;
+    }
+    for (int k = 0; k < n; ++k) { // Warshall
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) {
+                w(i, j) |= w(i, k) & w(k, j);
+            }
+        }
+    }
+    sprawdz(rowne(BitMatrix(g).osiagalnosc().materializuj(), r) && r.suma() < static_cast<long long>(n) * n,
+            "BitMatrix::osiagalnosc == algorytm Warshalla");
+}
+
+/**
+ * @brief Mnoży macierze nad półpierścieniem tropikalnym pętlą, pomijając brakujące krawędzie.
+ * @param a Lewy czynnik.
+ * @param b Prawy czynnik.
+ * @param minimum true dla (min, +), false dla (max, +).
+ * @return Iloczyn z NIESKONCZONOSC (lub -NIESKONCZONOSC) tam, gdzie nie ma ścieżki.
+ */
+Matrix naiwny_tropikalny(const Matrix& a, const Matrix& b, bool minimum) {
+    const int n = a.rozmiar();
+    const int brak = minimum ? polpierscienie::NIESKONCZONOSC : -polpierscienie::NIESKONCZONOSC;
+    auto krawedz = [&](int x) { return minimum ? x < polpierscienie::NIESKONCZONOSC : x > -polpierscienie::NIESKONCZONOSC; };
+    Matrix c(n);
+    WidokMacierzy<int> w = c.widok_zapisu();
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            int najlepsza = brak;
+            for (int k = 0; k < n; ++k) {
+                if (krawedz(a(i, k)) && krawedz(b(k, j))) {
+                    najlepsza = minimum ? min(najlepsza, a(i, k) + b(k, j)) : max(najlepsza, a(i, k) + b(k, j));
+                }
+            }
+            w(i, j) = najlepsza;
+        }
+    }
+    return c;
+}
+
+/**
+ * @brief Porównuje iloczyny i potęgi nad półpierścieniami z pętlami, także przy ujemnych wagach.
+ */
+void sprawdz_polpierscienie(void) {
+    using polpierscienie::NIESKONCZONOSC;
+    const int n = 40;
+    sprawdz(polpierscienie::MinPlus::mnoz(NIESKONCZONOSC, -3) == NIESKONCZONOSC
+            && polpierscienie::MinPlus::mnoz(-3, INT_MAX) == NIESKONCZONOSC
+            && polpierscienie::MaxPlus::mnoz(-NIESKONCZONOSC, 3) == -NIESKONCZONOSC
+            && polpierscienie::MaxPlus::mnoz(INT_MIN, 3) == -NIESKONCZONOSC,
+            "nieskończoność pochłania mnożenie (MinPlus, MaxPlus)");
+
+    // Wagi -5..9, około 80% brakujących krawędzi (część par nie ma ścieżki); w h brak krawędzi to INT_MAX
+    Matrix g = losowa(n, -5, 9).zip_inplace(losowa(n), [](int x, int r) { return r < 8 ? NIESKONCZONOSC : x; });
+    Matrix h = losowa(n, -5, 9).zip_inplace(losowa(n), [](int x, int r) { return r < 8 ? INT_MAX : x; });
+    Matrix h_norm = h.map([](int x) { return min(x, NIESKONCZONOSC); });
+
+    Matrix p(g);
+    p.iloczyn(h, Polpierscien::MinPlus);
+    sprawdz(rowne(p, naiwny_tropikalny(g, h_norm, true)), "iloczyn(MinPlus) z ujemnymi wagami == pętla");
+
+    Matrix q(g);
+    q.potega(3, Polpierscien::MinPlus);
+    sprawdz(rowne(q, naiwny_tropikalny(naiwny_tropikalny(g, g, true), g, true)), "potega(3, MinPlus) z ujemnymi wagami == pętla");
+
+    Matrix gm = g.map([](int x) { return x == NIESKONCZONOSC ? -NIESKONCZONOSC : x; });
+    Matrix r(gm);
+    r.iloczyn(gm, Polpierscien::MaxPlus);
+    sprawdz(rowne(r, naiwny_tropikalny(gm, gm, false)), "iloczyn(MaxPlus) z ujemnymi wagami == pętla");
+
+    Matrix a = losowa(n);
+    Matrix b = losowa(n);
+    Matrix mm(a);
+    mm.iloczyn(b, Polpierscien::MaxMin);
+    Matrix lg(a);
+    lg.iloczyn(b, Polpierscien::Logiczny);
+    bool zgodne = true;
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            int przepustowosc = -NIESKONCZONOSC;
+            int polaczenie = 0;
+            for (int k = 0; k < n; ++k) {
+                przepustowosc = max(przepustowosc, min(a(i, k), b(k, j)));
+                polaczenie |= a(i, k) != 0 && b(k, j) != 0;
+            }
+            zgodne = zgodne && mm(i, j) == przepustowosc && lg(i, j) == polaczenie;
+        }
+    }
+    sprawdz(zgodne, "iloczyn(MaxMin) i iloczyn(Logiczny) == pętla");
+
+    Matrix s(a);
+    s.potega(3, Polpierscien::PlusRazy);
+    sprawdz(rowne(s, naiwny_iloczyn(naiwny_iloczyn(a, a), a)), "potega(3, PlusRazy) == A * A * A");
+}
+
+/**
+ * @brief Porównuje redukcje (także liczone w wielu wątkach) z pętlami.
+ */
+void sprawdz_redukcje(void) {
+    const int n = 45;
+    Matrix a = losowa(n, -4, 5);
+
+    long long suma = 0;
+    long long slad = 0;
+    long long norma_1 = 0;
+    long long norma_nieskonczonosc = 0;
+    double kwadraty = 0;
+    PozycjaElementu najmniejszy{INT_MAX, -1, -1};
+    PozycjaElementu najwiekszy{INT_MIN, -1, -1};
+    vector<long long> wiersze(n, 0);
+    vector<long long> kolumny(n, 0);
+    for (int i = 0; i < n; ++i) {
+        long long wiersz = 0;
+        long long kolumna = 0;
+        for (int j = 0; j < n; ++j) {
+            suma += a(i, j);
+            wiersze[i] += a(i, j);
+            kolumny[j] += a(i, j);
+            wiersz += abs(a(i, j));
+            kolumna += abs(a(j, i));
+            kwadraty += static_cast<double>(a(i, j)) * a(i, j);
+            if (a(i, j) < najmniejszy.wartosc) {
+                najmniejszy = {a(i, j), i, j};
+            }
+            if (a(i, j) > najwiekszy.wartosc) {
+                najwiekszy = {a(i, j), i, j};
+            }
+        }
+        slad += a(i, i);
+        norma_1 = max(norma_1, kolumna);
+        norma_nieskonczonosc = max(norma_nieskonczonosc, wiersz);
+    }
+    auto ta_sama = [](const PozycjaElementu& p, const PozycjaElementu& q) {
+        return p.wartosc == q.wartosc && p.wiersz == q.wiersz && p.kolumna == q.kolumna;
+    };
+
+    const long prog = prog_rownoleglosci();
+    for (long p : {prog, 1L}) {
+        ustaw_prog_rownoleglosci(p);
+        ustaw_liczbe_watkow(p == 1 ? 4 : 0);
+        const string tryb = p == 1 ? " (wiele wątków)" : "";
+        sprawdz(a.suma() == suma && a.slad() == slad && a.sumy_wierszy() == wiersze && a.sumy_kolumn() == kolumny,
+                "suma(), slad(), sumy_wierszy() i sumy_kolumn() == pętla" + tryb);
+        sprawdz(ta_sama(a.minimum(), najmniejszy) && ta_sama(a.maksimum(), najwiekszy), "minimum() i maksimum() z pozycją == pętla" + tryb);
+        sprawdz(a.norma_1() == norma_1 && a.norma_nieskonczonosc() == norma_nieskonczonosc
+                && fabs(a.norma_frobeniusa() - sqrt(kwadraty)) < 1e-9, "normy == pętla" + tryb);
+        Statystyki s = a.statystyki();
+        sprawdz(s.suma == suma && s.slad == slad && ta_sama(s.minimum, najmniejszy) && ta_sama(s.maksimum, najwiekszy)
+                && s.norma_1 == norma_1 && s.norma_nieskonczonosc == norma_nieskonczonosc
+                && fabs(s.norma_frobeniusa - sqrt(kwadraty)) < 1e-9, "statystyki() == pętla" + tryb);
+    }
+    ustaw_prog_rownoleglosci(prog);
+    ustaw_liczbe_watkow(0);
+}
+
+/**
+ * @brief Porównuje map, zip i ich wersje w miejscu (także liczone w wielu wątkach) z pętlą.
+ */
+void sprawdz_mapowanie(void) {
+    const int n = 45;
+    Matrix a = losowa(n, -4, 5);
+    Matrix b = losowa(n);
+    auto podwoj = [](int x) { return 2 * x; };
+    auto zwieksz = [](int x) { return x + 1; };
+    auto roznica = [](int x, int y) { return x - y; };
+
+    const long prog = prog_rownoleglosci();
+    for (long p : {prog, 1L}) {
+        ustaw_prog_rownoleglosci(p);
+        ustaw_liczbe_watkow(p == 1 ? 4 : 0);
+        const string tryb = p == 1 ? " (wiele wątków)" : "";
+        Matrix m = a.map(podwoj, zwieksz);
+        Matrix z = zip(a, b, roznica, podwoj);
+        Matrix mw(a);
+        mw.map_inplace(podwoj, zwieksz);
+        Matrix zw(a);
+        zw.zip_inplace(b, roznica, podwoj);
+        bool zgodne_map = true;
+        bool zgodne_zip = true;
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) {
+                zgodne_map = zgodne_map && m(i, j) == 2 * a(i, j) + 1 && mw(i, j) == m(i, j);
+                zgodne_zip = zgodne_zip && z(i, j) == 2 * (a(i, j) - b(i, j)) && zw(i, j) == z(i, j);
+            }
+        }
+        sprawdz(zgodne_map, "map() i map_inplace() == pętla" + tryb);
+        sprawdz(zgodne_zip, "zip() i zip_inplace() == pętla" + tryb);
+    }
+    ustaw_prog_rownoleglosci(prog);
+    ustaw_liczbe_watkow(0);
+
+    Matrix c(a);
+    c.map_inplace(zwieksz);
+    sprawdz(rowne(c, a.map(zwieksz)), "map_inplace() na kopii nie zmienia oryginału");
+}
+
+/**
+ * @brief Porównuje iloczyny Hadamarda i Kroneckera oraz IloczynKroneckera::razy z pętlą.
+ */
+void sprawdz_elementowe(void) {
+    const int n = 45;
+    Matrix a = losowa(n, -4, 5);
+    Matrix b = losowa(n);
+    Matrix przed = a.map([](int x) { return x; });
+    Matrix h(a);
+    h.hadamard(b);
+    bool zgodne = true;
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            zgodne = zgodne && h(i, j) == a(i, j) * b(i, j);
+        }
+    }
+    sprawdz(zgodne && rowne(a, przed), "hadamard() == pętla, oryginał bez zmian");
+
+    Matrix k1 = losowa(5, -3, 3);
+    Matrix k2 = losowa(7);
+    Matrix k = k1.kronecker(k2);
+    zgodne = k.rozmiar() == 35;
+    for (int i = 0; i < 35 && zgodne; ++i) {
+        for (int j = 0; j < 35; ++j) {
+            zgodne = zgodne && k(i, j) == k1(i / 7, j / 7) * k2(i % 7, j % 7);
+        }
+    }
+    sprawdz(zgodne, "kronecker() == pętla");
+
+    vector<double> x(35);
+    iota(x.begin(), x.end(), -10.0);
+    IloczynKroneckera kr(k1, k2);
+    vector<double> y = kr.razy(x);
+    zgodne = y.size() == 35 && rowne(kr.materializuj(), k);
+    for (int i = 0; i < 35 && zgodne; ++i) {
+        double s = 0;
+        for (int j = 0; j < 35; ++j) {
+            s += k(i, j) * x[j];
+        }
+        zgodne = fabs(y[i] - s) < 1e-9;
+    }
+    sprawdz(zgodne, "IloczynKroneckera::razy() == pętla");
+}
+
+/**
+ * @brief Sprawdza zerowanie nowych macierzy oraz zmien_rozmiar() i rezerwuj().
+ *
+ * Zmniejszenie i ponowne powiększenie w granicach pojemności odbywa się w miejscu,
+ * więc nowe elementy nie mogą zawierać pozostałości po wcześniejszej zawartości.
+ */
+void sprawdz_rozmiar(void) {
+    bool zera = true;
+    for (int n : {7, 300, 1100}) { // Mała, średnia i duża (bufor z mmap) macierz
+        Matrix z(n);
+        zera = zera && all_of(z.dane(), z.dane() + static_cast<long>(n) * n, [](int v) { return v == 0; });
+    }
+    sprawdz(zera, "nowa macierz zawiera zera");
+
+    auto zgodna = [](const Matrix& m, const Matrix& a, int wspolne) {
+        for (int i = 0; i < m.rozmiar(); ++i) {
+            for (int j = 0; j < m.rozmiar(); ++j) {
+                if (m(i, j) != (i < wspolne && j < wspolne ? a(i, j) : 0)) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    };
+
+    Matrix a = losowa(10, 1, 9);
+    Matrix m(a);
+    m.zmien_rozmiar(17);
+    sprawdz(m.rozmiar() == 17 && zgodna(m, a, 10) && a.rozmiar() == 10 && a(9, 9) != 0,
+            "zmien_rozmiar() w górę zachowuje blok i zeruje resztę, oryginał bez zmian");
+    m.zmien_rozmiar(6);
+    sprawdz(m.rozmiar() == 6 && zgodna(m, a, 6), "zmien_rozmiar() w dół zachowuje blok");
+    const int* bufor = m.dane();
+    m.zmien_rozmiar(12);
+    sprawdz(m.dane() == bufor && zgodna(m, a, 6), "zmien_rozmiar() w granicach pojemności zeruje nowe elementy w miejscu");
+
+    Matrix r(a);
+    r.rezerwuj(40);
+    bufor = r.dane();
+    sprawdz(r.pojemnosc() >= 40 * 40 && r.rozmiar() == 10 && rowne(r, a), "rezerwuj() nie zmienia rozmiaru ani zawartości");
+    r.zmien_rozmiar(40);
+    sprawdz(r.dane() == bufor && zgodna(r, a, 10), "zmien_rozmiar() po rezerwuj() nie alokuje i zeruje nowe elementy");
+}
+
+/**
+ * @brief Porównuje CompactMatrix (w tym iloczyn po poszerzeniu zapisu) z Matrix.
+ */
+void sprawdz_spakowane(void) {
+    const int n = 50;
+    Matrix a = losowa(n);
+    Matrix b = losowa(n);
+    CompactMatrix ca(a);
+    CompactMatrix cb(b);
+    sprawdz(ca.szerokosc() == SzerokoscElementu::Bity4 && rowne(ca.materializuj(), a), "CompactMatrix(0..9) na 4 bitach");
+    sprawdz(rowne(ca.iloczyn(cb).materializuj(), naiwny_iloczyn(a, b)), "CompactMatrix::iloczyn() == pętla");
+
+    ca.wstaw(2, 3, -1000);
+    a.element(2, 3) = -1000;
+    sprawdz(ca.szerokosc() == SzerokoscElementu::Bity16 && rowne(ca.materializuj(), a), "CompactMatrix::wstaw() poszerza zapis");
+    sprawdz(rowne(ca.iloczyn(cb).materializuj(), naiwny_iloczyn(a, b)), "CompactMatrix::iloczyn() po poszerzeniu == pętla");
+
+    const long prog = prog_rownoleglosci();
+    ustaw_prog_rownoleglosci(1);
+    ustaw_liczbe_watkow(4);
+    sprawdz(rowne(ca.materializuj(), a), "CompactMatrix::materializuj() == Matrix (wiele wątków)");
+    ustaw_prog_rownoleglosci(prog);
+    ustaw_liczbe_watkow(0);
+
+    // Iloczyn jest zerowy, ale oszacowanie jego zakresu przekracza long long bez przycięcia
+    Matrix g(2);
+    g.element(0, 1) = INT_MAX - 1;
+    CompactMatrix cg(g);
+    CompactMatrix gg = cg.iloczyn(cg);
+    sprawdz(gg.szerokosc() == SzerokoscElementu::Bity32 && rowne(gg.materializuj(), naiwny_iloczyn(g, g)),
+            "CompactMatrix::iloczyn() przy skrajnych wartościach == pętla");
+}
+
+/**
+ * @brief Porównuje migawki SharedMatrix z zapisanymi macierzami.
+ */
+void sprawdz_wspoldzielone(void) {
+#ifdef __linux__
+    const int n = 60;
+    const string nazwa = "/Sprawdzenia_" + to_string(getpid());
+    Matrix a = losowa(n);
+    Matrix b = losowa(n);
+    SharedMatrix::usun(nazwa);
+    {
+        SharedMatrix pisarz(nazwa, a);
+        SharedMatrix czytelnik(nazwa);
+        if (!pisarz.poprawna() || !czytelnik.poprawna()) {
+            sprawdz(false, "SharedMatrix(\"" + nazwa + "\")");
+            SharedMatrix::usun(nazwa);
+            return;
+        }
+        sprawdz(czytelnik.tylko_do_odczytu() && czytelnik.rozmiar() == n && rowne(czytelnik.migawka(), a),
+                "SharedMatrix::migawka() == zapisana macierz");
+
+        const uint64_t wersja = czytelnik.wersja();
+        pisarz.zapisz(b);
+        sprawdz(czytelnik.wersja() == wersja + 2 && rowne(czytelnik.migawka(), b), "SharedMatrix::zapisz() publikuje nową wersję");
+
+        const long prog = prog_rownoleglosci();
+        ustaw_prog_rownoleglosci(1);
+        ustaw_liczbe_watkow(4);
+        sprawdz(rowne(czytelnik.migawka(), b), "SharedMatrix::migawka() == zapisana macierz (wiele wątków)");
+        ustaw_prog_rownoleglosci(prog);
+        ustaw_liczbe_watkow(0);
+
+        int* d = pisarz.rozpocznij_zapis();
+        d[n + 1] = -7;
+        pisarz.opublikuj();
+        Matrix c = czytelnik.migawka();
+        sprawdz(c(1, 1) == -7 && c(0, 0) == b(0, 0), "SharedMatrix::rozpocznij_zapis() i opublikuj()");
+    }
+    sprawdz(SharedMatrix::usun(nazwa), "SharedMatrix::usun()");
+#endif
+}
+
+/**
+ * @brief Porównuje działania FixedMatrix wyznaczone przez kompilator z pętlą.
+ */
+void sprawdz_stale(void) {
+    constexpr int n = 6;
+    static constexpr FixedMatrix<n> a([] {
+        array<int, n * n> t{};
+        for (int i = 0; i < n * n; ++i) {
+            t[i] = (i * 7 + 3) % 10 - 4;
+        }
+        return t;
+    }());
+    static constexpr FixedMatrix<n> b([] {
+        array<int, n * n> t{};
+        for (int i = 0; i < n * n; ++i) {
+            t[i] = (i * 5 + 1) % 9;
+        }
+        return t;
+    }());
+    static constexpr FixedMatrix<n> iloczyn = a * b;
+    static constexpr FixedMatrix<n> suma = a + b;
+    static constexpr FixedMatrix<n> transpozycja = a.dowroc();
+    static constexpr FixedMatrix<n> potega = a.potega(3);
+    static_assert(FixedMatrix<n>::przekatna() * a == a, "Macierz jednostkowa musi być elementem neutralnym");
+
+    Matrix wa = a.widok();
+    Matrix wb = b.widok();
+    sprawdz(wa.dane() == a.elementy().data() && rowne(iloczyn.widok(), naiwny_iloczyn(wa, wb)), "FixedMatrix * FixedMatrix == pętla");
+    bool zgodne = true;
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            zgodne = zgodne && suma.pokaz(i, j) == a.pokaz(i, j) + b.pokaz(i, j);
+        }
+    }
+    sprawdz(zgodne, "FixedMatrix + FixedMatrix == pętla");
+    sprawdz(rowne(transpozycja.widok(), naiwna_transpozycja(wa)), "FixedMatrix::dowroc() == pętla");
+    sprawdz(rowne(potega.widok(), naiwny_iloczyn(naiwny_iloczyn(wa, wa), wa)), "FixedMatrix::potega(3) == A * A * A");
+
+    Matrix w = a.widok();
+    w.element(0, 0) = 100;
+    sprawdz(w(0, 0) == 100 && a.pokaz(0, 0) == -1 && wa(0, 0) == -1, "zapis do widok() nie zmienia FixedMatrix");
+}
+
+/**
+ * @brief Porównuje permutacje wierszy, kolumn i RCM z mnożeniem przez macierz permutacji.
+ */
+void sprawdz_permutacje(void) {
+    auto losowa_permutacja = [](int n) {
+        vector<int> indeksy(n);
+        iota(indeksy.begin(), indeksy.end(), 0);
+        shuffle(indeksy.begin(), indeksy.end(), losowe);
+        return Permutation(indeksy);
+    };
+
+    const int n = 64;
+    Permutation p = losowa_permutacja(n);
+    Matrix pm = p.macierz();
+    Matrix a = losowa(n);
+
+    Matrix w(a);
+    w.permutuj_wiersze(p);
+    sprawdz(rowne(w, naiwny_iloczyn(pm, a)), "permutuj_wiersze() == P * A");
+    Matrix k(a);
+    k.permutuj_kolumny(p);
+    sprawdz(rowne(k, naiwny_iloczyn(a, naiwna_transpozycja(pm))), "permutuj_kolumny() == A * P^T");
+
+    // Kilka pasków wierszy i kafelków kolumn, także w wielu wątkach
+    const int d = 1500;
+    Permutation q = losowa_permutacja(d);
+    Matrix b = losowa(d);
+    const long prog = prog_rownoleglosci();
+    for (long t : {prog, 1L}) {
+        ustaw_prog_rownoleglosci(t);
+        ustaw_liczbe_watkow(t == 1 ? 4 : 0);
+        Matrix kb(b);
+        kb.permutuj_kolumny(q);
+        bool zgodne = true;
+        for (int i = 0; i < d; ++i) {
+            for (int j = 0; j < d; ++j) {
+                zgodne = zgodne && kb(i, j) == b(i, q[j]);
+            }
+        }
+        sprawdz(zgodne, string("permutuj_kolumny() == pętla dla n = 1500") + (t == 1 ? " (wiele wątków)" : ""));
+    }
+    ustaw_prog_rownoleglosci(prog);
+    ustaw_liczbe_watkow(0);
+
+    // Macierz pasmowa z pomieszanymi indeksami: RCM powinno przywrócić wąskie pasmo
+    Matrix pasmowa(n);
+    for (int i = 0; i < n; ++i) {
+        for (int j = max(0, i - 2); j <= min(n - 1, i + 2); ++j) {
+            pasmowa.element(i, j) = 1;
+        }
+    }
+    Matrix pomieszana(pasmowa);
+    pomieszana.permutuj(p);
+    Permutation r = Permutation::odwrotny_cuthill_mckee(pomieszana);
+    vector<int> posortowane = r.indeksy();
+    sort(posortowane.begin(), posortowane.end());
+    vector<int> kolejne(n);
+    iota(kolejne.begin(), kolejne.end(), 0);
+    Matrix uporzadkowana(pomieszana);
+    uporzadkowana.permutuj(r);
+    Matrix rm = r.macierz();
+    sprawdz(posortowane == kolejne, "odwrotny_cuthill_mckee() zwraca permutację");
+    sprawdz(rowne(uporzadkowana, naiwny_iloczyn(naiwny_iloczyn(rm, pomieszana), naiwna_transpozycja(rm))), "permutuj() == P * A * P^T");
+    sprawdz(uporzadkowana.pasmo() <= pasmowa.pasmo() && pomieszana.pasmo() > pasmowa.pasmo(), "odwrotny_cuthill_mckee() zwęża pasmo");
+}
+
+/**
+ * @brief Porównuje iloczyn SUMMA zebrany w randze 0 z pętlą dla kilku siatek procesów.
+ *
+ * Procesy tworzone są przez fork(), dlatego sprawdzenie musi poprzedzać operacje,
+ * które pozostawiają działające wątki (np. Harmonogram::domyslny()).
+ */
+void sprawdz_rozproszone(void) {
+#ifdef __linux__
+    const int n = 50; // Liczba bloków nie dzieli się przez wymiary siatek
+    Matrix a = losowa(n);
+    Matrix b = losowa(n);
+    Matrix wzorzec = naiwny_iloczyn(a, b);
+
+    for (int rangi : {1, 3, 4}) {
+        unique_ptr<TransportLokalny> t = TransportLokalny::uruchom(rangi);
+        if (!t) {
+            sprawdz(false, "TransportLokalny::uruchom(" + to_string(rangi) + ")");
+            continue;
+        }
+
+        DistributedMatrix da(*t, n, 8);
+        DistributedMatrix db(*t, n, 8);
+        bool rozeslane = da.rozprosz(a);
+        rozeslane = db.rozprosz(b) && rozeslane;
+        DistributedMatrix dc = da.iloczyn(db);
+        Matrix c = dc.zbierz();
+        if (t->ranga() != 0) {
+            t->zakoncz(rozeslane && dc.poprawna() ? 0 : 1);
+        }
+        bool potomne = t->zakoncz();
+        sprawdz(rozeslane && dc.poprawna() && potomne && rowne(c, wzorzec),
+                "zbierz(iloczyn()) == pętla (rangi: " + to_string(rangi) + ")");
+    }
+#endif
+}
+
+} // namespace
+
+/**
+ * @brief Uruchamia wszystkie sprawdzenia.
+ * @return 0, jeśli wszystkie porównania się powiodły, 1 w przeciwnym razie.
+ */
+int main() {
+    sprawdz_rozproszone(); // Przed wszystkim, co uruchamia wątki
+    sprawdz_rozklady();
+    sprawdz_kopiowanie();
+    sprawdz_wspolbiezna();
+    sprawdz_akcesory();
+    sprawdz_wzorcowe();
+    sprawdz_trojkatne();
+    sprawdz_symetryczne();
+    sprawdz_rownolegle();
+    sprawdz_asynchroniczne();
+    sprawdz_strojenie();
+    sprawdz_porownania();
+    sprawdz_pamiec_iloczynow();
+    sprawdz_przyrostowy();
+    sprawdz_potok();
+    sprawdz_bitowe();
+    sprawdz_polpierscienie();
+    sprawdz_redukcje();
+    sprawdz_mapowanie();
+    sprawdz_elementowe();
+    sprawdz_rozmiar();
+    sprawdz_spakowane();
+    sprawdz_wspoldzielone();
+    sprawdz_stale();
+    sprawdz_permutacje();
+
+    cout << (bledy == 0 ? "Wszystkie sprawdzenia zakończone powodzeniem." : "Liczba nieudanych sprawdzeń: " + to_string(bledy)) << endl;
+    return bledy == 0 ? 0 : 1;
+}
@@ -0,0 +1,298 @@
+#include "Strojenie.hpp"
+#include "Rownolegle.hpp"
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include <algorithm> // dla funkcji fill() i min()
+using namespace std;
+
+namespace {
+
+atomic<int> kafelek{BLOK_TRANSPOZYCJI}; /**< Bieżący rozmiar kafelka transpozycji. */
+
+/**
+ * @brief Mierzy najkrótszy z kilku czasów wykonania funkcji.
+ *
+ * @param f Mierzona funkcja.
+ * @param powtorzenia Liczba pomiarów.
+ * @return Czas w sekundach.
+ */
+template <typename F>
+double zmierz(F f, int powtorzenia = 2) {
+    double najlepszy = 1e30;
+    for (int r = 0; r < powtorzenia; ++r) {
+        auto start = chrono::steady_clock::now();
+        f();
+        chrono::duration<double> czas = chrono::steady_clock::now() - start;
+        najlepszy = min(najlepszy, czas.count());
+    }
+    return najlepszy;
+}
+
+/**
+ * @brief Dobiera rozmiary bloków gemm na macierzach n x n.
+ *
+ * @param n Rozmiar macierzy testowej.
+ * @return Najszybszy zestaw bloków.
+ */
+BlokiGemm stroj_gemm(int n) {
+    vector<int> a(static_cast<long>(n) * n), b(a.size()), c(a.size());
+    for (size_t i = 0; i < a.size(); ++i) {
+        a[i] = static_cast<int>(i * 7 % 13) - 6;
+        b[i] = static_cast<int>(i * 5 % 11) - 5;
+    }
+
+    BlokiGemm najlepsze;
+    double najlepszy = 1e30;
+    for (int bi : {32, 64, 128}) {
+        for (int bk : {128, 256, 512}) {
+            for (int bj : {256, 512, 1024}) {
+                BlokiGemm kandydat{bi, bk, bj};
+                double t = zmierz([&] {
+                    fill(c.begin(), c.end(), 0);
+                    gemm(n, n, n, 1, a.data(), n, b.data(), n, c.data(), n, kandydat);
+                });
+                if (t < najlepszy) {
+                    najlepszy = t;
+                    najlepsze = kandydat;
+                }
+            }
+        }
+    }
+    return najlepsze;
+}
+
+/**
+ * @brief Dobiera rozmiar kafelka transpozycji.
+ *
+ * @return Najszybszy rozmiar kafelka.
+ */
+int stroj_transpozycje(void) {
+    const int n = 1024;
+    vector<int> z(static_cast<long>(n) * n), d(z.size());
+    for (size_t i = 0; i < z.size(); ++i) {
+        z[i] = static_cast<int>(i);
+    }
+
+    int najlepszy_kafelek = BLOK_TRANSPOZYCJI;
+    double najlepszy = 1e30;
+    for (int t : {8, 16, 32, 64, 128}) {
+        double czas = zmierz([&] {
+            for (int jj = 0; jj < n; jj += t) {
+                for (int ii = 0; ii < n; ii += t) {
+                    for (int j = jj; j < min(jj + t, n); ++j) {
+                        for (int i = ii; i < min(ii + t, n); ++i) {
+                            d[j * n + i] = z[i * n + j];
+                        }
+                    }
+                }
+            }
+        });
+        if (czas < najlepszy) {
+            najlepszy = czas;
+            najlepszy_kafelek = t;
+        }
+    }
+    return najlepszy_kafelek;
+}
+
+/**
+ * @brief Wyznacza próg zrównoleglenia z kosztu uruchomienia wątku i przepustowości pętli.
+ *
+ * Próg dobierany jest tak, aby praca jednego wątku była kilkanaście razy dłuższa
+ * niż jego utworzenie i dołączenie.
+ *
+ * @return Minimalna liczba elementów na wątek.
+ */
+long stroj_prog(void) {
+    if (liczba_watkow() <= 1) {
+        return prog_rownoleglosci(); // Na jednym rdzeniu nie ma czego mierzyć
+    }
+
+    double watek = zmierz([] {
+        vector<thread> pula;
+        for (int t = 0; t < 8; ++t) {
+            pula.emplace_back([] {});
+        }
+        for (thread& w : pula) {
+            w.join();
+        }
+    }, 3) / 8;
+
+    const long n = 1L << 20;
+    vector<int> a(n, 1), b(n, 2), c(n);
+    double element = zmierz([&] {
+        for (long i = 0; i < n; ++i) {
+            c[i] = a[i] + b[i];
+        }
+    }, 3) / n;
+
+    long prog = PROG_ROWNOLEGLOSCI;
+    if (element > 0) {
+        long wyliczony = static_cast<long>(16 * watek / element);
+        prog = 1L << 12;
+        while (prog < wyliczony && prog < (1L << 22)) {
+            prog <<= 1;
+        }
+    }
+    return prog;
+}
+
+} // namespace
+
+/**
+ * @brief Zwraca identyfikator bieżącego procesora.
+ *
+ * @return Model procesora z /proc/cpuinfo i liczba wątków sprzętowych.
+ */
+string identyfikator_procesora(void) {
+    string model = "nieznany";
+    ifstream plik("/proc/cpuinfo");
+    string linia;
+    while (getline(plik, linia)) {
+        if (linia.rfind("model name", 0) == 0) {
+            size_t dwukropek = linia.find(':');
+            if (dwukropek != string::npos) {
+                model = linia.substr(min(dwukropek + 2, linia.size()));
+            }
+            break;
+        }
+    }
+    return model + " x" + to_string(thread::hardware_concurrency());
+}
+
+/**
+ * @brief Zwraca bieżący rozmiar kafelka transpozycji.
+ *
+ * @return Rozmiar kafelka.
+ */
+int blok_transpozycji(void) {
+    return kafelek.load(memory_order_relaxed);
+}
+
+/**
+ * @brief Zwraca bieżące parametry operacji na macierzach.
+ *
+ * @return Profil bieżącego procesora.
+ */
+ProfilStrojenia biezacy_profil(void) {
+    ProfilStrojenia p;
+    p.procesor = identyfikator_procesora();
+    p.gemm = bloki_gemm();
+    p.prog_rownoleglosci = prog_rownoleglosci();
+    p.blok_transpozycji = blok_transpozycji();
+    return p;
+}
+
+/**
+ * @brief Ustawia parametry operacji na macierzach.
+ *
+ * @param p Profil do zastosowania.
+ */
+void zastosuj_profil(const ProfilStrojenia& p) {
+    ustaw_bloki_gemm(p.gemm);
+    ustaw_prog_rownoleglosci(p.prog_rownoleglosci);
+    if (p.blok_transpozycji > 0) {
+        kafelek.store(p.blok_transpozycji, memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Mierzy kandydatów i stosuje najszybszy zestaw parametrów.
+ *
+ * @param rozmiar Rozmiar macierzy testowej dla gemm.
+ * @return Dobrany profil.
+ */
+ProfilStrojenia dostroj(int rozmiar) {
+    ProfilStrojenia p;
+    p.procesor = identyfikator_procesora();
+    p.gemm = stroj_gemm(rozmiar > 0 ? rozmiar : 256);
+    p.blok_transpozycji = stroj_transpozycje();
+    p.prog_rownoleglosci = stroj_prog();
+    zastosuj_profil(p);
+    return p;
+}
+
+/**
+ * @brief Zapisuje profil w pliku.
+ *
+ * Każdy wiersz pliku ma postać "blok_i blok_k blok_j prog kafelek procesor".
+ * Wpisy innych procesorów pozostają bez zmian, więc jeden plik może obsługiwać wiele maszyn.
+ *
+ * @param p Profil do zapisania.
+ * @param sciezka Ścieżka pliku profili.
+ * @return true, jeśli zapis się powiódł.
+ */
+bool zapisz_profil(const ProfilStrojenia& p, const string& sciezka) {
+    vector<string> wiersze;
+    {
+        ifstream we(sciezka);
+        string linia;
+        while (getline(we, linia)) {
+            istringstream s(linia);
+            int bi, bk, bj, t;
+            long prog;
+            string procesor;
+            if (s >> bi >> bk >> bj >> prog >> t && getline(s >> ws, procesor) && procesor != p.procesor) {
+                wiersze.push_back(linia);
+            }
+        }
+    }
+
+    ofstream wy(sciezka, ios::trunc);
+    if (!wy) {
+        cerr << "Nie można zapisać profilu strojenia do pliku " << sciezka << "." << endl;
+        return false;
+    }
+    for (const string& w : wiersze) {
+        wy << w << '\n';
+    }
+    wy << p.gemm.i << ' ' << p.gemm.k << ' ' << p.gemm.j << ' ' << p.prog_rownoleglosci << ' '
+       << p.blok_transpozycji << ' ' << p.procesor << '\n';
+    return static_cast<bool>(wy);
+}
+
+/**
+ * @brief Wczytuje i stosuje profil bieżącego procesora.
+ *
+ * @param sciezka Ścieżka pliku profili.
+ * @return true, jeśli znaleziono profil tego procesora.
+ */
+bool wczytaj_profil(const string& sciezka) {
+    ifstream we(sciezka);
+    if (!we) {
+        return false;
+    }
+
+    const string procesor = identyfikator_procesora();
+    string linia;
+    while (getline(we, linia)) {
+        istringstream s(linia);
+        ProfilStrojenia p;
+        if (s >> p.gemm.i >> p.gemm.k >> p.gemm.j >> p.prog_rownoleglosci >> p.blok_transpozycji &&
+            getline(s >> ws, p.procesor) && p.procesor == procesor) {
+            zastosuj_profil(p);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Wczytuje profil bieżącego procesora albo stroi parametry przy pierwszym uruchomieniu.
+ *
+ * @param sciezka Ścieżka pliku profili.
+ * @return Zastosowany profil.
+ */
+ProfilStrojenia przygotuj_profil(const string& sciezka) {
+    if (wczytaj_profil(sciezka)) {
+        return biezacy_profil();
+    }
+    ProfilStrojenia p = dostroj();
+    zapisz_profil(p, sciezka);
+    return p;
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <string>
+#include "Gemm.hpp"
+
+/**
+ * @file Strojenie.hpp
+ * @brief Automatyczny dobór rozmiarów bloków i progów dla bieżącego procesora.
+ *
+ * Najlepsze rozmiary bloków gemm, kafelka transpozycji i próg zrównoleglenia zależą
+ * od hierarchii pamięci podręcznej maszyny. Strojenie mierzy kandydatów na małych
+ * macierzach, a wynik zapisuje w pliku profili, w którym każdy procesor ma własny wiersz.
+ * Biblioteka nie czyta ani nie zapisuje plików sama: do wywołania wczytaj_profil()
+ * lub przygotuj_profil() działają wartości domyślne.
+ */
+
+/**
+ * @brief Domyślna ścieżka pliku z profilami strojenia.
+ */
+constexpr const char* PLIK_PROFILU = "Matrix.profil";
+
+/**
+ * @brief Domyślny rozmiar kafelka transpozycji.
+ */
+constexpr int BLOK_TRANSPOZYCJI = 32;
+
+/**
+ * @brief Parametry wydajnościowe dobrane dla jednego procesora.
+ */
+struct ProfilStrojenia {
+  std::string procesor;                        /**< Identyfikator procesora, dla którego dobrano parametry. */
+  BlokiGemm gemm;                              /**< Rozmiary bloków jądra gemm. */
+  long prog_rownoleglosci = 0;                 /**< Minimalna liczba elementów na wątek. */
+  int blok_transpozycji = BLOK_TRANSPOZYCJI;   /**< Rozmiar kafelka transpozycji. */
+};
+
+/**
+ * @brief Zwraca identyfikator bieżącego procesora (model z /proc/cpuinfo i liczba wątków).
+ * @return Identyfikator używany jako klucz w pliku profili.
+ */
+std::string identyfikator_procesora(void);
+
+/**
+ * @brief Zwraca bieżący rozmiar kafelka transpozycji używany przez Matrix::dowroc().
+ * @return Rozmiar kafelka.
+ */
+int blok_transpozycji(void);
+
+/**
+ * @brief Zwraca parametry, z których korzystają obecnie operacje na macierzach.
+ * @return Bieżący profil.
+ */
+ProfilStrojenia biezacy_profil(void);
+
+/**
+ * @brief Ustawia parametry operacji na macierzach.
+ * @param p Profil do zastosowania.
+ */
+void zastosuj_profil(const ProfilStrojenia& p);
+
+/**
+ * @brief Mierzy kandydatów i stosuje najszybszy zestaw parametrów.
+ * @param rozmiar Rozmiar macierzy testowej dla gemm.
+ * @return Dobrany profil.
+ */
+ProfilStrojenia dostroj(int rozmiar = 256);
+
+/**
+ * @brief Zapisuje profil w pliku, zastępując wcześniejszy wpis tego samego procesora.
+ * @param p Profil do zapisania.
+ * @param sciezka Ścieżka pliku profili.
+ * @return true, jeśli zapis się powiódł.
+ */
+bool zapisz_profil(const ProfilStrojenia& p, const std::string& sciezka = PLIK_PROFILU);
+
+/**
+ * @brief Wczytuje i stosuje profil bieżącego procesora.
+ * @param sciezka Ścieżka pliku profili.
+ * @return true, jeśli plik zawierał profil tego procesora.
+ */
+bool wczytaj_profil(const std::string& sciezka = PLIK_PROFILU);
+
+/**
+ * @brief Wczytuje profil bieżącego procesora, a jeśli go brak, stroi parametry i zapisuje wynik.
+ *
+ * Strojenie trwa kilka sekund i tworzy plik profili, dlatego funkcja nie jest
+ * wywoływana automatycznie.
+ *
+ * @param sciezka Ścieżka pliku profili.
+ * @return Zastosowany profil.
+ */
+ProfilStrojenia przygotuj_profil(const std::string& sciezka = PLIK_PROFILU);
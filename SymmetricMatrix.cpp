@@ -0,0 +1,38 @@
+#include "SymmetricMatrix.hpp"
+using namespace std;
+
+/**
+ * @brief Oblicza macierz Grama A * A^T.
+ *
+ * Zastępuje sekwencję kopia.dowroc() i operator*, która tworzy transpozycję
+ * i liczy obie (równe) połowy wyniku.
+ *
+ * @param a Macierz A.
+ * @return Symetryczna macierz A * A^T.
+ */
+SymmetricMatrix<int> gram(const Matrix& a) {
+    SymmetricMatrix<int> c(a.rozmiar());
+    if (a.dane() != nullptr) {
+        syrk(a.rozmiar(), a.rozmiar(), a.dane(), c);
+    }
+    return c;
+}
+
+/**
+ * @brief Operator mnożenia macierzy symetrycznej przez macierz.
+ *
+ * @param s Macierz symetryczna.
+ * @param m Macierz mnożona.
+ * @return Nowa macierz S * m.
+ */
+Matrix operator*(const SymmetricMatrix<int>& s, const Matrix& m) {
+    if (s.rozmiar() != m.size) {
+        cerr << "Macierze mają różne rozmiary, nie można ich pomnożyć." << endl;
+        return Matrix(m);
+    }
+
+    Matrix result(m.size);
+    symm(s, m.size, m.data, result.data);
+
+    return result;
+}
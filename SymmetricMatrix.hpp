@@ -0,0 +1,167 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include "TriangularMatrix.hpp"
+
+/**
+ * @class SymmetricMatrix
+ * @brief Macierz symetryczna przechowująca jedynie spakowany dolny trójkąt.
+ *
+ * Element (x, y) nad przekątną odczytywany jest jako (y, x), więc macierz
+ * zajmuje n(n+1)/2 elementów.
+ */
+template <typename T>
+class SymmetricMatrix {
+public:
+  /**
+   * @brief Konstruktor macierzy symetrycznej wypełnionej zerami.
+   * @param n Rozmiar macierzy.
+   */
+  explicit SymmetricMatrix(int n) : dolna(TriangularMatrix<T>::Dolna, n) {}
+
+  /**
+   * @brief Zwraca rozmiar macierzy.
+   * @return Liczba wierszy (i kolumn) macierzy.
+   */
+  int rozmiar(void) const { return dolna.rozmiar(); }
+
+  /**
+   * @brief Zwraca element (x, y).
+   * @param x Wiersz.
+   * @param y Kolumna.
+   * @return Wartość elementu.
+   */
+  T operator()(int x, int y) const { return x >= y ? dolna.wiersz(x)[y] : dolna.wiersz(y)[x]; }
+
+  /**
+   * @brief Zwraca referencję do elementu (x, y), wspólną z elementem (y, x).
+   * @param x Wiersz.
+   * @param y Kolumna.
+   * @return Referencja do elementu.
+   */
+  T& element(int x, int y) { return x >= y ? dolna.wiersz(x)[y] : dolna.wiersz(y)[x]; }
+
+  /**
+   * @brief Zwraca spakowany dolny trójkąt.
+   * @return Dolnotrójkątna macierz z elementami na i pod przekątną.
+   */
+  const TriangularMatrix<T>& trojkat(void) const { return dolna; }
+
+  /**
+   * @brief Rozpakowuje macierz do pełnej postaci.
+   * @param pelna Tablica na rozmiar() * rozmiar() elementów.
+   */
+  void rozpakuj(T* pelna) const {
+    const int n = rozmiar();
+    for (int i = 0; i < n; ++i) {
+      for (int j = 0; j < n; ++j) {
+        pelna[static_cast<long>(i) * n + j] = (*this)(i, j);
+      }
+    }
+  }
+
+private:
+  TriangularMatrix<T> dolna; /**< Dolny trójkąt wraz z przekątną. */
+};
+
+/**
+ * @brief Rozmiar kafelka w jądrach syrk i symm.
+ */
+constexpr int SYRK_BLOK = 64;
+
+/**
+ * @brief Aktualizacja rzędu k: C := C + A * A^T, liczona tylko dla dolnego trójkąta C.
+ *
+ * Element C[i][j] to iloczyn skalarny wierszy i oraz j macierzy A, więc transpozycja
+ * A nigdy nie jest tworzona. Pętle podzielone są na kafelki, aby fragmenty wierszy A
+ * były wielokrotnie wykorzystywane z pamięci podręcznej.
+ *
+ * @param n Liczba wierszy A (rozmiar C).
+ * @param k Liczba kolumn A.
+ * @param a Macierz A (n x k) zapisana wierszami.
+ * @param c Macierz symetryczna n x n, do której dodawany jest wynik.
+ */
+template <typename T>
+void syrk(int n, int k, const T* a, SymmetricMatrix<T>& c) {
+  for (int ib = 0; ib < n; ib += SYRK_BLOK) {
+    int ie = std::min(ib + SYRK_BLOK, n);
+    for (int jb = 0; jb <= ib; jb += SYRK_BLOK) {
+      for (int kb = 0; kb < k; kb += 4 * SYRK_BLOK) {
+        int ke = std::min(kb + 4 * SYRK_BLOK, k);
+
+        for (int i = ib; i < ie; ++i) {
+          const T* ai = a + static_cast<long>(i) * k;
+          int je = std::min(jb + SYRK_BLOK, i + 1);
+          for (int j = jb; j < je; ++j) {
+            const T* aj = a + static_cast<long>(j) * k;
+            T suma = T(0);
+            for (int p = kb; p < ke; ++p) {
+              suma += ai[p] * aj[p];
+            }
+            c.element(i, j) += suma;
+          }
+        }
+      }
+    }
+  }
+}
+
+/**
+ * @brief Mnożenie macierzy symetrycznej przez macierz: C := S * B.
+ *
+ * Każdy element spakowanego trójkąta odczytywany jest raz i wnosi wkład
+ * zarówno do wiersza i, jak i do wiersza k wyniku.
+ *
+ * @param s Macierz symetryczna (n x n).
+ * @param r Liczba kolumn B.
+ * @param b Macierz B (n x r) zapisana wierszami.
+ * @param c Tablica wynikowa n x r (nadpisywana).
+ */
+template <typename T>
+void symm(const SymmetricMatrix<T>& s, int r, const T* b, T* c) {
+  const int n = s.rozmiar();
+  std::fill_n(c, static_cast<long>(n) * r, T(0));
+
+  for (int jj = 0; jj < r; jj += TRMM_BLOK) {
+    int je = std::min(jj + TRMM_BLOK, r);
+
+    for (int i = 0; i < n; ++i) {
+      const T* si = s.trojkat().wiersz(i);
+      const T* bi = b + static_cast<long>(i) * r;
+      T* ci = c + static_cast<long>(i) * r;
+
+      for (int k = 0; k <= i; ++k) {
+        T sik = si[k];
+        if (sik == T(0)) {
+          continue;
+        }
+        const T* bk = b + static_cast<long>(k) * r;
+        T* ck = c + static_cast<long>(k) * r;
+        for (int j = jj; j < je; ++j) {
+          ci[j] += sik * bk[j];
+        }
+        if (k != i) {
+          for (int j = jj; j < je; ++j) {
+            ck[j] += sik * bi[j];
+          }
+        }
+      }
+    }
+  }
+}
+
+/**
+ * @brief Oblicza macierz Grama A * A^T bez transpozycji A i tylko w jednym trójkącie.
+ * @param a Macierz A.
+ * @return Symetryczna macierz A * A^T.
+ */
+SymmetricMatrix<int> gram(const Matrix& a);
+
+/**
+ * @brief Mnoży macierz symetryczną przez zwykłą macierz (S * m).
+ * @param s Macierz symetryczna.
+ * @param m Macierz mnożona.
+ * @return Nowa macierz z wynikiem.
+ */
+Matrix operator*(const SymmetricMatrix<int>& s, const Matrix& m);
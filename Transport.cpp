@@ -0,0 +1,207 @@
+#include "Transport.hpp"
+#include <iostream>
+#ifdef __linux__
+#include <cerrno>
+#include <sys/socket.h> // dla funkcji socketpair(), send() i recv()
+#include <sys/wait.h>   // dla funkcji waitpid()
+#include <unistd.h>     // dla funkcji fork() i close()
+#endif
+using namespace std;
+
+/**
+ * @brief Tworzy transport rangi z gotowymi gniazdami.
+ *
+ * @param numer Ranga bieżącego procesu.
+ * @param gniazda Gniazda do pozostałych rang.
+ */
+TransportLokalny::TransportLokalny(int numer, vector<int> gniazda) : numer(numer), gniazda(move(gniazda)) {}
+
+/**
+ * @brief Zamyka połączenia.
+ */
+TransportLokalny::~TransportLokalny(void) {
+    zamknij();
+}
+
+/**
+ * @brief Zamyka wszystkie gniazda bieżącego procesu.
+ */
+void TransportLokalny::zamknij(void) {
+#ifdef __linux__
+    for (int& g : gniazda) {
+        if (g >= 0) {
+            close(g);
+            g = -1;
+        }
+    }
+#endif
+}
+
+/**
+ * @brief Tworzy procesy i połączenia między nimi.
+ *
+ * Gniazda wszystkich par tworzone są przed rozwidleniem, a każdy proces zamyka
+ * końcówki, które do niego nie należą (inaczej zamknięcie połączenia przez jedną
+ * stronę nie byłoby widoczne dla drugiej).
+ *
+ * @param liczba Liczba rang.
+ * @return Transport bieżącego procesu.
+ */
+unique_ptr<TransportLokalny> TransportLokalny::uruchom(int liczba) {
+#ifdef __linux__
+    if (liczba <= 0) {
+        cerr << "Liczba rang musi być większa od zera." << endl;
+        return nullptr;
+    }
+
+    // koncowki[i][j] to gniazdo, przez które ranga i rozmawia z rangą j
+    vector<vector<int>> koncowki(liczba, vector<int>(liczba, -1));
+    auto zamknij_wszystkie = [&](int oprocz) {
+        for (int i = 0; i < liczba; ++i) {
+            for (int j = 0; j < liczba; ++j) {
+                if (i != oprocz && koncowki[i][j] >= 0) {
+                    close(koncowki[i][j]);
+                    koncowki[i][j] = -1;
+                }
+            }
+        }
+    };
+
+    for (int i = 0; i < liczba; ++i) {
+        for (int j = i + 1; j < liczba; ++j) {
+            int para[2];
+            if (socketpair(AF_UNIX, SOCK_STREAM, 0, para) != 0) {
+                cerr << "Nie można utworzyć połączenia między procesami." << endl;
+                zamknij_wszystkie(-1);
+                return nullptr;
+            }
+            koncowki[i][j] = para[0];
+            koncowki[j][i] = para[1];
+        }
+    }
+
+    vector<long> potomne;
+    cout.flush(); // Bufor strumienia nie może zostać wypisany ponownie przez procesy potomne
+    for (int r = 1; r < liczba; ++r) {
+        pid_t pid = fork();
+        if (pid < 0) {
+            cerr << "Nie można utworzyć procesu rangi " << r << "." << endl;
+            zamknij_wszystkie(-1);
+            for (long p : potomne) {
+                waitpid(static_cast<pid_t>(p), nullptr, 0);
+            }
+            return nullptr;
+        }
+        if (pid == 0) {
+            zamknij_wszystkie(r);
+            return unique_ptr<TransportLokalny>(new TransportLokalny(r, koncowki[r]));
+        }
+        potomne.push_back(pid);
+    }
+
+    zamknij_wszystkie(0);
+    unique_ptr<TransportLokalny> t(new TransportLokalny(0, koncowki[0]));
+    t->potomne = move(potomne);
+    return t;
+#else
+    (void)liczba;
+    cerr << "Transport lokalny nie jest dostępny na tej platformie." << endl;
+    return nullptr;
+#endif
+}
+
+/**
+ * @brief Wysyła bajty do innej rangi.
+ *
+ * send() z MSG_NOSIGNAL zgłasza zamknięte połączenie błędem EPIPE zamiast
+ * sygnału SIGPIPE, który zakończyłby proces.
+ *
+ * @param cel Ranga odbiorcy.
+ * @param dane Wysyłane dane.
+ * @param bajty Liczba bajtów.
+ * @return false przy błędzie połączenia.
+ */
+bool TransportLokalny::wyslij(int cel, const void* dane, long bajty) {
+    if (cel < 0 || cel >= liczba_rang() || gniazda[cel] < 0) {
+        return false;
+    }
+#ifdef __linux__
+    const char* p = static_cast<const char*>(dane);
+    while (bajty > 0) {
+        ssize_t k = send(gniazda[cel], p, bajty, MSG_NOSIGNAL);
+        if (k < 0 && errno == EINTR) {
+            continue;
+        }
+        if (k <= 0) {
+            return false;
+        }
+        p += k;
+        bajty -= k;
+    }
+    return true;
+#else
+    (void)dane;
+    return bajty == 0;
+#endif
+}
+
+/**
+ * @brief Odbiera bajty od innej rangi.
+ *
+ * @param zrodlo Ranga nadawcy.
+ * @param dane Bufor na dane.
+ * @param bajty Liczba bajtów.
+ * @return false przy błędzie lub zamknięciu połączenia.
+ */
+bool TransportLokalny::odbierz(int zrodlo, void* dane, long bajty) {
+    if (zrodlo < 0 || zrodlo >= liczba_rang() || gniazda[zrodlo] < 0) {
+        return false;
+    }
+#ifdef __linux__
+    char* p = static_cast<char*>(dane);
+    while (bajty > 0) {
+        ssize_t k = recv(gniazda[zrodlo], p, bajty, 0);
+        if (k < 0 && errno == EINTR) {
+            continue;
+        }
+        if (k <= 0) {
+            return false;
+        }
+        p += k;
+        bajty -= k;
+    }
+    return true;
+#else
+    (void)dane;
+    return bajty == 0;
+#endif
+}
+
+/**
+ * @brief Kończy obliczenia rozproszone.
+ *
+ * @param kod Kod wyjścia procesu potomnego.
+ * @return W randze 0: true, jeśli wszystkie procesy potomne zakończyły się kodem 0.
+ */
+bool TransportLokalny::zakoncz(int kod) {
+    zamknij();
+#ifdef __linux__
+    if (numer != 0) {
+        cout.flush();
+        _exit(kod);
+    }
+
+    bool ok = true;
+    for (long p : potomne) {
+        int status = 0;
+        if (waitpid(static_cast<pid_t>(p), &status, 0) != p || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            ok = false;
+        }
+    }
+    potomne.clear();
+    return ok;
+#else
+    (void)kod;
+    return true;
+#endif
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+/**
+ * @file Transport.hpp
+ * @brief Przesyłanie danych między procesami (rangami) obliczeń rozproszonych.
+ */
+
+/**
+ * @class Transport
+ * @brief Interfejs komunikacji punkt-punkt między N rangami.
+ *
+ * DistributedMatrix korzysta wyłącznie z tego interfejsu, więc obliczenia
+ * rozproszone na wielu maszynach wymagają jedynie nowej implementacji
+ * (np. na gniazdach TCP lub MPI). Komunikaty między parą rang docierają
+ * w kolejności wysłania, a odbiorca zna ich długość.
+ */
+class Transport {
+public:
+  virtual ~Transport(void) = default;
+
+  /**
+   * @brief Zwraca numer bieżącego procesu.
+   * @return Ranga z przedziału [0, liczba_rang()).
+   */
+  virtual int ranga(void) const = 0;
+
+  /**
+   * @brief Zwraca liczbę procesów.
+   * @return Liczba rang.
+   */
+  virtual int liczba_rang(void) const = 0;
+
+  /**
+   * @brief Wysyła bajty do innej rangi (blokuje do przekazania danych).
+   * @param cel Ranga odbiorcy (różna od bieżącej).
+   * @param dane Wysyłane dane.
+   * @param bajty Liczba bajtów.
+   * @return false przy błędzie połączenia.
+   */
+  virtual bool wyslij(int cel, const void* dane, long bajty) = 0;
+
+  /**
+   * @brief Odbiera bajty od innej rangi (blokuje do ich nadejścia).
+   * @param zrodlo Ranga nadawcy (różna od bieżącej).
+   * @param dane Bufor na dane.
+   * @param bajty Liczba bajtów.
+   * @return false przy błędzie połączenia.
+   */
+  virtual bool odbierz(int zrodlo, void* dane, long bajty) = 0;
+};
+
+/**
+ * @class TransportLokalny
+ * @brief Transport między procesami jednej maszyny połączonymi parami gniazd uniksowych.
+ *
+ * uruchom() tworzy gniazdo dla każdej pary rang i rozwidla proces: wywołujący
+ * staje się rangą 0, a procesy potomne kolejnymi rangami. Od tej chwili każdy
+ * proces wykonuje ten sam kod (jak w MPI) z własnym obiektem transportu.
+ * Rozwidlenie powinno nastąpić, gdy nie działają inne wątki (operacje równoległe
+ * biblioteki kończą swoje wątki przed powrotem). Zamknięte połączenie zgłaszane
+ * jest wynikiem false, a nie sygnałem SIGPIPE. Dostępny tylko w systemie Linux.
+ */
+class TransportLokalny : public Transport {
+public:
+  /**
+   * @brief Tworzy procesy i połączenia między nimi.
+   * @param liczba Liczba rang (co najmniej 1).
+   * @return Transport bieżącego procesu albo nullptr przy błędzie (i poza systemem Linux).
+   */
+  static std::unique_ptr<TransportLokalny> uruchom(int liczba);
+
+  TransportLokalny(const TransportLokalny&) = delete;
+  TransportLokalny& operator=(const TransportLokalny&) = delete;
+
+  /**
+   * @brief Zamyka połączenia.
+   */
+  ~TransportLokalny(void) override;
+
+  int ranga(void) const override { return numer; }
+  int liczba_rang(void) const override { return static_cast<int>(gniazda.size()); }
+  bool wyslij(int cel, const void* dane, long bajty) override;
+  bool odbierz(int zrodlo, void* dane, long bajty) override;
+
+  /**
+   * @brief Kończy obliczenia rozproszone.
+   *
+   * Procesy potomne kończą działanie (funkcja nie wraca), a ranga 0 czeka na nie.
+   *
+   * @param kod Kod wyjścia procesu potomnego.
+   * @return W randze 0: true, jeśli wszystkie procesy potomne zakończyły się kodem 0.
+   */
+  bool zakoncz(int kod = 0);
+
+private:
+  /**
+   * @brief Tworzy transport rangi numer z gniazdami do pozostałych rang.
+   * @param numer Ranga bieżącego procesu.
+   * @param gniazda Deskryptor gniazda do każdej rangi (-1 dla bieżącej).
+   */
+  TransportLokalny(int numer, std::vector<int> gniazda);
+
+  /**
+   * @brief Zamyka wszystkie gniazda.
+   */
+  void zamknij(void);
+
+  int numer;                 /**< Ranga bieżącego procesu. */
+  std::vector<int> gniazda;  /**< Gniazdo do każdej rangi. */
+  std::vector<long> potomne; /**< Identyfikatory procesów potomnych (tylko w randze 0). */
+};
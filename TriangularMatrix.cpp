@@ -0,0 +1,25 @@
+#include "TriangularMatrix.hpp"
+using namespace std;
+
+/**
+ * @brief Operator mnożenia spakowanej macierzy trójkątnej przez macierz.
+ *
+ * Wynik powstaje z kopii m (bufor kopiowany jest przy pierwszym zapisie),
+ * nadpisywanej w miejscu przez trmm.
+ *
+ * @param t Macierz trójkątna.
+ * @param m Macierz mnożona.
+ * @return Nowa macierz T * m.
+ */
+Matrix operator*(const TriangularMatrix<int>& t, const Matrix& m) {
+    Matrix result(m);
+    if (t.rozmiar() != m.size) {
+        cerr << "Macierze mają różne rozmiary, nie można ich pomnożyć." << endl;
+        return result;
+    }
+
+    result.odlacz();
+    trmm(t, result.size, result.data);
+
+    return result;
+}
@@ -0,0 +1,295 @@
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include "Matrix.hpp"
+
+/**
+ * @class TriangularMatrix
+ * @brief Macierz trójkątna w postaci spakowanej (n(n+1)/2 elementów zamiast n^2).
+ *
+ * Elementy trójkąta (łącznie z przekątną) zapisane są kolejnymi wierszami:
+ * w macierzy dolnej wiersz i zawiera kolumny 0..i, w górnej kolumny i..n-1.
+ * Dzięki temu każdy wiersz zajmuje ciągły fragment pamięci.
+ */
+template <typename T>
+class TriangularMatrix {
+public:
+  /**
+   * @brief Rodzaj przechowywanego trójkąta.
+   */
+  enum Trojkat {
+    Dolna, /**< Elementy na i pod przekątną. */
+    Gorna  /**< Elementy na i nad przekątną. */
+  };
+
+  /**
+   * @brief Konstruktor macierzy trójkątnej wypełnionej zerami.
+   * @param trojkat Rodzaj trójkąta.
+   * @param n Rozmiar macierzy.
+   */
+  TriangularMatrix(Trojkat trojkat, int n)
+      : trojkat(trojkat), size(n > 0 ? n : 0), dane(static_cast<long>(size) * (size + 1) / 2, T(0)) {}
+
+  /**
+   * @brief Pakuje trójkąt pełnej macierzy zapisanej wierszami.
+   * @param trojkat Rodzaj trójkąta.
+   * @param n Rozmiar macierzy.
+   * @param pelna Wskaźnik na n * n elementów.
+   */
+  TriangularMatrix(Trojkat trojkat, int n, const T* pelna) : TriangularMatrix(trojkat, n) {
+    for (int i = 0; i < size; ++i) {
+      int j0 = trojkat == Dolna ? 0 : i;
+      int j1 = trojkat == Dolna ? i + 1 : size;
+      std::copy(pelna + static_cast<long>(i) * size + j0, pelna + static_cast<long>(i) * size + j1, wiersz(i));
+    }
+  }
+
+  /**
+   * @brief Pakuje trójkąt macierzy całkowitoliczbowej (np. z pod_przekatna() lub nad_przekatna()).
+   * @param trojkat Rodzaj trójkąta.
+   * @param m Macierz źródłowa.
+   */
+  TriangularMatrix(Trojkat trojkat, const Matrix& m) : TriangularMatrix(trojkat, m.rozmiar()) {
+    for (int i = 0; i < size; ++i) {
+      int j0 = trojkat == Dolna ? 0 : i;
+      int j1 = trojkat == Dolna ? i + 1 : size;
+      std::span<const int> w = m.widok_wiersza(i);
+      std::copy(w.begin() + j0, w.begin() + j1, wiersz(i));
+    }
+  }
+
+  /**
+   * @brief Zwraca rozmiar macierzy.
+   * @return Liczba wierszy (i kolumn) macierzy.
+   */
+  int rozmiar(void) const { return size; }
+
+  /**
+   * @brief Zwraca rodzaj trójkąta.
+   * @return Dolna albo Gorna.
+   */
+  Trojkat rodzaj(void) const { return trojkat; }
+
+  /**
+   * @brief Zwraca element (x, y), zero poza trójkątem.
+   * @param x Wiersz.
+   * @param y Kolumna.
+   * @return Wartość elementu.
+   */
+  T operator()(int x, int y) const {
+    if (trojkat == Dolna ? y > x : y < x) {
+      return T(0);
+    }
+    return wiersz(x)[y - pierwsza_kolumna(x)];
+  }
+
+  /**
+   * @brief Zwraca referencję do elementu (x, y) leżącego w trójkącie.
+   * @param x Wiersz.
+   * @param y Kolumna (y <= x dla macierzy dolnej, y >= x dla górnej).
+   * @return Referencja do elementu.
+   */
+  T& element(int x, int y) { return wiersz(x)[y - pierwsza_kolumna(x)]; }
+
+  /**
+   * @brief Zwraca numer pierwszej kolumny zapisanej w wierszu x.
+   * @param x Numer wiersza.
+   * @return 0 dla macierzy dolnej, x dla górnej.
+   */
+  int pierwsza_kolumna(int x) const { return trojkat == Dolna ? 0 : x; }
+
+  /**
+   * @brief Zwraca wskaźnik na zapisane elementy wiersza x (ciągłe w pamięci).
+   * @param x Numer wiersza.
+   * @return Wskaźnik na element (x, pierwsza_kolumna(x)).
+   */
+  const T* wiersz(int x) const { return dane.data() + przesuniecie(x); }
+
+  /**
+   * @brief Zwraca wskaźnik na zapisane elementy wiersza x do zapisu.
+   * @param x Numer wiersza.
+   * @return Wskaźnik na element (x, pierwsza_kolumna(x)).
+   */
+  T* wiersz(int x) { return dane.data() + przesuniecie(x); }
+
+  /**
+   * @brief Zwraca liczbę elementów zapisanych w wierszu x.
+   * @param x Numer wiersza.
+   * @return x + 1 dla macierzy dolnej, size - x dla górnej.
+   */
+  int dlugosc_wiersza(int x) const { return trojkat == Dolna ? x + 1 : size - x; }
+
+  /**
+   * @brief Rozpakowuje macierz do pełnej postaci z zerami poza trójkątem.
+   * @param pelna Tablica na size * size elementów.
+   */
+  void rozpakuj(T* pelna) const {
+    std::fill_n(pelna, static_cast<long>(size) * size, T(0));
+    for (int i = 0; i < size; ++i) {
+      std::copy_n(wiersz(i), dlugosc_wiersza(i), pelna + static_cast<long>(i) * size + pierwsza_kolumna(i));
+    }
+  }
+
+private:
+  /**
+   * @brief Wylicza położenie początku wiersza x w spakowanej tablicy.
+   * @param x Numer wiersza.
+   * @return Indeks pierwszego elementu wiersza.
+   */
+  long przesuniecie(int x) const {
+    long i = x;
+    return trojkat == Dolna ? i * (i + 1) / 2 : i * size - i * (i - 1) / 2;
+  }
+
+  Trojkat trojkat;      /**< Rodzaj trójkąta. */
+  int size;             /**< Rozmiar macierzy. */
+  std::vector<T> dane;  /**< Spakowane elementy trójkąta. */
+};
+
+/**
+ * @brief Szerokość pasa kolumn prawej strony przetwarzanego naraz przez trmm i trsm.
+ */
+constexpr int TRMM_BLOK = 256;
+
+/**
+ * @brief Oblicza B := T * B z pominięciem zerowej połowy T.
+ *
+ * Prawa strona przetwarzana jest pasami po TRMM_BLOK kolumn, aby odczytywane
+ * wielokrotnie fragmenty wierszy B pozostawały w pamięci podręcznej. Wiersze wyniku
+ * liczone są w kolejności, która pozwala nadpisywać B w miejscu.
+ *
+ * @param t Macierz trójkątna (n x n).
+ * @param r Liczba kolumn B.
+ * @param b Macierz n x r zapisana wierszami, nadpisywana wynikiem.
+ */
+template <typename T>
+void trmm(const TriangularMatrix<T>& t, int r, T* b) {
+  const int n = t.rozmiar();
+  const bool dolna = t.rodzaj() == TriangularMatrix<T>::Dolna;
+  std::vector<T> akumulator(TRMM_BLOK);
+
+  for (int jj = 0; jj < r; jj += TRMM_BLOK) {
+    int szer = std::min(TRMM_BLOK, r - jj);
+
+    for (int s = 0; s < n; ++s) {
+      // Macierz dolna od ostatniego wiersza, górna od pierwszego
+      int i = dolna ? n - 1 - s : s;
+      const T* ti = t.wiersz(i);
+      int k0 = t.pierwsza_kolumna(i);
+      int dl = t.dlugosc_wiersza(i);
+
+      std::fill_n(akumulator.begin(), szer, T(0));
+      for (int p = 0; p < dl; ++p) {
+        T tik = ti[p];
+        if (tik == T(0)) {
+          continue;
+        }
+        const T* bk = b + static_cast<long>(k0 + p) * r + jj;
+        for (int j = 0; j < szer; ++j) {
+          akumulator[j] += tik * bk[j];
+        }
+      }
+      std::copy_n(akumulator.begin(), szer, b + static_cast<long>(i) * r + jj);
+    }
+  }
+}
+
+/**
+ * @brief Oblicza B := B * T z pominięciem zerowej połowy T.
+ *
+ * Wiersz k macierzy T zapisany jest w pamięci w sposób ciągły, więc wkład elementu B[i][k]
+ * to jedna zwektoryzowana aktualizacja spakowanego wiersza.
+ *
+ * @param t Macierz trójkątna (n x n).
+ * @param m Liczba wierszy B.
+ * @param b Macierz m x n zapisana wierszami, nadpisywana wynikiem.
+ */
+template <typename T>
+void trmm_prawe(const TriangularMatrix<T>& t, int m, T* b) {
+  const int n = t.rozmiar();
+  std::vector<T> wynik(n);
+
+  for (int i = 0; i < m; ++i) {
+    T* bi = b + static_cast<long>(i) * n;
+    std::fill(wynik.begin(), wynik.end(), T(0));
+
+    for (int k = 0; k < n; ++k) {
+      T bik = bi[k];
+      if (bik == T(0)) {
+        continue;
+      }
+      const T* tk = t.wiersz(k);
+      T* w = wynik.data() + t.pierwsza_kolumna(k);
+      int dl = t.dlugosc_wiersza(k);
+      for (int j = 0; j < dl; ++j) {
+        w[j] += bik * tk[j];
+      }
+    }
+    std::copy(wynik.begin(), wynik.end(), bi);
+  }
+}
+
+/**
+ * @brief Rozwiązuje układ T * X = B z pominięciem zerowej połowy T.
+ *
+ * Macierz dolna rozwiązywana jest podstawianiem w przód, górna wstecz,
+ * pasami po TRMM_BLOK kolumn prawej strony.
+ *
+ * @param t Macierz trójkątna (n x n) o niezerowej przekątnej.
+ * @param r Liczba kolumn B.
+ * @param b Macierz n x r zapisana wierszami, nadpisywana rozwiązaniem.
+ * @return false, jeśli przekątna T zawiera zero (B pozostaje bez zmian).
+ */
+template <typename T>
+bool trsm(const TriangularMatrix<T>& t, int r, T* b) {
+  const int n = t.rozmiar();
+  const bool dolna = t.rodzaj() == TriangularMatrix<T>::Dolna;
+
+  for (int i = 0; i < n; ++i) {
+    if (t(i, i) == T(0)) {
+      std::cerr << "Macierz trójkątna ma zero na przekątnej, układ nie ma jednoznacznego rozwiązania." << std::endl;
+      return false;
+    }
+  }
+
+  for (int jj = 0; jj < r; jj += TRMM_BLOK) {
+    int szer = std::min(TRMM_BLOK, r - jj);
+
+    for (int s = 0; s < n; ++s) {
+      // Macierz dolna od pierwszego wiersza, górna od ostatniego
+      int i = dolna ? s : n - 1 - s;
+      const T* ti = t.wiersz(i);
+      int k0 = t.pierwsza_kolumna(i);
+      int dl = t.dlugosc_wiersza(i);
+      T* bi = b + static_cast<long>(i) * r + jj;
+
+      for (int p = 0; p < dl; ++p) {
+        int k = k0 + p;
+        if (k == i || ti[p] == T(0)) {
+          continue;
+        }
+        const T* bk = b + static_cast<long>(k) * r + jj;
+        for (int j = 0; j < szer; ++j) {
+          bi[j] -= ti[p] * bk[j];
+        }
+      }
+
+      T d = ti[i - k0];
+      for (int j = 0; j < szer; ++j) {
+        bi[j] /= d;
+      }
+    }
+  }
+
+  return true;
+}
+
+/**
+ * @brief Mnoży spakowaną macierz trójkątną przez zwykłą macierz (T * m).
+ * @param t Macierz trójkątna.
+ * @param m Macierz mnożona.
+ * @return Nowa macierz z wynikiem.
+ */
+Matrix operator*(const TriangularMatrix<int>& t, const Matrix& m);
@@ -1,5 +1,8 @@
+#include <cstdlib>
 #include <iostream>
 #include "Matrix.hpp"
+#include "Rozklady.hpp"
+#include "Strojenie.hpp"
 
 /**
  * @file main.cpp
@@ -25,6 +28,15 @@
  * @return Zwraca 0, jeśli program zakończył się poprawnie.
  */
 int main() {
+    /**
+     * @section Tuning Strojenie parametrów dla bieżącego procesora
+     */
+    // Strojenie jest opcjonalne: MATRIX_PROFIL wskazuje plik profili, który zostanie
+    // wczytany albo (przy pierwszym uruchomieniu) utworzony po zmierzeniu parametrów
+    if (const char* profil = std::getenv("MATRIX_PROFIL")) {
+        przygotuj_profil(profil);
+    }
+
     /**
      * @section Initialization Inicjalizacja macierzy
      */
@@ -174,5 +186,21 @@ int main() {
     std::cout << "Macierz m1 po postdekrementacji:" << std::endl;
     std::cout << m1 << std::endl;
 
+    /**
+     * @section Decompositions Rozkłady macierzy
+     */
+    // Rozwiązanie układu równań przez rozkład LU
+    int ta[] = {4, 2, 0, 2, 5, 1, 0, 1, 3};
+    Matrix a(3, ta);
+    LU lu(a);
+    std::vector<double> x = lu.rozwiaz({6, 8, 4});
+    std::cout << "Rozwiązanie układu Ax = b (LU): " << x[0] << " " << x[1] << " " << x[2] << std::endl;
+
+    // Ten sam układ przez rozkład Cholesky'ego
+    Cholesky ch(a);
+    x = ch.rozwiaz({6, 8, 4});
+    std::cout << "Rozwiązanie układu Ax = b (Cholesky): " << x[0] << " " << x[1] << " " << x[2] << std::endl;
+    std::cout << "Wyznacznik macierzy A: " << lu.wyznacznik() << std::endl;
+
     return 0;
 }